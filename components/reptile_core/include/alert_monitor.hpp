@@ -0,0 +1,179 @@
+/**
+ * @file alert_monitor.hpp
+ * @brief Edge-triggered alert rules over every entity, drained from any task
+ */
+
+#ifndef ALERT_MONITOR_HPP
+#define ALERT_MONITOR_HPP
+
+#include "game_state.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ReptileSim {
+
+/**
+ * @brief Alert rules; the first three watch terrariums, the rest reptiles
+ */
+enum class AlertKind : uint8_t {
+    TempHigh,           // temp_hot_zone above temp_high (critical)
+    TempLow,            // temp_hot_zone below temp_low (warning)
+    WasteHigh,          // waste_level above waste_high (warning)
+    Sick,               // REPTILE_FLAG_HEALTHY cleared (critical)
+    StressHigh,         // stress_level above stress_high (warning)
+    Hungry,             // REPTILE_FLAG_HUNGRY set (info)
+    Count,
+};
+
+enum class AlertSeverity : uint8_t {
+    Info,
+    Warning,
+    Critical,
+};
+
+AlertSeverity alertSeverity(AlertKind kind);
+
+/**
+ * @brief One edge of one rule on one entity
+ */
+struct AlertEvent {
+    uint64_t game_clock_ms;     // Tick that crossed the edge
+    uint32_t entity_id;         // Terrarium id (TempHigh..WasteHigh) or reptile id
+    float value;                // Reading at the edge (1 = flag rule raised, 0 = cleared)
+    AlertKind kind;
+    AlertSeverity severity;
+    bool raised;                // false = back inside the clear band
+};
+
+/**
+ * @brief Thresholds; an alert clears only once the reading is back past
+ * the threshold by the band, so a reading hovering on it raises once
+ */
+struct AlertRules {
+    float temp_high;            // 38 °C
+    float temp_low;             // 20 °C
+    float temp_band;            // 1 °C
+    float waste_high;           // 80 %
+    float stress_high;          // 80 %
+    float percent_band;         // 10 % (waste and stress)
+};
+
+// Events the queue holds; the producer never waits, so past this edges are deferred
+constexpr uint32_t ALERT_QUEUE_CAPACITY = 256;
+
+/**
+ * @brief Fixed ring of AlertEvents, one producer task and one consumer task
+ *
+ * The producer owns the head and the consumer the tail; each publishes its
+ * index with a release store after touching the slot, and reads the other
+ * one with an acquire load, so neither locks nor waits. A push onto a full
+ * ring fails and is counted in rejected().
+ */
+class AlertQueue {
+public:
+    bool push(const AlertEvent& event);
+    bool pop(AlertEvent& out);
+
+    uint32_t rejected() const { return m_rejected.load(std::memory_order_relaxed); }
+
+    // Producer side: a push would fail
+    bool full() const
+    {
+        return m_head.load(std::memory_order_relaxed) - m_tail.load(std::memory_order_acquire) >= ALERT_QUEUE_CAPACITY;
+    }
+
+private:
+    static_assert((ALERT_QUEUE_CAPACITY & (ALERT_QUEUE_CAPACITY - 1)) == 0, "capacity must be a power of two");
+
+    AlertEvent m_events[ALERT_QUEUE_CAPACITY] = {};
+
+    // Free-running counters, each on its own cache line
+    alignas(64) std::atomic<uint32_t> m_head{0};   // Next slot written
+    alignas(64) std::atomic<uint32_t> m_tail{0};   // Next slot read
+    std::atomic<uint32_t> m_rejected{0};
+};
+
+/**
+ * @brief Latched alert state of every terrarium and reptile
+ *
+ * Each entity keeps one bit per rule, stored by id slot (SlotMap::slotOf)
+ * with the id it belongs to, so a reused slot starts clear. evaluate*()
+ * recomputes the bits of one entity from its current readings and queues
+ * an event for every bit that flipped; a steady state costs the compares
+ * and queues nothing. The caller decides which entities can have changed
+ * (see ReptileEngine::step), reports reptiles changed outside a tick with
+ * touch(), and evaluates everything when takeRescan() says so. A removed
+ * entity's alerts end without a clear event.
+ *
+ * An edge the full queue refuses is not latched: the entity is evaluated
+ * again next tick and the edge is queued then, if it still stands, so a
+ * slow consumer delays alerts but never loses one.
+ */
+class AlertMonitor {
+public:
+    static AlertRules defaultRules();
+
+    /**
+     * @brief New thresholds, applied to every entity at the next evaluation
+     */
+    void setRules(const AlertRules& rules);
+    const AlertRules& rules() const { return m_rules; }
+
+    /**
+     * @brief Forget every latched alert (new state); ones still true are raised again
+     */
+    void reset();
+
+    /**
+     * @brief True once after reset() or setRules(): evaluate every entity
+     */
+    bool takeRescan();
+
+    /**
+     * @brief A reptile changed outside a tick (e.g. fed); evaluated with the next tick
+     */
+    void touch(uint32_t reptile_id) { m_touched.push_back(reptile_id); }
+
+    // Ticking task
+    void evaluateTerrariums(const TerrariumStore& terrariums, uint64_t now_ms);
+    void evaluateReptile(const ReptileStore& reptiles, size_t i, uint64_t now_ms);
+    void evaluateReptiles(const ReptileStore& reptiles, uint64_t now_ms);
+    void evaluateTouched(const ReptileStore& reptiles, uint64_t now_ms);
+
+    /**
+     * @brief Oldest undelivered event (one consumer task at a time)
+     */
+    bool poll(AlertEvent& out) { return m_queue.pop(out); }
+
+    /**
+     * @brief Pushes the full queue refused so far (those edges are queued at a later tick)
+     */
+    uint32_t deferred() const { return m_queue.rejected(); }
+
+private:
+    // By id slot: the id the bits belong to, 1 << AlertKind plus a retry mark
+    struct Latch {
+        uint32_t owner;
+        uint8_t bits;
+    };
+    using Latches = std::vector<Latch>;
+
+    AlertRules m_rules = defaultRules();
+    Latches m_terrariums;
+    Latches m_reptiles;
+    std::vector<uint32_t> m_touched;    // Reptile ids to evaluate with the next tick
+    std::vector<uint32_t> m_deferred;   // Reptile ids with an edge the queue refused
+    bool m_rescan = true;
+    AlertQueue m_queue;
+
+    static uint8_t& latchOf(Latches& latches, uint32_t id);
+    uint8_t emit(uint8_t before, uint8_t after, uint32_t id, const float* values, uint64_t now_ms);
+    void unmark(uint32_t reptile_id);
+    void endPass();
+};
+
+} // namespace ReptileSim
+
+#endif // ALERT_MONITOR_HPP
@@ -0,0 +1,252 @@
+/**
+ * @file change_journal.hpp
+ * @brief Append-only log of everything applied since the last snapshot
+ *
+ * The engine is deterministic: a snapshot plus the exact sequence of ticks
+ * and player actions that followed it reproduces the live state bit for
+ * bit. Autosave therefore appends those inputs to a journal and only writes
+ * a full snapshot when compacting, so an autosave costs a few bytes per
+ * action instead of every column of the herd.
+ *
+ * File layout, all little-endian:
+ *
+ *   JournalHeader                  magic, generation, base clock, CRC
+ *   JournalRecordHeader + payload  repeated; each record has its own CRC
+ *
+ * The generation ties a journal to the snapshot it extends (the snapshot
+ * stores it in its engine section); a journal of another generation, or
+ * whose base clock differs from the snapshot's, is ignored. Records are
+ * buffered in RAM and appended with one write and fsync per flush(). A
+ * record torn by a power cut fails its CRC and replay stops in front of it,
+ * which recovers the state as of the last complete record.
+ */
+
+#ifndef CHANGE_JOURNAL_HPP
+#define CHANGE_JOURNAL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ReptileSim {
+
+constexpr char JOURNAL_MAGIC[8] = {'R', 'S', 'I', 'M', 'J', 'R', 'N', 'L'};
+constexpr uint16_t JOURNAL_VERSION = 1;
+
+// Record types (on-disk values, never renumber)
+enum class JournalOp : uint16_t {
+    Ticks           = 1,    // JournalTicks (consecutive equal dt coalesced)
+    FastForward     = 2,    // JournalFastForward
+    AddReptile      = 3,    // JournalAddReptile, then name and species chars
+    AddTerrarium    = 4,    // JournalAddTerrarium
+    RemoveReptile   = 5,    // JournalId
+    RemoveTerrarium = 6,    // JournalId
+    Assign          = 7,    // JournalAssign
+    Feed            = 8,    // JournalId (reptile)
+    Clean           = 9,    // JournalId (terrarium)
+    Equipment       = 10,   // JournalEquipment
+    EnginePeriod    = 11,   // JournalEnginePeriod
+};
+
+struct JournalHeader {
+    char magic[8];              // JOURNAL_MAGIC
+    uint16_t version;           // JOURNAL_VERSION
+    uint16_t reserved;
+    uint32_t header_crc;        // CRC-32 of the bytes below
+    uint64_t generation;        // Snapshot this journal extends
+    uint64_t base_clock_ms;     // Game clock of that snapshot
+};
+static_assert(sizeof(JournalHeader) == 32, "on-disk layout");
+
+struct JournalRecordHeader {
+    uint16_t op;                // JournalOp
+    uint16_t reserved;
+    uint32_t length;            // Payload bytes
+    uint32_t crc;               // CRC-32 of op, reserved, length and payload
+};
+static_assert(sizeof(JournalRecordHeader) == 12, "on-disk layout");
+
+// Record payloads. Entity adds carry the id the live engine issued: the
+// slot map's free list is not part of the snapshot, so a replayed add
+// restores the id instead of allocating one.
+struct JournalTicks {
+    uint32_t steps;
+    float dt;
+};
+
+struct JournalFastForward {
+    double game_seconds;
+};
+
+struct JournalAddReptile {
+    uint32_t id;
+    uint32_t name_length;
+    uint32_t species_length;
+};
+
+struct JournalAddTerrarium {
+    uint32_t id;
+    float width;
+    float height;
+    float depth;
+};
+
+struct JournalId {
+    uint32_t id;
+};
+
+struct JournalAssign {
+    uint32_t reptile_id;
+    uint32_t terrarium_id;
+};
+
+struct JournalEquipment {
+    uint32_t terrarium_id;
+    uint8_t flag;               // EquipmentFlags bit
+    uint8_t on;
+    uint16_t reserved;
+};
+
+struct JournalEnginePeriod {
+    uint8_t engine;             // SimEngine
+    uint8_t reserved[3];
+    uint32_t period;
+    uint32_t phase;
+};
+
+/**
+ * @brief Buffered writer of one journal file
+ *
+ * Recording only touches the RAM buffer, under a mutex that flush() holds
+ * just long enough to take the buffer, so the ticking task never waits on
+ * the file system. File writes are serialized among themselves.
+ *
+ * Compaction cuts the record stream where its snapshot was taken. Records
+ * before the cut keep going to the current file until the snapshot is
+ * durable, so a failed or interrupted snapshot loses nothing; commitCut()
+ * then starts the new file with the records after the cut.
+ */
+class ChangeJournal {
+public:
+    struct Stats {
+        uint64_t generation;
+        uint64_t file_bytes;        // Header and flushed records
+        uint64_t ticks;             // Ticks recorded since the snapshot
+        uint32_t records;           // Records since the snapshot
+        uint32_t pending_bytes;     // Recorded, not yet flushed
+        uint32_t flushes;
+    };
+
+    /**
+     * @brief Mark the snapshot point of a new journal
+     *
+     * Call where the snapshot of `generation` is taken; opens the journal
+     * if it was closed. Nothing is written until commitCut().
+     */
+    void cut(const char* path, uint64_t generation, uint64_t base_clock_ms);
+
+    /**
+     * @brief The snapshot is durable: start its journal file (truncates)
+     *
+     * Records before the cut are dropped (the snapshot holds them), those
+     * after it are appended by the next flush(). Closes the journal if the
+     * file cannot be written.
+     */
+    bool commitCut();
+
+    /**
+     * @brief The snapshot failed: keep appending to the current file
+     *
+     * Closes the journal if there is no current file to append to.
+     */
+    void cancelCut();
+
+    /**
+     * @brief Keep appending to a journal that replayed to its end
+     */
+    void resume(const char* path, uint64_t generation, uint64_t file_bytes, uint32_t records, uint64_t ticks);
+
+    void close();
+    bool isOpen() const;
+
+    /**
+     * @brief Buffer ticks; extends the last record if it has the same dt
+     */
+    void ticks(uint32_t steps, float dt);
+
+    /**
+     * @brief Buffer one record; `extra` bytes follow the fixed payload
+     */
+    void record(JournalOp op, const void* payload, size_t length, const void* extra = nullptr, size_t extra_length = 0);
+
+    /**
+     * @brief Append the buffered records and fsync
+     *
+     * While a cut is pending only the records before it are written. On a
+     * write error the journal closes: the file may end in a partial
+     * record, so nothing more may be appended after it. The caller
+     * recovers by compacting.
+     */
+    bool flush();
+
+    Stats stats() const;
+
+private:
+    std::mutex m_file_mutex;                // Held across file writes (flush, commitCut)
+    mutable std::mutex m_mutex;             // Everything below
+    std::string m_path;                     // Empty = closed
+    bool m_file_valid = false;              // m_path holds this generation's header
+    std::vector<uint8_t> m_pending;
+    std::vector<uint8_t> m_writing;         // Buffer being flushed (kept for its capacity)
+    size_t m_last_ticks = SIZE_MAX;         // Offset of the last Ticks record in m_pending
+    Stats m_stats = {};
+
+    // Pending cut: offset into m_pending, new generation, and the counts at
+    // the cut (the new journal's stats start from there)
+    size_t m_cut = SIZE_MAX;
+    uint64_t m_cut_generation = 0;
+    uint64_t m_cut_clock_ms = 0;
+    uint32_t m_cut_records = 0;
+    uint64_t m_cut_ticks = 0;
+
+    void closeLocked();
+    void dropFront(size_t bytes);
+    static void seal(uint8_t* record);
+};
+
+/**
+ * @brief Reads a journal file record by record
+ */
+class JournalReader {
+public:
+    /**
+     * @brief Read the whole file and check its header
+     */
+    bool open(const char* path);
+
+    const JournalHeader& header() const { return m_header; }
+
+    /**
+     * @brief Next intact record; false at the end or at the first torn or
+     * corrupt record
+     */
+    bool next(JournalOp& op, const uint8_t*& payload, uint32_t& length);
+
+    /**
+     * @brief Whether every byte of the file was a valid record
+     */
+    bool atCleanEnd() const { return m_pos == m_data.size(); }
+
+    uint64_t validBytes() const { return m_pos; }
+
+private:
+    std::vector<uint8_t> m_data;
+    JournalHeader m_header = {};
+    size_t m_pos = 0;
+};
+
+} // namespace ReptileSim
+
+#endif // CHANGE_JOURNAL_HPP
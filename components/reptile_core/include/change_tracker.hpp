@@ -0,0 +1,217 @@
+/**
+ * @file change_tracker.hpp
+ * @brief Change data capture: per-entity, per-field-group versions and "changed since" queries
+ */
+
+#ifndef CHANGE_TRACKER_HPP
+#define CHANGE_TRACKER_HPP
+
+#include "game_state.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ReptileSim {
+
+/**
+ * @brief Terrarium field groups, versioned separately
+ */
+enum TerrariumFields : uint8_t {
+    TERRARIUM_FIELDS_CLIMATE   = 1u << 0,   // temp_hot_zone, temp_cold_zone, humidity, uv_index
+    TERRARIUM_FIELDS_HYGIENE   = 1u << 1,   // waste_level, bacteria_count
+    TERRARIUM_FIELDS_EQUIPMENT = 1u << 2,   // EquipmentFlag bits
+    TERRARIUM_FIELDS_ALL       = 0x07,
+};
+
+/**
+ * @brief Reptile field groups, versioned separately
+ */
+enum ReptileFields : uint8_t {
+    REPTILE_FIELDS_BODY      = 1u << 0,     // weight_grams, bone_density, hydration
+    REPTILE_FIELDS_CONDITION = 1u << 1,     // stress_level, stomach_content, immune_system
+    REPTILE_FIELDS_STATUS    = 1u << 2,     // Healthy / hungry / shedding flags
+    REPTILE_FIELDS_PLACEMENT = 1u << 3,     // assigned_terrarium_id
+    REPTILE_FIELDS_ALL       = 0x0F,
+};
+
+/**
+ * @brief Resolution changes are counted at
+ *
+ * A value changes when it rounds (to nearest, ties to even, as printf does)
+ * to another multiple of its epsilon. With the epsilon a consumer prints
+ * with (0.1 for "%.1f"), the printed text only changes with a new version.
+ * 0 counts every move.
+ */
+struct ChangeEpsilons {
+    float temperature;          // °C (0.1, the "%.1f" of the UI)
+    float level;                // Percent-like columns, UV, bone density (0.1)
+    float weight;               // Grams (0.1)
+};
+
+/**
+ * @brief Answer of ChangeTracker::changedSince()
+ */
+struct ChangeSet {
+    uint64_t version;                           // Pass as `since` next time
+    bool complete;                              // false: history before `since` is gone, re-read everything
+    std::vector<uint32_t> terrariums;           // Added or changed, live now
+    std::vector<uint32_t> reptiles;
+    std::vector<uint32_t> removed_terrariums;
+    std::vector<uint32_t> removed_reptiles;
+};
+
+/**
+ * @brief Versions of every entity and field group, and a log to query them by
+ *
+ * The tracker keeps a baseline of every tracked column by id slot. When a
+ * value of a group rounds to another multiple of its epsilon than its
+ * baseline does, the group takes the next version, its baseline becomes
+ * the current values and the entity is appended to the change log; drifts
+ * within a multiple accumulate until they cross into the next. The version
+ * only advances when something changed, so an unchanged herd keeps its
+ * version.
+ *
+ * The log is in version order, so changedSince() binary searches it and
+ * reads only what changed after `since`. An entity appears in the log once
+ * per version it changed at; entries no group still points at are
+ * compacted away as the log grows, so it stays within a few entries per
+ * entity. Removals are logged separately and the oldest are forgotten past
+ * CHANGE_REMOVED_LOG entries; a query reaching back further, or past a
+ * reset() (new state loaded), is answered as incomplete.
+ *
+ * Which entities are compared is the caller's choice, as for AlertMonitor:
+ * every terrarium, the reptiles the tick left awake, the ones touch()ed
+ * and everything when takeRescan() says so. All calls belong to the
+ * ticking task.
+ */
+class ChangeTracker {
+public:
+    // Removals remembered for changedSince()
+    static constexpr size_t CHANGE_REMOVED_LOG = 4096;
+
+    static ChangeEpsilons defaultEpsilons();
+
+    /**
+     * @brief New epsilons; every entity is compared again at the next pass
+     */
+    void setEpsilons(const ChangeEpsilons& epsilons);
+    const ChangeEpsilons& epsilons() const { return m_epsilons; }
+
+    /**
+     * @brief New state: every entity is new at the next pass, older versions are incomplete
+     */
+    void reset();
+
+    /**
+     * @brief True once after reset() or setEpsilons(): compare every entity
+     */
+    bool takeRescan();
+
+    // A reptile changed outside a tick (e.g. fed); compared at the next pass
+    void touch(uint32_t reptile_id) { m_touched.push_back(reptile_id); }
+
+    // An entity was removed (gets a version of its own right away)
+    void removedTerrarium(uint32_t id);
+    void removedReptile(uint32_t id);
+
+    // One pass: begin, compare the candidates, end
+    void beginPass();
+    void trackTerrariums(const TerrariumStore& terrariums);
+    void trackReptile(const ReptileStore& reptiles, size_t i);
+    void trackReptiles(const ReptileStore& reptiles);
+    void trackTouched(const ReptileStore& reptiles);
+    void endPass();
+
+    /**
+     * @brief Latest version (0 = nothing tracked yet)
+     */
+    uint64_t version() const { return m_version; }
+
+    /**
+     * @brief Version of the last change of one entity in `groups` (0 = untracked id)
+     */
+    uint64_t terrariumVersion(uint32_t id, uint8_t groups = TERRARIUM_FIELDS_ALL) const;
+    uint64_t reptileVersion(uint32_t id, uint8_t groups = REPTILE_FIELDS_ALL) const;
+
+    /**
+     * @brief Entities that changed in the given groups after version `since`
+     *
+     * Each id appears once. O(log + entries after `since`).
+     */
+    void changedSince(uint64_t since, ChangeSet& out, uint8_t terrarium_groups = TERRARIUM_FIELDS_ALL,
+                      uint8_t reptile_groups = REPTILE_FIELDS_ALL) const;
+
+    /**
+     * @brief Change log entries held (for sizing)
+     */
+    size_t logSize() const { return m_log.size() + m_removed.size(); }
+
+private:
+    static constexpr size_t TERRARIUM_GROUPS = 3;
+    static constexpr size_t REPTILE_GROUPS = 4;
+    static constexpr size_t LOG_COMPACT_MIN = 1024;
+
+    // By id slot: the id tracked and the baseline every pass compares with
+    struct TerrariumTrack {
+        uint32_t owner;
+        uint8_t equipment;
+        float climate[4];
+        float hygiene[2];
+    };
+
+    struct ReptileTrack {
+        uint32_t owner;
+        uint32_t terrarium_id;
+        uint8_t status;
+        float body[3];
+        float condition[3];
+    };
+
+    enum class Kind : uint8_t {
+        Terrarium,
+        Reptile,
+    };
+
+    struct LogEntry {
+        uint64_t version;
+        uint32_t id;
+        Kind kind;
+    };
+
+    // Multiples of the epsilons per unit (0 = every move counts)
+    struct Scales {
+        float temperature;
+        float level;
+        float weight;
+    };
+
+    ChangeEpsilons m_epsilons = defaultEpsilons();
+    Scales m_scales = scalesOf(defaultEpsilons());
+    std::vector<TerrariumTrack> m_terrariums;
+    std::vector<ReptileTrack> m_reptiles;
+    // Group versions by slot (slot * groups + group), kept apart from the
+    // baselines so a pass with few changes streams less memory
+    std::vector<uint64_t> m_terrarium_versions;
+    std::vector<uint64_t> m_reptile_versions;
+    std::vector<LogEntry> m_log;            // Changes, version order
+    std::vector<LogEntry> m_removed;        // Removals, version order
+    std::vector<uint32_t> m_touched;
+
+    uint64_t m_version = 0;                 // Latest version handed out
+    uint64_t m_floor = 0;                   // Queries from below this are incomplete
+    size_t m_log_limit = LOG_COMPACT_MIN;   // Compact when the log outgrows this
+    bool m_changed = false;                 // This pass handed out m_version + 1
+    bool m_rescan = true;
+
+    static Scales scalesOf(const ChangeEpsilons& epsilons);
+    void stamp(uint64_t* versions, size_t count, uint8_t groups, Kind kind, uint32_t id);
+    const uint64_t* versionsOf(Kind kind, uint32_t id) const;
+    uint64_t entryVersion(const LogEntry& entry, uint8_t groups) const;
+    bool live(const LogEntry& entry) const;
+    void logRemoval(Kind kind, uint32_t id);
+    void compact();
+};
+
+} // namespace ReptileSim
+
+#endif // CHANGE_TRACKER_HPP
@@ -0,0 +1,209 @@
+/**
+ * @file engine_profiler.hpp
+ * @brief Per-engine timing counters around the update calls of a tick
+ */
+
+#ifndef ENGINE_PROFILER_HPP
+#define ENGINE_PROFILER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#ifndef REPTILE_SIM_NO_PROFILE
+#ifdef ESP_PLATFORM
+#include "esp_cpu.h"
+#include "esp_rom_sys.h"
+#else
+#include <chrono>
+#endif
+#endif
+
+namespace ReptileSim {
+
+/**
+ * @brief Profiled sections: the 14 engines in SimEngine order, then the
+ * passes that run several engines at once, the whole tick, the cost a
+ * background save puts on the ticking task, history and telemetry
+ * recording, and alert evaluation
+ */
+enum class ProfileSlot : uint8_t {
+    Physics,
+    Biology,
+    Nutrition,
+    Sanitary,
+    Economy,
+    Behavior,
+    Genetics,
+    Reproduction,
+    Social,
+    Seasonal,
+    Security,
+    Technical,
+    Admin,
+    Weather,
+    FusedReptiles,      // Fused mode: the seven per-reptile engines
+    Parallel,           // Parallel mode: physics + fused reptiles + sanitary
+    Step,               // One whole tick
+    SaveCapture,        // Background save: state copy at a tick boundary
+    StepWhileSaving,    // Whole ticks run while a background save writes
+    History,            // Recording the history rings
+    Telemetry,          // Sampling (and writing chunks of) the telemetry archive
+    Alerts,             // Evaluating the alert rules
+    Changes,            // Change tracking (versions and change log)
+    Count,
+};
+
+// Histogram bucket k counts calls taking [2^k, 2^(k+1)) ns (0 ns lands in 0)
+constexpr size_t PROFILE_HISTOGRAM_BUCKETS = 32;
+
+/**
+ * @brief Timings of one section since init (or the last reset)
+ */
+struct ProfileStats {
+    uint64_t calls;
+    uint64_t total_ns;
+    uint32_t last_ns;
+    uint32_t min_ns;        // UINT32_MAX until the first call
+    uint32_t max_ns;
+    uint32_t histogram[PROFILE_HISTOGRAM_BUCKETS];
+
+    uint32_t meanNs() const
+    {
+        return calls ? static_cast<uint32_t>(total_ns / calls) : 0;
+    }
+};
+
+/**
+ * @brief Lap timer over the sections of a tick
+ *
+ * mark() starts the clock and each lap() charges the time since the previous
+ * mark or lap to one section, so a tick of n sections reads the clock n + 1
+ * times. The clock is the CPU cycle counter on device (ESP_PLATFORM) and
+ * steady_clock on the host; both are reported in nanoseconds, saturating at
+ * ~4.3 s per call.
+ *
+ * Counters belong to the ticking task: read them (stats()) and reset() them
+ * there, between ticks. They are plain stores with no synchronisation, so
+ * another task could read a torn 64-bit calls or total_ns on a 32-bit
+ * target (the ESP32-P4 is RV32), and a reset() from there races lap().
+ *
+ * Define REPTILE_SIM_NO_PROFILE to compile every mark/lap to nothing; the
+ * counters then stay at zero.
+ */
+class EngineProfiler {
+public:
+#ifdef ESP_PLATFORM
+    using Stamp = uint32_t;     // CPU cycles (wraps; laps are far shorter)
+#else
+    using Stamp = int64_t;      // steady_clock nanoseconds
+#endif
+
+    static constexpr bool ENABLED =
+#ifdef REPTILE_SIM_NO_PROFILE
+        false;
+#else
+        true;
+#endif
+
+    EngineProfiler() { reset(); }
+
+    /**
+     * @brief Start timing; returns the stamp for a later lapSince()
+     */
+    Stamp mark()
+    {
+#ifndef REPTILE_SIM_NO_PROFILE
+        m_mark = now();
+#endif
+        return m_mark;
+    }
+
+    /**
+     * @brief Charge the time since the last mark or lap to `slot`
+     */
+    void lap(ProfileSlot slot)
+    {
+#ifndef REPTILE_SIM_NO_PROFILE
+        const Stamp t = now();
+        record(slot, elapsedNs(m_mark, t));
+        m_mark = t;
+#else
+        (void)slot;
+#endif
+    }
+
+    /**
+     * @brief Charge the time since `start` to `slot` (spans several laps)
+     */
+    void lapSince(ProfileSlot slot, Stamp start)
+    {
+#ifndef REPTILE_SIM_NO_PROFILE
+        const Stamp t = now();
+        record(slot, elapsedNs(start, t));
+        m_mark = t;
+#else
+        (void)slot;
+        (void)start;
+#endif
+    }
+
+    const ProfileStats& stats(ProfileSlot slot) const
+    {
+        return m_stats[static_cast<size_t>(slot)];
+    }
+
+    void reset();
+
+private:
+    ProfileStats m_stats[static_cast<size_t>(ProfileSlot::Count)];
+    Stamp m_mark = 0;
+
+#ifndef REPTILE_SIM_NO_PROFILE
+    static Stamp now()
+    {
+#ifdef ESP_PLATFORM
+        return static_cast<Stamp>(esp_cpu_get_cycle_count());
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    static uint32_t elapsedNs(Stamp from, Stamp to)
+    {
+#ifdef ESP_PLATFORM
+        // 32-bit multiply below ~4.3M cycles (10 ms at 400 MHz), which is
+        // every engine call in practice
+        const uint32_t cycles = to - from;
+        const uint32_t mhz = esp_rom_get_cpu_ticks_per_us();
+        if (cycles < UINT32_MAX / 1000u) return cycles * 1000u / mhz;
+        const uint64_t ns = static_cast<uint64_t>(cycles) * 1000u / mhz;
+        return (ns > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(ns);
+#else
+        const int64_t ns = to - from;
+        if (ns <= 0) return 0;
+        return (ns > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(ns);
+#endif
+    }
+
+    void record(ProfileSlot slot, uint32_t ns)
+    {
+        ProfileStats& s = m_stats[static_cast<size_t>(slot)];
+        s.calls++;
+        s.total_ns += ns;
+        s.last_ns = ns;
+        if (ns < s.min_ns) s.min_ns = ns;
+        if (ns > s.max_ns) s.max_ns = ns;
+        s.histogram[ns ? 31 - __builtin_clz(ns) : 0]++;
+    }
+#endif
+};
+
+/**
+ * @brief Short lowercase name of a section ("physics", ..., "step")
+ */
+const char* profileSlotName(ProfileSlot slot);
+
+} // namespace ReptileSim
+
+#endif // ENGINE_PROFILER_HPP
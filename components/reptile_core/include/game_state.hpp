@@ -6,16 +6,26 @@
 #ifndef GAME_STATE_HPP
 #define GAME_STATE_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 #include <string>
 
+#include "occupancy_index.hpp"
+#include "slot_map.hpp"
+
 namespace ReptileSim {
 
 // ====================================================================================
 // CORE DATA STRUCTURES
 // ====================================================================================
 
+/**
+ * @brief Flat reptile record
+ *
+ * Used at the API boundary only (add, save/load). The engines work on the
+ * column layout in ReptileStore.
+ */
 struct Reptile {
     uint32_t id;
     std::string name;
@@ -37,6 +47,9 @@ struct Reptile {
     uint32_t assigned_terrarium_id;
 };
 
+/**
+ * @brief Flat terrarium record (API boundary only, see TerrariumStore)
+ */
 struct Terrarium {
     uint32_t id;
     float width, height, depth; // cm
@@ -57,6 +70,174 @@ struct Terrarium {
     bool mister_on;
 };
 
+// ====================================================================================
+// STRUCTURE-OF-ARRAYS ENTITY STORAGE
+// ====================================================================================
+
+// Reptile status bits (ReptileStore::flags)
+enum ReptileFlag : uint8_t {
+    REPTILE_FLAG_HEALTHY  = 1u << 0,
+    REPTILE_FLAG_HUNGRY   = 1u << 1,
+    REPTILE_FLAG_SHEDDING = 1u << 2,
+    REPTILE_FLAG_ASLEEP   = 1u << 3,    // Engine-internal: settled, skipped until woken
+};
+
+// Equipment bits (TerrariumStore::equipment)
+enum EquipmentFlag : uint8_t {
+    EQUIP_HEATER = 1u << 0,
+    EQUIP_LIGHT  = 1u << 1,
+    EQUIP_MISTER = 1u << 2,
+};
+
+/**
+ * @brief Reptile columns, one entry per animal at the same index
+ *
+ * Hot columns are the ones every per-reptile engine reads or writes each
+ * tick; they are kept contiguous so an engine pass only streams the floats
+ * it needs. Names, species and status flags live in the cold store.
+ */
+struct ReptileStore {
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // Hot physiological columns
+    std::vector<float> weight_grams;
+    std::vector<float> bone_density;
+    std::vector<float> hydration;
+    std::vector<float> stress_level;
+    std::vector<float> stomach_content;
+    std::vector<float> immune_system;
+    std::vector<uint32_t> assigned_terrarium_id;
+
+    // Terrarium index for assigned_terrarium_id, kept in sync by the engine
+    // (SlotMap::INVALID if unassigned or stale)
+    std::vector<uint32_t> terrarium_index;
+
+    // Cold store
+    std::vector<uint32_t> id;
+    std::vector<uint8_t> flags;         // ReptileFlag bits
+    std::vector<std::string> name;
+    std::vector<std::string> species;
+
+    // id -> index
+    SlotMap index;
+
+    size_t size() const { return id.size(); }
+    bool empty() const { return id.empty(); }
+
+    void reserve(size_t n);
+    void clear();
+
+    /**
+     * @brief Append a record, returns its index
+     *
+     * A record with id 0 gets a fresh id written back into it. Any other id
+     * is restored as-is (load path); npos is returned if it is already live.
+     */
+    size_t append(Reptile& r);
+
+    /**
+     * @brief Remove the entry at index i in O(1)
+     *
+     * The last entry is moved into i and its id remapped; the removed id is
+     * retired and never resolves again.
+     */
+    void swapRemove(size_t i);
+
+    /**
+     * @brief Gather the record at index i
+     */
+    Reptile get(size_t i) const;
+
+    /**
+     * @brief Index of the reptile with this id, or npos
+     */
+    size_t indexOf(uint32_t reptile_id) const
+    {
+        const uint32_t i = index.find(reptile_id);
+        return (i == SlotMap::INVALID) ? npos : i;
+    }
+
+    bool hasFlag(size_t i, uint8_t flag) const { return (flags[i] & flag) != 0; }
+    void setFlag(size_t i, uint8_t flag, bool on)
+    {
+        flags[i] = on ? static_cast<uint8_t>(flags[i] | flag)
+                      : static_cast<uint8_t>(flags[i] & ~flag);
+    }
+};
+
+/**
+ * @brief Terrarium columns, one entry per enclosure at the same index
+ *
+ * Environment, sanitary and equipment state are hot. The enclosure volume is
+ * derived from the dimensions once on insert because behavior and social
+ * read it for every occupant; the raw dimensions stay in the cold store.
+ */
+struct TerrariumStore {
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // Hot environmental columns
+    std::vector<float> temp_hot_zone;
+    std::vector<float> temp_cold_zone;
+    std::vector<float> humidity;
+    std::vector<float> uv_index;
+    std::vector<float> waste_level;
+    std::vector<float> bacteria_count;
+    std::vector<float> volume;          // width * height * depth, cm³
+    std::vector<uint8_t> equipment;     // EquipmentFlag bits
+
+    // Cold store
+    std::vector<uint32_t> id;
+    std::vector<float> width;
+    std::vector<float> height;
+    std::vector<float> depth;
+
+    // id -> index
+    SlotMap index;
+
+    size_t size() const { return id.size(); }
+    bool empty() const { return id.empty(); }
+
+    void reserve(size_t n);
+    void clear();
+
+    /**
+     * @brief Append a record, returns its index
+     *
+     * A record with id 0 gets a fresh id written back into it. Any other id
+     * is restored as-is (load path); npos is returned if it is already live.
+     */
+    size_t append(Terrarium& t);
+
+    /**
+     * @brief Remove the entry at index i in O(1)
+     *
+     * The last entry is moved into i and its id remapped; the removed id is
+     * retired and never resolves again.
+     */
+    void swapRemove(size_t i);
+
+    /**
+     * @brief Gather the record at index i
+     */
+    Terrarium get(size_t i) const;
+
+    /**
+     * @brief Index of the terrarium with this id, or npos
+     */
+    size_t indexOf(uint32_t terrarium_id) const
+    {
+        const uint32_t i = index.find(terrarium_id);
+        return (i == SlotMap::INVALID) ? npos : i;
+    }
+
+    bool hasEquipment(size_t i, uint8_t flag) const { return (equipment[i] & flag) != 0; }
+    void setEquipment(size_t i, uint8_t flag, bool on)
+    {
+        equipment[i] = on ? static_cast<uint8_t>(equipment[i] | flag)
+                          : static_cast<uint8_t>(equipment[i] & ~flag);
+    }
+};
+
 struct Economy {
     float total_expenses;
     float electricity_cost;
@@ -68,14 +249,26 @@ struct Economy {
 // GLOBAL GAME STATE
 // ====================================================================================
 
+// Integer game clock units (1 real second of tick() = 1 game minute)
+constexpr uint64_t GAME_MS_PER_SECOND = 60000;
+constexpr uint64_t GAME_MS_PER_HOUR = 3600000;
+constexpr uint64_t GAME_MS_PER_DAY = 86400000;
+
 struct GameState {
     // Time
-    uint32_t game_day;
-    float game_time_hours;      // 0-24
+    uint64_t game_clock_ms;     // Game milliseconds since day 1, 00:00 (authoritative)
+    uint32_t game_day;          // Derived from game_clock_ms (1-based)
+    float game_time_hours;      // Derived from game_clock_ms (0-24)
+
+    /**
+     * @brief Set the clock and refresh game_day / game_time_hours
+     */
+    void setGameClock(uint64_t clock_ms);
 
     // Entities
-    std::vector<Reptile> reptiles;
-    std::vector<Terrarium> terrariums;
+    ReptileStore reptiles;
+    TerrariumStore terrariums;
+    OccupancyIndex occupancy;   // Reptiles grouped by terrarium index
 
     // Economy
     Economy economy;
@@ -0,0 +1,164 @@
+/**
+ * @file herd_csv.hpp
+ * @brief Bulk herd rows and the streaming CSV reader/writer for studbooks
+ *
+ * Import and export use RFC 4180 CSV with a header row: fields separated by
+ * commas, records by LF or CRLF, fields containing a comma, quote or line
+ * break enclosed in double quotes with inner quotes doubled. Columns are
+ * found by header name, so files from other tools may order them freely
+ * and carry extra columns.
+ */
+
+#ifndef HERD_CSV_HPP
+#define HERD_CSV_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+namespace ReptileSim {
+
+/**
+ * @brief One reptile of a bulk add; the strings are copied during the call
+ */
+struct ReptileRow {
+    std::string_view name;
+    std::string_view species;
+    uint32_t terrarium_id;      // 0 = unassigned
+    float weight_grams;         // <= 0: the addReptile() default
+};
+
+/**
+ * @brief One terrarium of a bulk add (cm)
+ */
+struct TerrariumRow {
+    float width;
+    float height;
+    float depth;
+};
+
+/**
+ * @brief A CSV row that was skipped
+ */
+struct CsvRowError {
+    const char* file;           // "terrariums" or "reptiles"
+    uint32_t line;              // 1-based line of the row
+    const char* message;        // Static string
+};
+
+constexpr size_t CSV_MAX_REPORTED_ERRORS = 100;
+
+/**
+ * @brief Outcome of a CSV import
+ */
+struct CsvImportReport {
+    uint32_t terrariums;                // Rows imported
+    uint32_t reptiles;
+    uint32_t rejected;                  // Rows skipped, all files
+    std::vector<CsvRowError> errors;    // The first CSV_MAX_REPORTED_ERRORS
+};
+
+/**
+ * @brief Reads a CSV file one record at a time, a large chunk per fread
+ *
+ * A record is located with a word-at-a-time scan for line breaks and
+ * quotes (SSE2 on x86-64), then split at its commas. Quoted fields are
+ * unescaped in place in the chunk buffer, so fields are views into it and
+ * nothing is allocated per record.
+ */
+class CsvReader {
+public:
+    CsvReader() = default;
+    CsvReader(const CsvReader&) = delete;
+    CsvReader& operator=(const CsvReader&) = delete;
+    ~CsvReader();
+
+    bool open(const char* path);
+
+    /**
+     * @brief Next non-blank record; fields stay valid until the next call
+     * @return false at the end of the file or on failed()
+     */
+    bool next(std::vector<std::string_view>& fields);
+
+    /**
+     * @brief First line of the record last returned (1-based)
+     */
+    uint32_t line() const { return m_record_line; }
+
+    uint64_t fileBytes() const { return m_file_bytes; }
+    uint64_t bytesConsumed() const { return m_consumed; }
+
+    /**
+     * @brief Read error, or a record longer than the largest buffer
+     */
+    bool failed() const { return m_failed; }
+
+private:
+    FILE* m_file = nullptr;
+    std::vector<char> m_buf;
+    size_t m_pos = 0;                   // Start of the unread bytes
+    size_t m_end = 0;                   // End of the valid bytes
+    bool m_eof = false;
+    bool m_failed = false;
+    uint32_t m_line = 1;                // Line of m_pos
+    uint32_t m_record_line = 0;
+    uint64_t m_file_bytes = 0;
+    uint64_t m_consumed = 0;
+
+    bool refill();
+};
+
+/**
+ * @brief Buffered CSV writer
+ */
+class CsvWriter {
+public:
+    CsvWriter() = default;
+    CsvWriter(const CsvWriter&) = delete;
+    CsvWriter& operator=(const CsvWriter&) = delete;
+    ~CsvWriter();
+
+    bool open(const char* path);
+
+    void field(std::string_view text);  // Quoted when it needs to be
+    void field(uint32_t value);
+    void field(float value);            // Shortest form that reads back exactly
+    void endRow();
+
+    /**
+     * @brief Flush and close; false if any write failed
+     */
+    bool close();
+
+private:
+    FILE* m_file = nullptr;
+    std::vector<char> m_buf;
+    bool m_row_started = false;
+    bool m_failed = false;
+
+    void separator();
+    void flushIfFull();
+};
+
+/**
+ * @brief A field without leading and trailing spaces
+ */
+std::string_view trimSpaces(std::string_view s);
+
+/**
+ * @brief Index of a header column, or -1
+ */
+int csvColumn(const std::vector<std::string_view>& header, std::string_view name);
+
+/**
+ * @brief Parse a whole field as a number (surrounding spaces allowed)
+ */
+bool parseCsvNumber(std::string_view text, uint32_t& out);
+bool parseCsvNumber(std::string_view text, float& out);
+
+} // namespace ReptileSim
+
+#endif // HERD_CSV_HPP
@@ -0,0 +1,193 @@
+/**
+ * @file history.hpp
+ * @brief Multi-resolution environment history rings (raw, minute, hour)
+ */
+
+#ifndef HISTORY_HPP
+#define HISTORY_HPP
+
+#include "game_state.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ReptileSim {
+
+/**
+ * @brief Recorded series of each terrarium and each reptile
+ */
+enum class HistoryChannel : uint8_t {
+    TerrariumTemp,          // temp_hot_zone
+    TerrariumHumidity,
+    TerrariumWaste,
+    TerrariumBacteria,
+    ReptileStress,
+    ReptileWeight,
+    Count,
+};
+
+constexpr size_t HISTORY_TERRARIUM_CHANNELS = 4;
+constexpr size_t HISTORY_REPTILE_CHANNELS = 2;
+
+/**
+ * @brief Resolution of a history ring, in seconds of tick() time
+ */
+enum class HistoryTier : uint8_t {
+    Raw,        // One sample per second
+    Minute,     // Min/max/avg per minute
+    Hour,       // Min/max/avg per hour
+    Count,
+};
+
+// Game clock span of a raw sample and of the buckets (1 s of tick() time
+// is one game minute, so a "minute" bucket is one game hour)
+constexpr uint64_t HISTORY_RAW_MS = GAME_MS_PER_SECOND;
+constexpr uint64_t HISTORY_MINUTE_MS = 60 * GAME_MS_PER_SECOND;
+constexpr uint64_t HISTORY_HOUR_MS = 3600 * GAME_MS_PER_SECOND;
+
+/**
+ * @brief Sizes of the rings; fixed for as long as history is enabled
+ */
+struct HistoryConfig {
+    uint32_t terrarium_slots;   // Ids whose slot is >= this are not recorded (64)
+    uint32_t reptile_slots;     // (256)
+    uint32_t raw_samples;       // Per series: 300 = the last 5 minutes
+    uint32_t minute_buckets;    // 240 = the last 4 hours
+    uint32_t hour_buckets;      // 168 = the last week
+    bool external_ram;          // Allocate in PSRAM on device (internal RAM if that fails)
+};
+
+/**
+ * @brief One point of a history query (raw samples: min = max = avg)
+ */
+struct HistoryPoint {
+    uint64_t time_ms;           // Game clock at the sample or bucket start
+    float min;
+    float max;
+    float avg;
+};
+
+/**
+ * @brief Fixed-size per-entity history of the environment and of the herd
+ *
+ * Every recorded second appends one sample per series to the raw
+ * ring and folds it into the open minute; a closed minute is written to
+ * the minute ring and folded into the open hour, a closed hour to the hour
+ * ring. Each ring keeps its newest rows and overwrites the oldest.
+ *
+ * Series are stored by id slot (SlotMap::slotOf), one row per sample
+ * across all slots, so recording a tick writes each row front to back
+ * and a query reads one slot with a stride. The time of each row is kept
+ * once per ring. A slot remembers the id it records and the span it was
+ * recorded for, so a reused slot never shows the previous entity's data
+ * and a removed entity keeps its history until the slot is reused.
+ *
+ * All rings, accumulators and per-slot bookkeeping share one allocation
+ * sized by the config (see bytesFor()); nothing is allocated while
+ * recording. Ticks shorter than a second record once per second;
+ * fastForward() is not recorded and leaves a gap.
+ */
+class HistoryRecorder {
+public:
+    HistoryRecorder() = default;
+    HistoryRecorder(const HistoryRecorder&) = delete;
+    HistoryRecorder& operator=(const HistoryRecorder&) = delete;
+    ~HistoryRecorder() { disable(); }
+
+    static HistoryConfig defaultConfig();
+
+    /**
+     * @brief Bytes enable() allocates for `config`
+     */
+    static size_t bytesFor(const HistoryConfig& config);
+
+    /**
+     * @brief Allocate empty rings (replaces any previous history)
+     * @return false if a size is 0 or the allocation failed
+     */
+    bool enable(const HistoryConfig& config);
+    void disable();
+    bool enabled() const { return m_block != nullptr; }
+    size_t bytes() const { return m_bytes; }
+
+    /**
+     * @brief Forget every sample, keep the allocation
+     */
+    void clear();
+
+    /**
+     * @brief Record the state after a tick (no-op within an already recorded second)
+     */
+    void record(const GameState& state);
+
+    /**
+     * @brief Points of one series with time in [from_ms, to_ms], oldest first
+     *
+     * Answered from the finest ring still holding from_ms (else the one
+     * reaching furthest back); minute and hour answers end with the open
+     * bucket so far. O(log ring + points returned).
+     * @param tier Ring used, if not null
+     * @return Points written (at most max_points; 0 for an unrecorded id)
+     */
+    size_t query(HistoryChannel channel, uint32_t id, uint64_t from_ms, uint64_t to_ms, HistoryPoint* out,
+                 size_t max_points, HistoryTier* tier = nullptr) const;
+
+private:
+    struct Bucket {
+        float min;
+        float max;
+        float avg;
+    };
+
+    struct Accumulator {
+        float min;
+        float max;
+        float sum;
+        uint32_t count;
+    };
+
+    // Times of the rows of one ring, shared by every series
+    struct Ring {
+        uint64_t* time_ms;
+        uint32_t capacity;
+        uint32_t head;          // Next row written
+        uint32_t count;         // Rows held
+    };
+
+    // The series of one entity kind
+    struct Group {
+        uint32_t channels;
+        uint32_t slots;
+        float* raw;                 // [channel][raw row][slot]
+        Bucket* minutes;            // [channel][minute row][slot]
+        Bucket* hours;              // [channel][hour row][slot]
+        Accumulator* minute_acc;    // [channel][slot], the open minute
+        Accumulator* hour_acc;      // [channel][slot], the open hour
+        uint32_t* owner;            // [slot] id recorded, 0 = none
+        uint64_t* first_ms;         // [slot] first and last sample of that id
+        uint64_t* last_ms;
+    };
+
+    HistoryConfig m_config = {};
+    void* m_block = nullptr;
+    size_t m_bytes = 0;
+
+    Ring m_rings[static_cast<size_t>(HistoryTier::Count)] = {};
+    Group m_terrariums = {};
+    Group m_reptiles = {};
+
+    uint64_t m_second = 0;              // Of the last raw row (game clock / length)
+    uint64_t m_minute = 0;              // Open minute and hour
+    uint64_t m_hour = 0;
+    bool m_started = false;             // A raw row was written since clear()
+
+    uint64_t layout(uint8_t* base);
+    void recordGroup(Group& group, const std::vector<uint32_t>& ids, const float* const* columns,
+                     uint32_t row, uint64_t now_ms);
+    void closeBuckets(Group& group, HistoryTier tier, uint32_t row);
+    static uint32_t push(Ring& ring, uint64_t time_ms);
+};
+
+} // namespace ReptileSim
+
+#endif // HISTORY_HPP
@@ -0,0 +1,101 @@
+/**
+ * @file occupancy_index.hpp
+ * @brief Reptiles grouped by terrarium (compressed sparse rows)
+ */
+
+#ifndef OCCUPANCY_INDEX_HPP
+#define OCCUPANCY_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ReptileSim {
+
+/**
+ * @brief Reptile indices bucketed by terrarium index
+ *
+ * Members of a bucket are contiguous in one shared array, so walking a
+ * terrarium's occupants is a linear scan of just those entries. Each bucket
+ * reserves some slack: add, remove and reassignment are O(1) amortized (a
+ * full bucket is moved to the end of the array with double capacity, and the
+ * array is compacted once holes outnumber members). Reptiles without a
+ * resolvable terrarium live in a separate "unassigned" bucket so every
+ * reptile belongs to exactly one bucket.
+ *
+ * Reptile and terrarium indices are the dense ReptileStore/TerrariumStore
+ * indices; callers mirror every store swap-remove here.
+ */
+class OccupancyIndex {
+public:
+    static constexpr uint32_t UNASSIGNED = 0xFFFFFFFFu;
+
+    void clear();
+
+    /**
+     * @brief Rebuild from scratch (load path)
+     * @param terrarium_of Terrarium index of each reptile (UNASSIGNED if none)
+     */
+    void rebuild(const std::vector<uint32_t>& terrarium_of, size_t terrarium_count);
+
+    // Reptile changes (reptile = dense reptile index)
+    void addReptile(uint32_t reptile, uint32_t terrarium);
+    void moveReptile(uint32_t reptile, uint32_t from, uint32_t to);
+
+    /**
+     * @brief Mirror ReptileStore::swapRemove(reptile)
+     * @param terrarium Bucket the removed reptile is in
+     */
+    void removeReptile(uint32_t reptile, uint32_t terrarium);
+
+    // Terrarium changes
+    void addTerrarium();
+
+    /**
+     * @brief Mirror TerrariumStore::swapRemove(terrarium)
+     *
+     * Occupants of the removed terrarium move to the unassigned bucket.
+     * terrarium_of is patched for them and for the occupants of the last
+     * terrarium, which takes over the removed index.
+     */
+    void removeTerrarium(uint32_t terrarium, std::vector<uint32_t>& terrarium_of);
+
+    // Queries
+    uint32_t count(uint32_t terrarium) const { return bucket(terrarium).count; }
+    const uint32_t* members(uint32_t terrarium) const { return m_members.data() + bucket(terrarium).offset; }
+    size_t terrariumCount() const { return m_buckets.size(); }
+
+private:
+    struct Bucket {
+        uint32_t offset;
+        uint32_t count;
+        uint32_t capacity;
+    };
+
+    static constexpr uint32_t MIN_CAPACITY = 4;
+
+    std::vector<Bucket> m_buckets;      // One per terrarium index
+    Bucket m_unassigned = {0, 0, 0};
+    std::vector<uint32_t> m_members;    // Reptile indices, bucket by bucket
+    std::vector<uint32_t> m_position;   // Reptile index -> slot in m_members
+    size_t m_reserved = 0;              // Sum of bucket capacities
+
+    Bucket& bucket(uint32_t terrarium)
+    {
+        return (terrarium == UNASSIGNED) ? m_unassigned : m_buckets[terrarium];
+    }
+    const Bucket& bucket(uint32_t terrarium) const
+    {
+        return (terrarium == UNASSIGNED) ? m_unassigned : m_buckets[terrarium];
+    }
+
+    void push(Bucket& b, uint32_t reptile);
+    void erase(Bucket& b, uint32_t reptile);
+    void grow(Bucket& b);
+    void compact();
+    void layout();
+};
+
+} // namespace ReptileSim
+
+#endif // OCCUPANCY_INDEX_HPP
@@ -6,10 +6,54 @@
 #ifndef REPTILE_ENGINE_HPP
 #define REPTILE_ENGINE_HPP
 
+#include "alert_monitor.hpp"
+#include "change_journal.hpp"
+#include "change_tracker.hpp"
+#include "engine_profiler.hpp"
 #include "game_state.hpp"
+#include "herd_csv.hpp"
+#include "history.hpp"
+#include "state_view.hpp"
+#include "telemetry_archive.hpp"
+#include "worker_pool.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 
 namespace ReptileSim {
 
+struct StageContext;
+
+/**
+ * @brief How tick() schedules the per-reptile engines
+ */
+enum class TickMode : uint8_t {
+    Sequential,     // One pass per engine (reference implementation)
+    Fused,          // One pass per reptile running every stage in order
+    Parallel,       // Fused, split by terrarium across a worker pool
+};
+
+/**
+ * @brief The 14 simulation engines (scheduler slots, in tick order)
+ */
+enum class SimEngine : uint8_t {
+    Physics,
+    Biology,
+    Nutrition,
+    Sanitary,
+    Economy,
+    Behavior,
+    Genetics,
+    Reproduction,
+    Social,
+    Seasonal,
+    Security,
+    Technical,
+    Admin,
+    Weather,
+    Count,
+};
+
 class ReptileEngine {
 public:
     // Singleton access
@@ -34,23 +78,279 @@ public:
      */
     void tick(float delta_time);
 
+    /**
+     * @brief Run `steps` ticks of `dt` back to back
+     *
+     * Same results as calling tick(dt) `steps` times; per-call setup (tick
+     * mode dispatch, parallel chunk plan) is done once per batch.
+     */
+    void tickBatch(uint32_t steps, float dt);
+
+    /**
+     * @brief Advance by real time at a time scale, in fixed steps
+     *
+     * real_seconds * time_scale accumulates and is consumed in whole
+     * FIXED_STEP ticks, so the step size (and stability) is the same at 1x
+     * or 1000x; the remainder carries over to the next call.
+     * @return Number of steps run
+     */
+    uint32_t advance(float real_seconds, float time_scale);
+    uint32_t advance(float real_seconds) { return advance(real_seconds, m_time_scale); }
+
+    /**
+     * @brief Time scale used by advance(real_seconds) (1 = real time)
+     */
+    void setTimeScale(float time_scale);
+    float getTimeScale() const { return m_time_scale; }
+
+    /**
+     * @brief Advance the simulation by a long span in one call
+     *
+     * Equivalent to game_seconds / 60 tick(1.0f) calls plus a partial tick,
+     * but the terrarium and reptile engines are integrated per constant
+     * stretch instead of per tick. Clock, economy, audits and weather are
+     * stepped exactly. Within tolerance:
+     * - Temperatures, humidity, immune, stomach and bone values match the
+     *   ticked run exactly.
+     * - Stress is summed in double and may differ from the ticked run by
+     *   float rounding (below 0.01; it does not accumulate past a clamp).
+     * - Equipment failures use the same per-tick probabilities but one
+     *   random draw per device, so individual failures differ.
+     *
+     * @param game_seconds Game time to skip (one game week = 604800)
+     */
+    void fastForward(double game_seconds);
+
+    /**
+     * @brief Select sequential, fused or parallel execution
+     *
+     * All modes produce bit-identical results.
+     */
+    void setTickMode(TickMode mode);
+    TickMode getTickMode() const { return m_tick_mode; }
+
+    /**
+     * @brief Background workers for TickMode::Parallel (-1 = cores - 1)
+     *
+     * The ticking task always takes part; 0 runs the parallel path inline.
+     */
+    void setWorkerCount(int workers);
+
+    /**
+     * @brief Run a global engine every `period` ticks
+     *
+     * Economy, security, technical, admin and weather can be slowed down.
+     * A slowed engine runs when the game minute count reaches `phase`
+     * modulo `period` (period 60, phase 0 = on the hour) and is passed the
+     * dt of every tick since its last run. The first run after this call,
+     * init() or a load also waits for the phase. The per-entity engines
+     * read each other's state every tick and always run at period 1.
+     *
+     * Tolerance against period 1:
+     * - Cost accruals (economy, security, admin, technical aging) are exact
+     *   up to float summation order; totals lag by up to one period.
+     * - Weather outputs (outside temperature, humidity, heatwave) are held
+     *   for the period; the outside temperature moves at most ~0.022 °C
+     *   per game minute, so heater-less terrariums follow it that much late.
+     * - Technical draws one failure check per run with the per-run dt, so
+     *   failure times shift within the period.
+     *
+     * @return false for a per-entity engine, period 0 or phase >= period
+     */
+    bool setEnginePeriod(SimEngine engine, uint32_t period, uint32_t phase = 0);
+    uint32_t getEnginePeriod(SimEngine engine) const;
+
+    /**
+     * @brief Times an engine has run since init (or the last reset)
+     */
+    uint64_t getEngineRuns(SimEngine engine) const;
+    void resetEngineRuns();
+
+    /**
+     * @brief Time spent in each engine (and fused pass) since init or reset
+     *
+     * Fused and parallel mode run the per-reptile engines as one pass, which
+     * is charged to ProfileSlot::FusedReptiles / ProfileSlot::Parallel; the
+     * sequential path fills every engine slot. Ticking task only, like
+     * resetProfile(); see EngineProfiler.
+     */
+    const ProfileStats& getProfile(ProfileSlot slot) const { return m_profiler.stats(slot); }
+    void resetProfile() { m_profiler.reset(); }
+
+    /**
+     * @brief Reptiles updated vs. skipped on the last tick
+     *
+     * In fused and parallel mode a reptile whose stages left it unchanged is
+     * put to sleep and skipped until something it reads changes: its
+     * terrarium's temperature or light, the number of occupants, dt, or the
+     * brumation/photoperiod context (hour and day boundaries). Setters,
+     * equipment failures and weather reach it through those inputs; feeding
+     * and any add/remove/assign/load wake it directly. Sleeping is exact:
+     * results are identical to the sequential path, which never sleeps.
+     */
+    struct SleepStats {
+        uint32_t awake;
+        uint32_t asleep;
+    };
+    SleepStats getSleepStats() const { return m_sleep_stats; }
+
     /**
      * @brief Get read-only game state
      */
     const GameState& getState() const { return m_state; }
 
     /**
-     * @brief Save complete game state to SPIFFS
+     * @brief Save complete game state to SPIFFS (binary snapshot)
+     *
+     * Columns are written whole (see snapshot.hpp) to filepath.tmp, which
+     * replaces filepath once complete.
      * @return true if successful
      */
     bool saveGame(const char* filepath);
 
+    /**
+     * @brief Compress the sections of later saves (off by default)
+     *
+     * Delta, byte-shuffle and LZ per column (see compression.hpp); loading
+     * detects it per section, so compressed and plain saves both load.
+     */
+    void setSaveCompression(bool on) { m_save_compression = on; }
+    bool getSaveCompression() const { return m_save_compression; }
+
     /**
      * @brief Load complete game state from SPIFFS
+     *
+     * Reads a binary snapshot, or a text save from exportText() / older
+     * firmware. A snapshot that fails its checks leaves the current state
+     * untouched.
      * @return true if successful
      */
     bool loadGame(const char* filepath);
 
+    /**
+     * @brief Write the state as one text line per entity (debugging)
+     *
+     * Floats are rounded to 2 decimals; loadGame() reads it back.
+     */
+    bool exportText(const char* filepath);
+
+    /**
+     * @brief saveGame() from a task other than the one ticking
+     *
+     * The ticking task copies the saved columns into a reused shadow state
+     * at its next tick boundary (entry of tickBatch(), so also advance()
+     * with no step due) and goes on; the calling task writes the copy.
+     * The simulation pauses for the copy only (ProfileSlot::SaveCapture);
+     * ticks that run during the write are timed in StepWhileSaving. The
+     * shadow state costs the saved columns' memory a second time.
+     * @param timeout_ms Wait for a tick boundary at most this long
+     * @return false on timeout or write failure
+     */
+    bool saveGameBackground(const char* filepath, uint32_t timeout_ms);
+
+    // ====================================================================================
+    // JOURNALED AUTOSAVE
+    // ====================================================================================
+
+    /**
+     * @brief Snapshot once, then autosave by appending to a change journal
+     *
+     * Writes the current state to snapshot_path and starts an empty journal
+     * at journal_path. From then on every tick batch, fast-forward, player
+     * action and setter is recorded (see change_journal.hpp), and
+     * flushJournal() makes them durable at a cost proportional to what was
+     * recorded, whatever the herd size. init() and loadGame() compact.
+     */
+    bool startJournal(const char* snapshot_path, const char* journal_path);
+
+    /**
+     * @brief Load snapshot_path and replay journal_path on top of it
+     *
+     * The result is bit-identical to the state at the last flush. Replay
+     * stops in front of the first torn or corrupt record; a journal of
+     * another snapshot is ignored. Journaling then continues on the same
+     * files: appending when the journal replayed to its end, otherwise
+     * after a compaction.
+     * @return false (state untouched) if the snapshot cannot be loaded
+     */
+    bool recoverJournal(const char* snapshot_path, const char* journal_path);
+
+    /**
+     * @brief Append the recorded changes and fsync (cheap, call often)
+     *
+     * After a failed flush the journal is closed and nothing is recorded
+     * until compactJournal() succeeds.
+     */
+    bool flushJournal();
+
+    /**
+     * @brief Write a fresh snapshot and restart the journal empty
+     *
+     * Bounds the replay time and journal size; call when getJournalStats()
+     * shows many ticks or bytes since the last snapshot, or after a failed
+     * flush.
+     */
+    bool compactJournal();
+
+    /**
+     * @brief compactJournal() from another task (see saveGameBackground())
+     *
+     * The journal is cut at the copied tick; records after it are kept for
+     * the new journal while the snapshot is written, and go to the old one
+     * if it fails.
+     */
+    bool compactJournalBackground(uint32_t timeout_ms);
+
+    /**
+     * @brief Flush and stop recording
+     */
+    void stopJournal();
+
+    bool isJournaling() const { return !m_journal_path.empty(); }
+    ChangeJournal::Stats getJournalStats() const { return m_journal.stats(); }
+
+    // ====================================================================================
+    // BULK IMPORT / EXPORT
+    // ====================================================================================
+
+    /**
+     * @brief Add many reptiles at once (capacity reserved once)
+     *
+     * Rows naming an unknown terrarium are skipped. When journaling, the
+     * batch is saved by compacting instead of recording one add per row.
+     * @param out_ids Optional, one per row: the new id, 0 if skipped
+     * @return Reptiles added
+     */
+    size_t addReptiles(const ReptileRow* rows, size_t count, uint32_t* out_ids = nullptr);
+
+    /**
+     * @brief Add many terrariums at once (see addReptiles())
+     */
+    size_t addTerrariums(const TerrariumRow* rows, size_t count, uint32_t* out_ids = nullptr);
+
+    /**
+     * @brief Add the terrariums and reptiles of two CSV files (see herd_csv.hpp)
+     *
+     * Terrarium columns: width, height, depth (cm), and optionally id.
+     * Reptile columns: name, species, and optionally terrarium_id and
+     * weight_grams. With a terrarium file, reptile terrarium_ids refer to
+     * its id column; without one, to terrariums already in the game. New
+     * animals start in the addReptile() condition. Bad rows are skipped and
+     * listed in the report; either path may be null. Both files are read
+     * before anything is added.
+     * @return false, with nothing added, if a file cannot be read or lacks
+     * a required column
+     */
+    bool importHerdCsv(const char* terrariums_path, const char* reptiles_path, CsvImportReport* report = nullptr);
+
+    /**
+     * @brief Write every terrarium and reptile in the importHerdCsv() format
+     *
+     * Condition columns (stress, hydration, ...) are included for
+     * spreadsheets and ignored on import.
+     */
+    bool exportHerdCsv(const char* terrariums_path, const char* reptiles_path) const;
+
     // ====================================================================================
     // PLAYER ACTIONS
     // ====================================================================================
@@ -67,6 +367,26 @@ public:
      */
     uint32_t addTerrarium(float width, float height, float depth);
 
+    /**
+     * @brief Remove a reptile (O(1), its id becomes stale)
+     * @return false if the id is unknown or already stale
+     */
+    bool removeReptile(uint32_t reptile_id);
+
+    /**
+     * @brief Remove a terrarium (O(occupants), its id becomes stale)
+     *
+     * Occupants become unassigned (assigned_terrarium_id 0).
+     * @return false if the id is unknown or already stale
+     */
+    bool removeTerrarium(uint32_t terrarium_id);
+
+    /**
+     * @brief Move a reptile into a terrarium (0 = unassign)
+     * @return false if either id is unknown or stale
+     */
+    bool assignReptile(uint32_t reptile_id, uint32_t terrarium_id);
+
     /**
      * @brief Feed a reptile
      */
@@ -130,6 +450,17 @@ public:
      */
     bool getMisterState(uint32_t terrarium_id) const;
 
+    /**
+     * @brief Number of reptiles housed in a terrarium (O(1))
+     */
+    int getTerrariumOccupantCount(uint32_t terrarium_id) const;
+
+    /**
+     * @brief Copy up to max_ids occupant ids of a terrarium
+     * @return Number of ids written
+     */
+    int getTerrariumOccupants(uint32_t terrarium_id, uint32_t* out_ids, int max_ids) const;
+
     /**
      * @brief Get reptile stress level
      */
@@ -150,13 +481,376 @@ public:
      */
     bool isReptileHealthy(uint32_t reptile_id) const;
 
+    // ====================================================================================
+    // PUBLISHED VIEWS (any task)
+    // ====================================================================================
+
+    // The getters above read the live state and belong to the ticking task.
+    // These copy from the views published at the end of a tick batch, so a
+    // UI or network task can call them while the simulation runs; they lag
+    // the live state by at most one batch (see StateViews).
+
+    /**
+     * @brief Terrarium as of the last published tick
+     * @return false if the id was not live then
+     */
+    bool getTerrariumView(uint32_t terrarium_id, TerrariumView& out) const { return m_views.terrarium(terrarium_id, out); }
+
+    /**
+     * @brief Reptile as of the last published tick
+     * @return false if the id was not live then
+     */
+    bool getReptileView(uint32_t reptile_id, ReptileView& out) const { return m_views.reptile(reptile_id, out); }
+
+    /**
+     * @brief Clock, weather, counts and economy as of the last published tick
+     */
+    WorldView getWorldView() const { return m_views.world(); }
+
+    // ====================================================================================
+    // HISTORY
+    // ====================================================================================
+
+    /**
+     * @brief Record terrarium climate and reptile stress/weight every tick
+     *
+     * Allocates fixed rings (HistoryRecorder::bytesFor(config)) and starts
+     * them empty; recording cost shows in the "history" profile slot.
+     * @return false if the allocation failed (history stays off)
+     */
+    bool enableHistory(const HistoryConfig& config) { return m_history.enable(config); }
+    void disableHistory() { m_history.disable(); }
+    size_t getHistoryBytes() const { return m_history.bytes(); }
+
+    /**
+     * @brief One series over [from_ms, to_ms] of game clock, oldest first
+     *
+     * Reads the rings the ticking task writes: call it from that task, like
+     * the getters above.
+     * @return Points written, at the best resolution still held for from_ms
+     */
+    size_t getHistory(HistoryChannel channel, uint32_t id, uint64_t from_ms, uint64_t to_ms, HistoryPoint* out,
+                      size_t max_points, HistoryTier* tier = nullptr) const
+    {
+        return m_history.query(channel, id, from_ms, to_ms, out, max_points, tier);
+    }
+
+    // ====================================================================================
+    // TELEMETRY ARCHIVE
+    // ====================================================================================
+
+    /**
+     * @brief Archive the history channels to `dir` (e.g. on the SD card)
+     *
+     * Samples every config.period_s of tick() time. A full chunk is sealed
+     * in RAM and written by writeTelemetry() from another task, or by the
+     * ticking task at the next seal if nobody did (see TelemetryArchive).
+     * @return false if the directory or an existing archive cannot be used
+     */
+    bool startTelemetry(const char* dir, const TelemetryConfig& config = TelemetryArchive::defaultConfig())
+    {
+        return m_telemetry.open(dir, config);
+    }
+
+    /**
+     * @brief Write the buffered samples and stop archiving
+     */
+    bool stopTelemetry() { return m_telemetry.close(); }
+
+    /**
+     * @brief Write the sealed chunk, if any (any task, e.g. the autosave task)
+     */
+    bool writeTelemetry() { return m_telemetry.writeSealed(); }
+
+    /**
+     * @brief Write the sealed and buffered samples now (e.g. before power-off)
+     */
+    bool flushTelemetry() { return m_telemetry.flush(); }
+
+    /**
+     * @brief Archived samples of one series in [from_ms, to_ms] (ticking task)
+     */
+    bool queryTelemetry(HistoryChannel channel, uint32_t id, uint64_t from_ms, uint64_t to_ms,
+                        std::vector<TelemetryPoint>& out) const
+    {
+        return m_telemetry.query(channel, id, from_ms, to_ms, out);
+    }
+
+    TelemetryStats getTelemetryStats() const { return m_telemetry.stats(); }
+
+    // ====================================================================================
+    // ALERTS (any task drains)
+    // ====================================================================================
+
+    /**
+     * @brief Oldest alert edge not yet taken, from any one draining task
+     *
+     * Every terrarium and reptile is checked against the rules at the end
+     * of each tick; only edges are queued (raised, then cleared once the
+     * reading is back inside the band), so a condition that lasts queues
+     * nothing more. The queue holds ALERT_QUEUE_CAPACITY events; an edge
+     * that does not fit is queued at a later tick instead (see AlertMonitor).
+     * @return false if nothing is queued
+     */
+    bool pollAlert(AlertEvent& out) { return m_alerts.poll(out); }
+    uint32_t getDeferredAlerts() const { return m_alerts.deferred(); }
+
+    /**
+     * @brief Thresholds (ticking task); every entity is re-judged next tick
+     */
+    void setAlertRules(const AlertRules& rules) { m_alerts.setRules(rules); }
+    const AlertRules& getAlertRules() const { return m_alerts.rules(); }
+
+    // ====================================================================================
+    // CHANGES (ticking task)
+    // ====================================================================================
+
+    /**
+     * @brief Latest change version; unchanged means no entity changed
+     *
+     * Every entity has a version per field group, moved only when a value
+     * of the group rounds to another multiple of its epsilon (see
+     * ChangeTracker and ChangeEpsilons). Versions
+     * are taken at the end of each tick, and at the end of a paused
+     * tickBatch for the player's actions. Published views carry them too.
+     */
+    uint64_t getChangeVersion() const { return m_changes.version(); }
+
+    /**
+     * @brief Ids added, changed or removed after version `since`
+     *
+     * Costs the entities that changed, not the herd. If out.complete is
+     * false the history before `since` is gone (load, long absence) and
+     * everything should be re-read; out.version is the next `since`.
+     */
+    void getChangedSince(uint64_t since, ChangeSet& out, uint8_t terrarium_groups = TERRARIUM_FIELDS_ALL,
+                         uint8_t reptile_groups = REPTILE_FIELDS_ALL) const
+    {
+        m_changes.changedSince(since, out, terrarium_groups, reptile_groups);
+    }
+
+    uint64_t getTerrariumVersion(uint32_t terrarium_id, uint8_t groups = TERRARIUM_FIELDS_ALL) const
+    {
+        return m_changes.terrariumVersion(terrarium_id, groups);
+    }
+    uint64_t getReptileVersion(uint32_t reptile_id, uint8_t groups = REPTILE_FIELDS_ALL) const
+    {
+        return m_changes.reptileVersion(reptile_id, groups);
+    }
+
+    void setChangeEpsilons(const ChangeEpsilons& epsilons) { m_changes.setEpsilons(epsilons); }
+    const ChangeEpsilons& getChangeEpsilons() const { return m_changes.epsilons(); }
+
+    /**
+     * @brief Parallel tick work unit
+     *
+     * Either terrariums [terra_begin, terra_end) with all their occupants, or
+     * unassigned reptiles [homeless_begin, homeless_end) of that bucket.
+     */
+    struct TickChunk {
+        uint32_t terra_begin, terra_end;
+        uint32_t homeless_begin, homeless_end;
+    };
+
+    /**
+     * @brief Herd-wide totals of one chunk, reduced in chunk order
+     */
+    struct ChunkTotals {
+        uint32_t terrariums;
+        uint32_t reptiles;
+        uint32_t awake;
+    };
+
+    /**
+     * @brief What the occupants of one bucket read from outside themselves
+     */
+    struct BucketInputs {
+        float temp;             // temp_hot_zone after physics
+        uint32_t occupants;
+        uint8_t light;          // EQUIP_LIGHT bit
+
+        bool operator==(const BucketInputs& o) const
+        {
+            return temp == o.temp && occupants == o.occupants && light == o.light;
+        }
+    };
+
+    /**
+     * @brief Last tick's inputs and awake count of one occupancy bucket
+     */
+    struct BucketRest {
+        BucketInputs inputs;
+        uint32_t awake;
+    };
+
+    // Fixed step of advance() (seconds of tick() time)
+    static constexpr float FIXED_STEP = 1.0f;
+
+    // Backlog cap per advance() call; older steps are dropped, not replayed
+    static constexpr uint32_t MAX_STEPS_PER_ADVANCE = 10000;
+
+    // Default period of the hour-scale global engines (ticks)
+    static constexpr uint32_t HOURLY_ENGINE_PERIOD = 60;
+    static constexpr uint32_t WEATHER_ENGINE_PERIOD = 5;
+
 private:
     ReptileEngine() = default;
     ~ReptileEngine() = default;
 
+    // Target terrariums + reptiles per parallel chunk
+    static constexpr uint32_t PARALLEL_CHUNK_WORK = 1024;
+
     GameState m_state;
-    uint32_t m_next_reptile_id = 1;
-    uint32_t m_next_terrarium_id = 1;
+    TickMode m_tick_mode = TickMode::Fused;
+
+    // Sleep/wake: one BucketRest per terrarium index, unassigned last
+    std::vector<BucketRest> m_rest;
+    float m_rest_dt = 0.0f;
+    bool m_rest_brumation = false;
+    bool m_rest_dark = false;
+    bool m_wake_all = true;
+    SleepStats m_sleep_stats = {0, 0};
+
+    // Multi-rate scheduler, one slot per SimEngine
+    struct EngineSchedule {
+        uint32_t period;
+        uint32_t phase;
+        uint64_t slot;          // Period index of the last run
+        float pending_dt;       // dt accumulated since the last run
+        uint64_t runs;
+    };
+    EngineSchedule m_schedule[static_cast<size_t>(SimEngine::Count)] = {
+        {1, 0, 0, 0.0f, 0},                         // Physics
+        {1, 0, 0, 0.0f, 0},                         // Biology
+        {1, 0, 0, 0.0f, 0},                         // Nutrition
+        {1, 0, 0, 0.0f, 0},                         // Sanitary
+        {1, 0, 0, 0.0f, 0},                         // Economy
+        {1, 0, 0, 0.0f, 0},                         // Behavior
+        {1, 0, 0, 0.0f, 0},                         // Genetics
+        {1, 0, 0, 0.0f, 0},                         // Reproduction
+        {1, 0, 0, 0.0f, 0},                         // Social
+        {1, 0, 0, 0.0f, 0},                         // Seasonal
+        {HOURLY_ENGINE_PERIOD, 0, 0, 0.0f, 0},      // Security
+        {1, 0, 0, 0.0f, 0},                         // Technical
+        {HOURLY_ENGINE_PERIOD, 0, 0, 0.0f, 0},      // Admin
+        {WEATHER_ENGINE_PERIOD, 0, 0, 0.0f, 0},     // Weather
+    };
+
+    // Per-engine timings (lap timer through step())
+    EngineProfiler m_profiler;
+
+    // Fixed-step time control
+    float m_time_scale = 1.0f;
+    double m_accumulator = 0.0;     // Scaled seconds not yet stepped
+
+    // Parallel tick
+    WorkerPool m_pool;
+    unsigned m_worker_count = WorkerPool::defaultWorkers();
+    bool m_pool_started = false;
+    std::vector<TickChunk> m_chunks;
+    std::vector<ChunkTotals> m_chunk_totals;
+
+    // Journaled autosave
+    ChangeJournal m_journal;
+    std::string m_journal_path;
+    std::string m_journal_snapshot;     // Snapshot the journal extends
+    uint64_t m_journal_generation = 0;  // Of the last snapshot written or loaded
+    bool m_journal_muted = false;       // Inside init, fast-forward and replay
+
+    bool journaling() const { return !m_journal_muted && m_journal.isOpen(); }
+
+    // Compaction around a snapshot: new generation and journal cut at the
+    // snapshot's tick, then commit or cancel once it is written
+    void beginCompaction();
+    bool finishCompaction(bool saved);
+
+    // Background save: the caller requests a copy, the ticking task makes
+    // it at the next tick boundary (serviceCapture) and the caller writes it
+    std::mutex m_save_mutex;                    // One background save at a time
+    std::mutex m_capture_mutex;
+    std::condition_variable m_capture_done;
+    std::atomic<bool> m_capture_requested{false};
+    std::atomic<bool> m_save_writing{false};
+    bool m_capture_compact = false;
+    GameState m_save_state;                     // Shadow copy of the saved columns
+    std::vector<uint8_t> m_save_engine;
+    bool m_save_compression = false;
+
+    bool saveBackground(const std::string& filepath, bool compact, uint32_t timeout_ms);
+    void serviceCapture();
+
+    // Read-only views for other tasks, published at the end of tickBatch
+    StateViews m_views;
+
+    // Trend rings, written at the end of each step when enabled
+    HistoryRecorder m_history;
+
+    // Long-term archive, sampled at the end of each step when open
+    TelemetryArchive m_telemetry;
+
+    // Alert latches and queue, evaluated at the end of each step
+    AlertMonitor m_alerts;
+    void evaluateAlerts(bool woke_all);
+
+    // Change versions, taken at the end of each step and of a paused batch
+    ChangeTracker m_changes;
+    void trackChanges(bool woke_all);
+    void trackActions();
+
+    // Reptiles a step may have changed: the ones left awake
+    template <typename Visit>
+    void forEachAwake(Visit visit) const;
+
+    // Scheduler, random stream and journal generation (SNAP_ENGINE)
+    std::vector<uint8_t> engineSection() const;
+    void restoreEngineSection(const std::vector<uint8_t>& bytes);
+
+    // Apply one journal record; false if it is malformed or does not apply
+    bool replayRecord(JournalOp op, const uint8_t* payload, uint32_t length, uint64_t& ticks);
+    void recordEquipment(uint32_t terrarium_id, uint8_t flag, bool on);
+
+    // addReptile / addTerrarium with a given id (0 = allocate), unrecorded
+    uint32_t insertReptile(uint32_t id, const std::string& name, const std::string& species);
+    uint32_t insertTerrarium(uint32_t id, float width, float height, float depth);
+
+    // addReptiles / addTerrariums, unrecorded
+    size_t insertReptiles(const ReptileRow* rows, size_t count, uint32_t* out_ids);
+    size_t insertTerrariums(const TerrariumRow* rows, size_t count, uint32_t* out_ids);
+
+    // A bulk add is journaled as a new snapshot
+    void bulkAdded(size_t added);
+
+    // Re-resolve every terrarium_index and rebuild the occupancy index (load)
+    void rebuildOccupancy();
+
+    // loadGame() without the journal compaction
+    bool loadState(const char* filepath);
+
+    // Text save reader (exportText() and pre-snapshot saves)
+    bool importText(const char* filepath);
+
+    // Game clock part of tick()
+    void advanceClock(float dt);
+
+    // One tick after per-batch setup (tick() = setup + step)
+    void step(float dt);
+
+    // Scheduler: accumulate dt and report whether the engine runs now
+    // (run_dt = dt since its last run); global engines of one step
+    bool engineDue(SimEngine engine, float dt, float& run_dt);
+    uint64_t clockSlot(const EngineSchedule& s) const;
+    void seedEngineSlots();     // Current clock's slots: next runs wait for their phase
+    void countEntityRuns(uint64_t ticks);
+    void updateGlobalEngines(float dt, bool fast_forward);
+
+    // Sleep/wake: start of a fused/parallel pass (true = wake everyone),
+    // and single-reptile wake for direct mutations
+    bool beginSettle(const StageContext& ctx);
+    void wakeReptile(size_t i);
+
+    // Fast-forward: global engines stepped, entity engines integrated
+    static constexpr uint32_t FAST_FORWARD_WINDOW = 1440;   // Ticks (1 game day)
+    void fastForwardWindow(uint32_t ticks);
 
     // Private engine update methods (14 simulation engines)
     void updatePhysics(float dt);
@@ -173,6 +867,16 @@ private:
     void updateTechnical(float dt);
     void updateAdmin(float dt);
     void updateWeather(float dt);
+
+    // Biology, nutrition, behavior, genetics, reproduction, social and
+    // seasonal in a single pass over the herd
+    void updateFusedReptiles(float dt);
+
+    // Physics, fused reptile stages and sanitary, chunked over m_pool
+    // (chunks planned once per tick or batch)
+    void planChunks();
+    void updateParallel(float dt);
+    static void runChunk(void* job, uint32_t chunk);
 };
 
 } // namespace ReptileSim
@@ -181,52 +885,6 @@ private:
 // C INTERFACE (for integration with main.c)
 // ====================================================================================
 
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-void reptile_engine_init(void);
-void reptile_engine_tick(float delta_time);
-
-// Getters for C code
-uint32_t reptile_engine_get_day(void);
-float reptile_engine_get_time_hours(void);
-int reptile_engine_get_reptile_count(void);
-int reptile_engine_get_terrarium_count(void);
-
-// Equipment control
-void reptile_engine_set_heater(uint32_t terrarium_id, bool on);
-void reptile_engine_set_light(uint32_t terrarium_id, bool on);
-void reptile_engine_set_mister(uint32_t terrarium_id, bool on);
-
-// Actions
-void reptile_engine_feed_animal(uint32_t reptile_id);
-void reptile_engine_clean_terrarium(uint32_t terrarium_id);
-
-// Terrarium state getters
-float reptile_engine_get_terrarium_temp(uint32_t terrarium_id);
-float reptile_engine_get_terrarium_humidity(uint32_t terrarium_id);
-float reptile_engine_get_terrarium_waste(uint32_t terrarium_id);
-bool reptile_engine_get_heater_state(uint32_t terrarium_id);
-bool reptile_engine_get_light_state(uint32_t terrarium_id);
-bool reptile_engine_get_mister_state(uint32_t terrarium_id);
-
-// Reptile state getters
-float reptile_engine_get_reptile_stress(uint32_t reptile_id);
-float reptile_engine_get_reptile_weight(uint32_t reptile_id);
-bool reptile_engine_is_reptile_hungry(uint32_t reptile_id);
-bool reptile_engine_is_reptile_healthy(uint32_t reptile_id);
-
-// Save/Load system
-bool reptile_engine_save_game(const char* filepath);
-bool reptile_engine_load_game(const char* filepath);
-
-// Add/Remove entities
-uint32_t reptile_engine_add_reptile(const char* name, const char* species);
-uint32_t reptile_engine_add_terrarium(float width, float height, float depth);
-
-#ifdef __cplusplus
-}
-#endif
+#include "reptile_engine_c.h"
 
 #endif // REPTILE_ENGINE_HPP
@@ -13,13 +13,256 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Tick execution modes (see ReptileSim::TickMode)
+ */
+typedef enum {
+    REPTILE_TICK_SEQUENTIAL = 0,    // One pass per engine (reference)
+    REPTILE_TICK_FUSED = 1,         // All per-reptile engines in one pass (default)
+    REPTILE_TICK_PARALLEL = 2,      // Fused, split by terrarium over worker tasks
+} reptile_tick_mode_t;
+
+/**
+ * @brief Simulation engines (see ReptileSim::SimEngine)
+ */
+typedef enum {
+    REPTILE_ENGINE_PHYSICS = 0,
+    REPTILE_ENGINE_BIOLOGY,
+    REPTILE_ENGINE_NUTRITION,
+    REPTILE_ENGINE_SANITARY,
+    REPTILE_ENGINE_ECONOMY,
+    REPTILE_ENGINE_BEHAVIOR,
+    REPTILE_ENGINE_GENETICS,
+    REPTILE_ENGINE_REPRODUCTION,
+    REPTILE_ENGINE_SOCIAL,
+    REPTILE_ENGINE_SEASONAL,
+    REPTILE_ENGINE_SECURITY,
+    REPTILE_ENGINE_TECHNICAL,
+    REPTILE_ENGINE_ADMIN,
+    REPTILE_ENGINE_WEATHER,
+    REPTILE_ENGINE_COUNT
+} reptile_engine_id_t;
+
+/**
+ * @brief Profile sections: the engines above, then these passes
+ */
+typedef enum {
+    REPTILE_PROFILE_FUSED = REPTILE_ENGINE_COUNT,   // Fused per-reptile pass
+    REPTILE_PROFILE_PARALLEL,                       // Whole parallel entity pass
+    REPTILE_PROFILE_STEP,                           // One whole tick
+    REPTILE_PROFILE_CAPTURE,                        // Background save: tick-boundary copy
+    REPTILE_PROFILE_STEP_SAVING,                    // Ticks run while a background save writes
+    REPTILE_PROFILE_HISTORY,                        // History ring recording
+    REPTILE_PROFILE_TELEMETRY,                      // Telemetry archive sampling + chunk writes
+    REPTILE_PROFILE_ALERTS,                         // Alert rule evaluation
+    REPTILE_PROFILE_CHANGES,                        // Change tracking
+    REPTILE_PROFILE_COUNT
+} reptile_profile_slot_t;
+
+#define REPTILE_PROFILE_BUCKETS 32
+
+/**
+ * @brief Timings of one profile section (see ReptileSim::ProfileStats)
+ */
+typedef struct {
+    const char *name;           // "physics", ..., "step"
+    uint64_t calls;
+    uint64_t total_ns;
+    uint32_t last_ns;
+    uint32_t min_ns;
+    uint32_t max_ns;
+    uint32_t mean_ns;
+    uint32_t histogram[REPTILE_PROFILE_BUCKETS];    // [k]: calls of 2^k..2^(k+1) ns
+} reptile_profile_entry_t;
+
+/**
+ * @brief Change journal counters (see ReptileSim::ChangeJournal::Stats)
+ */
+typedef struct {
+    uint64_t generation;        // Snapshot the journal extends
+    uint64_t file_bytes;        // Journal file size
+    uint64_t ticks;             // Ticks a recovery would replay
+    uint32_t records;
+    uint32_t pending_bytes;     // Recorded, not yet flushed
+} reptile_journal_stats_t;
+
+/**
+ * @brief Globals as of the last published tick (see ReptileSim::WorldView)
+ */
+typedef struct {
+    uint64_t version;           // Unchanged = same tick as the last read
+    uint64_t change_version;    // Unchanged = no entity changed
+    uint64_t game_clock_ms;
+    uint32_t day;
+    float time_hours;
+    float external_temperature;
+    float external_humidity;
+    bool heatwave;
+    int reptile_count;
+    int terrarium_count;
+    float total_expenses;
+} reptile_world_view_t;
+
+/**
+ * @brief Terrarium as of the last published tick
+ */
+typedef struct {
+    uint32_t id;
+    uint64_t version;           // Of its last change; unchanged = nothing to redraw
+    float temp_hot;
+    float temp_cold;
+    float humidity;
+    float uv_index;
+    float waste;
+    float bacteria;
+    int occupant_count;
+    bool heater_on;
+    bool light_on;
+    bool mister_on;
+} reptile_terrarium_view_t;
+
+/**
+ * @brief Reptile as of the last published tick
+ */
+typedef struct {
+    uint32_t id;
+    uint64_t version;           // Of its last change; unchanged = nothing to redraw
+    uint32_t terrarium_id;      // 0 = unassigned
+    float weight;
+    float bone_density;
+    float hydration;
+    float stress;
+    float stomach;
+    float immune;
+    bool healthy;
+    bool hungry;
+    bool shedding;
+} reptile_reptile_view_t;
+
+/**
+ * @brief History series (see ReptileSim::HistoryChannel); the first four
+ * take a terrarium id, the last two a reptile id
+ */
+typedef enum {
+    REPTILE_HISTORY_TEMP = 0,
+    REPTILE_HISTORY_HUMIDITY,
+    REPTILE_HISTORY_WASTE,
+    REPTILE_HISTORY_BACTERIA,
+    REPTILE_HISTORY_STRESS,
+    REPTILE_HISTORY_WEIGHT,
+} reptile_history_channel_t;
+
+/**
+ * @brief One history point (raw samples: min = max = avg)
+ */
+typedef struct {
+    uint64_t time_ms;           // Game clock
+    float min;
+    float max;
+    float avg;
+} reptile_history_point_t;
+
+/**
+ * @brief One archived telemetry sample
+ */
+typedef struct {
+    uint64_t time_ms;           // Game clock
+    float value;
+} reptile_telemetry_point_t;
+
+/**
+ * @brief Alert rules (see ReptileSim::AlertKind); the first three watch a
+ * terrarium id, the rest a reptile id
+ */
+typedef enum {
+    REPTILE_ALERT_TEMP_HIGH = 0,
+    REPTILE_ALERT_TEMP_LOW,
+    REPTILE_ALERT_WASTE_HIGH,
+    REPTILE_ALERT_SICK,
+    REPTILE_ALERT_STRESS_HIGH,
+    REPTILE_ALERT_HUNGRY,
+} reptile_alert_kind_t;
+
+typedef enum {
+    REPTILE_ALERT_INFO = 0,
+    REPTILE_ALERT_WARNING,
+    REPTILE_ALERT_CRITICAL,
+} reptile_alert_severity_t;
+
+/**
+ * @brief One alert edge: raised, or cleared once back inside the band
+ */
+typedef struct {
+    uint64_t time_ms;           // Game clock of the tick
+    uint32_t entity_id;
+    float value;                // Reading at the edge (flag rules: 1 / 0)
+    reptile_alert_kind_t kind;
+    reptile_alert_severity_t severity;
+    bool raised;
+} reptile_alert_t;
+
+/**
+ * @brief Field groups with a version each (see ReptileSim::TerrariumFields / ReptileFields)
+ */
+typedef enum {
+    REPTILE_TERRARIUM_CLIMATE   = 1 << 0,   // Temperatures, humidity, UV
+    REPTILE_TERRARIUM_HYGIENE   = 1 << 1,   // Waste, bacteria
+    REPTILE_TERRARIUM_EQUIPMENT = 1 << 2,
+    REPTILE_TERRARIUM_ALL       = 0x07,
+} reptile_terrarium_fields_t;
+
+typedef enum {
+    REPTILE_ANIMAL_BODY      = 1 << 0,      // Weight, bone density, hydration
+    REPTILE_ANIMAL_CONDITION = 1 << 1,      // Stress, stomach, immune system
+    REPTILE_ANIMAL_STATUS    = 1 << 2,      // Healthy / hungry / shedding
+    REPTILE_ANIMAL_PLACEMENT = 1 << 3,      // Assigned terrarium
+    REPTILE_ANIMAL_ALL       = 0x0F,
+} reptile_animal_fields_t;
+
+/**
+ * @brief Id lists of reptile_engine_changed_since()
+ */
+typedef enum {
+    REPTILE_CHANGED_TERRARIUMS = 0,         // Added or changed
+    REPTILE_CHANGED_REPTILES,
+    REPTILE_REMOVED_TERRARIUMS,
+    REPTILE_REMOVED_REPTILES,
+} reptile_change_list_t;
+
+/**
+ * @brief Outcome of reptile_engine_import_csv() (see ReptileSim::CsvImportReport)
+ */
+typedef struct {
+    uint32_t terrariums;        // Rows imported
+    uint32_t reptiles;
+    uint32_t rejected;          // Rows skipped
+    uint32_t first_error_line;  // 0 = none
+    const char *first_error;    // Static message, NULL = none
+} reptile_import_report_t;
+
 void reptile_engine_init(void);
 void reptile_engine_tick(float delta_time);
+void reptile_engine_fast_forward(double game_seconds);  // Many ticks at once
+void reptile_engine_tick_batch(uint32_t steps, float delta_time);
+uint32_t reptile_engine_advance(float real_seconds);    // Fixed steps at the time scale
+void reptile_engine_set_time_scale(float time_scale);   // 1 = real time, 10, 100, 1000...
+float reptile_engine_get_time_scale(void);
+void reptile_engine_set_tick_mode(reptile_tick_mode_t mode);
+void reptile_engine_set_worker_count(int workers);     // -1 = cores - 1
+bool reptile_engine_set_engine_period(reptile_engine_id_t engine, uint32_t period, uint32_t phase);
+uint32_t reptile_engine_get_engine_period(reptile_engine_id_t engine);
+uint64_t reptile_engine_get_engine_runs(reptile_engine_id_t engine);
+// Profile counters (ticking task only: unsynchronised 64-bit counters, see EngineProfiler)
+int reptile_engine_get_profile(reptile_profile_entry_t *out, int max_entries);  // Slot order; 0 if compiled out
+void reptile_engine_reset_profile(void);
 
 uint32_t reptile_engine_get_day(void);
 float reptile_engine_get_time_hours(void);
+uint64_t reptile_engine_get_game_clock_ms(void);
 int reptile_engine_get_reptile_count(void);
 int reptile_engine_get_terrarium_count(void);
+uint32_t reptile_engine_get_awake_count(void);     // Reptiles updated last tick
+uint32_t reptile_engine_get_asleep_count(void);    // Reptiles settled and skipped
 void reptile_engine_set_heater(uint32_t terrarium_id, bool on);
 void reptile_engine_set_light(uint32_t terrarium_id, bool on);
 void reptile_engine_set_mister(uint32_t terrarium_id, bool on);
@@ -35,10 +278,59 @@ float reptile_engine_get_reptile_stress(uint32_t reptile_id);
 float reptile_engine_get_reptile_weight(uint32_t reptile_id);
 bool reptile_engine_is_reptile_hungry(uint32_t reptile_id);
 bool reptile_engine_is_reptile_healthy(uint32_t reptile_id);
+// Safe from any task: copies of the last published tick (the getters above
+// read the live state and belong to the ticking task)
+bool reptile_engine_get_terrarium_view(uint32_t terrarium_id, reptile_terrarium_view_t *out);
+bool reptile_engine_get_reptile_view(uint32_t reptile_id, reptile_reptile_view_t *out);
+void reptile_engine_get_world_view(reptile_world_view_t *out);
+// Trend rings (default sizes, PSRAM): ids with a slot past the limits are not recorded
+bool reptile_engine_enable_history(uint32_t terrarium_slots, uint32_t reptile_slots);
+uint32_t reptile_engine_get_history_bytes(void);
+// Ticking task only; best resolution still held for from_ms, oldest first
+int reptile_engine_get_history(reptile_history_channel_t channel, uint32_t id, uint64_t from_ms, uint64_t to_ms,
+                               reptile_history_point_t *out, int max_points);
+// Long-term archive in a directory (SD card); 0 = default period (60 s) / chunk (240 samples)
+bool reptile_engine_telemetry_start(const char *dir, uint32_t period_s, uint32_t chunk_samples);
+bool reptile_engine_telemetry_stop(void);     // Writes the buffered samples
+bool reptile_engine_telemetry_flush(void);
+// Any task: write the chunk the ticking task sealed, so it never waits on the card
+bool reptile_engine_telemetry_write(void);
+// Ticking task only; oldest first, at most max_points; -1 if not archiving or a read failed
+int reptile_engine_telemetry_query(reptile_history_channel_t channel, uint32_t id, uint64_t from_ms, uint64_t to_ms,
+                                   reptile_telemetry_point_t *out, int max_points);
+// Alert edges of every entity, oldest first; one draining task (the UI)
+bool reptile_engine_poll_alert(reptile_alert_t *out);
+uint32_t reptile_engine_get_deferred_alerts(void);   // Held back by a full queue, sent later
+// Change versions (ticking task only); a version only moves when a value rounds to another
+// multiple of its epsilon (0.1 by default, the "%.1f" the UI prints with)
+uint64_t reptile_engine_get_change_version(void);
+// Ids of one list changed after `since` in `groups` (the list's field bits, 0 = all), at most
+// max_ids; returns the full count, or -1 if `since` predates the history kept (re-read everything)
+int reptile_engine_changed_since(uint64_t since, reptile_change_list_t list, uint8_t groups, uint32_t *out_ids,
+                                 int max_ids);
 bool reptile_engine_save_game(const char *filepath);
-bool reptile_engine_load_game(const char *filepath);
+void reptile_engine_set_save_compression(bool on);        // Smaller saves, same loader
+bool reptile_engine_load_game(const char *filepath);      // Snapshot or text
+bool reptile_engine_export_text(const char *filepath);    // Debug text dump
+bool reptile_engine_journal_start(const char *snapshot_path, const char *journal_path);     // Snapshot + empty journal
+bool reptile_engine_journal_recover(const char *snapshot_path, const char *journal_path);   // Snapshot + replay
+bool reptile_engine_journal_flush(void);      // Append + fsync the recorded changes
+bool reptile_engine_journal_compact(void);    // New snapshot, journal restarts empty
+// From a task other than the ticking one: the state is copied at the next
+// tick boundary and written by the caller; false after timeout_ms without one
+bool reptile_engine_save_game_background(const char *filepath, uint32_t timeout_ms);
+bool reptile_engine_journal_compact_background(uint32_t timeout_ms);
+void reptile_engine_get_journal_stats(reptile_journal_stats_t *out);
 uint32_t reptile_engine_add_reptile(const char *name, const char *species);
 uint32_t reptile_engine_add_terrarium(float width, float height, float depth);
+// Studbook CSV (header row; see ReptileEngine::importHerdCsv), either path may be NULL
+bool reptile_engine_import_csv(const char *terrariums_path, const char *reptiles_path, reptile_import_report_t *out);
+bool reptile_engine_export_csv(const char *terrariums_path, const char *reptiles_path);
+bool reptile_engine_assign_reptile(uint32_t reptile_id, uint32_t terrarium_id);
+int reptile_engine_get_terrarium_occupant_count(uint32_t terrarium_id);
+int reptile_engine_get_terrarium_occupants(uint32_t terrarium_id, uint32_t *out_ids, int max_ids);
+bool reptile_engine_remove_reptile(uint32_t reptile_id);
+bool reptile_engine_remove_terrarium(uint32_t terrarium_id);
 
 #ifdef __cplusplus
 }
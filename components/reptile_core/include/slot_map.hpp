@@ -0,0 +1,195 @@
+/**
+ * @file slot_map.hpp
+ * @brief Generational id -> dense index map (Pure C++)
+ */
+
+#ifndef SLOT_MAP_HPP
+#define SLOT_MAP_HPP
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace ReptileSim {
+
+/**
+ * @brief O(1) id lookup with stale-id detection
+ *
+ * An id packs a slot number (low 24 bits) and that slot's generation (high
+ * 8 bits). Slot 0 is never handed out, so id 0 keeps meaning "none". A fresh
+ * map therefore issues 1, 2, 3... exactly like a plain counter, and ids
+ * written by older saves restore as-is.
+ *
+ * Releasing an id bumps its slot's generation, so the old id stops resolving
+ * as soon as the entity is gone, even after the slot is reused. Freed slots
+ * are recycled oldest-first to spread generations; a slot must be reused 256
+ * times before a stale id could alias again. Saves keep the free slots with
+ * their generations (freeIds() / restoreFree()), so a retired id stays
+ * retired across a reload as well.
+ */
+class SlotMap {
+public:
+    static constexpr uint32_t SLOT_BITS = 24;
+    static constexpr uint32_t SLOT_MASK = (1u << SLOT_BITS) - 1;
+    static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+
+    static uint32_t slotOf(uint32_t id) { return id & SLOT_MASK; }
+    static uint32_t generationOf(uint32_t id) { return id >> SLOT_BITS; }
+
+    /**
+     * @brief Dense index for id, or INVALID if unknown or stale
+     */
+    uint32_t find(uint32_t id) const
+    {
+        const uint32_t slot = id & SLOT_MASK;
+        if (slot == 0 || slot >= m_slots.size()) return INVALID;
+        const Slot& s = m_slots[slot];
+        return (s.generation == (id >> SLOT_BITS)) ? s.dense : INVALID;
+    }
+
+    /**
+     * @brief Issue a new id mapped to dense
+     * @return New id, or 0 if all slots are in use
+     */
+    uint32_t allocate(uint32_t dense)
+    {
+        while (!m_free.empty()) {
+            const FreeEntry entry = m_free.front();
+            m_free.pop_front();
+            Slot& s = m_slots[entry.slot];
+            if (!queued(entry)) continue; // claimed by insert() meanwhile
+            s.dense = dense;
+            return (static_cast<uint32_t>(s.generation) << SLOT_BITS) | entry.slot;
+        }
+
+        if (m_slots.empty()) m_slots.push_back({INVALID, 0, 0}); // slot 0 reserved
+        const uint32_t slot = static_cast<uint32_t>(m_slots.size());
+        if (slot > SLOT_MASK) return 0;
+        m_slots.push_back({dense, 0, 0});
+        return slot;
+    }
+
+    /**
+     * @brief Map a specific id (load path)
+     * @return false if the id is 0 or its slot is already live
+     */
+    bool insert(uint32_t id, uint32_t dense)
+    {
+        const uint32_t slot = id & SLOT_MASK;
+        if (slot == 0) return false;
+
+        if (m_slots.empty()) m_slots.push_back({INVALID, 0, 0});
+        while (m_slots.size() <= slot) {
+            // Slots skipped over by a restored id stay available
+            m_slots.push_back({INVALID, 0, 0});
+            enqueue(static_cast<uint32_t>(m_slots.size() - 1));
+        }
+
+        Slot& s = m_slots[slot];
+        if (s.dense != INVALID) return false;
+        s.dense = dense;
+        s.generation = static_cast<uint8_t>(id >> SLOT_BITS);
+        return true;
+    }
+
+    /**
+     * @brief Point a live id at a new dense index (after a swap-remove)
+     */
+    void relocate(uint32_t id, uint32_t dense)
+    {
+        m_slots[id & SLOT_MASK].dense = dense;
+    }
+
+    /**
+     * @brief Retire a live id; it will never resolve again
+     */
+    void release(uint32_t id)
+    {
+        const uint32_t slot = id & SLOT_MASK;
+        Slot& s = m_slots[slot];
+        s.dense = INVALID;
+        s.generation++;
+        enqueue(slot);
+    }
+
+    /**
+     * @brief The ids allocate() would issue from freed slots, in order
+     */
+    void freeIds(std::vector<uint32_t>& out) const
+    {
+        out.clear();
+        for (const FreeEntry& entry : m_free) {
+            if (!queued(entry)) continue;
+            out.push_back((static_cast<uint32_t>(m_slots[entry.slot].generation) << SLOT_BITS) | entry.slot);
+        }
+    }
+
+    /**
+     * @brief Replace the free slots with a freeIds() list (load path, after insert())
+     * @return false if an id is 0 or names a live slot
+     */
+    bool restoreFree(const std::vector<uint32_t>& ids)
+    {
+        if (m_slots.empty()) m_slots.push_back({INVALID, 0, 0});
+        m_free.clear();
+        const uint32_t first = m_tickets;   // Tickets above this were listed here
+        for (const uint32_t id : ids) {
+            const uint32_t slot = id & SLOT_MASK;
+            if (slot == 0) return false;
+            if (m_slots.size() <= slot) m_slots.resize(slot + 1, Slot{INVALID, 0, 0});
+            Slot& s = m_slots[slot];
+            if (s.dense != INVALID || s.ticket > first) return false;
+            s.generation = static_cast<uint8_t>(id >> SLOT_BITS);
+            enqueue(slot);
+        }
+
+        // A slot the list missed stays available at its current generation
+        for (uint32_t slot = 1; slot < m_slots.size(); slot++) {
+            const Slot& s = m_slots[slot];
+            if (s.dense == INVALID && s.ticket <= first) enqueue(slot);
+        }
+        return true;
+    }
+
+    void clear()
+    {
+        m_slots.clear();
+        m_free.clear();
+        m_tickets = 0;
+    }
+
+private:
+    struct Slot {
+        uint32_t dense;
+        uint32_t ticket;        // Of the slot's current free-list entry
+        uint8_t generation;
+    };
+
+    // A slot claimed by insert() and released again is queued anew; only
+    // the entry carrying its current ticket counts, so the free order is
+    // the same whether the slot was claimed by allocate() or by insert()
+    struct FreeEntry {
+        uint32_t slot;
+        uint32_t ticket;
+    };
+
+    std::vector<Slot> m_slots;
+    std::deque<FreeEntry> m_free;
+    uint32_t m_tickets = 0;
+
+    bool queued(const FreeEntry& entry) const
+    {
+        const Slot& s = m_slots[entry.slot];
+        return s.dense == INVALID && s.ticket == entry.ticket;
+    }
+
+    void enqueue(uint32_t slot)
+    {
+        m_slots[slot].ticket = ++m_tickets;
+        m_free.push_back({slot, m_tickets});
+    }
+};
+
+} // namespace ReptileSim
+
+#endif // SLOT_MAP_HPP
@@ -0,0 +1,150 @@
+/**
+ * @file state_view.hpp
+ * @brief Per-tick read-only view of the state for other tasks (seqlock)
+ */
+
+#ifndef STATE_VIEW_HPP
+#define STATE_VIEW_HPP
+
+#include "change_tracker.hpp"
+#include "game_state.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ReptileSim {
+
+/**
+ * @brief Globals of one published tick
+ */
+struct WorldView {
+    uint64_t version;               // Publications so far (same = nothing new)
+    uint64_t change_version;        // ChangeTracker::version() when published
+    uint64_t game_clock_ms;
+    uint32_t game_day;
+    float game_time_hours;
+    float external_temperature;
+    float external_humidity;
+    uint32_t reptile_count;
+    uint32_t terrarium_count;
+    Economy economy;
+    bool heatwave_active;
+};
+
+/**
+ * @brief One terrarium as of the last published tick
+ */
+struct TerrariumView {
+    uint32_t id;                    // 0 = no terrarium in this slot
+    uint64_t version;               // Of its last change (same = nothing to redraw)
+    float temp_hot_zone;
+    float temp_cold_zone;
+    float humidity;
+    float uv_index;
+    float waste_level;
+    float bacteria_count;
+    uint32_t occupants;
+    uint8_t equipment;              // EquipmentFlag bits
+};
+
+/**
+ * @brief One reptile as of the last published tick
+ */
+struct ReptileView {
+    uint32_t id;                    // 0 = no reptile in this slot
+    uint64_t version;               // Of its last change (same = nothing to redraw)
+    uint32_t assigned_terrarium_id;
+    float weight_grams;
+    float bone_density;
+    float hydration;
+    float stress_level;
+    float stomach_content;
+    float immune_system;
+    uint8_t flags;                  // ReptileFlag bits
+};
+
+/**
+ * @brief Immutable views of the last published tick, readable from any task
+ *
+ * The ticking task publishes; UI and other tasks read whole views without
+ * locking. Two copies sit behind a sequence counter (a seqlock "latch"):
+ * the writer bumps the counter, rewrites copy 0 while readers use copy 1,
+ * bumps it again and rewrites copy 1 while readers use copy 0. A reader
+ * copies the view out of the copy the counter points at and retries if the
+ * counter moved meanwhile, so it never sees a torn view and the writer
+ * never waits. A retry only happens when a read overlaps half a publish.
+ *
+ * Views are stored by id slot (SlotMap::slotOf), so a lookup is one
+ * indexed copy. When the herd outgrows an array the writer switches to a
+ * larger one and keeps the old one alive, because a reader may still be
+ * copying from it; growth doubles, so the retired arrays together never
+ * outweigh the live ones.
+ *
+ * Publishing costs two passes over the herd, so it only happens when a
+ * reader asked for a view since the last publish (see takeDemand()). The first
+ * read after an idle period returns the older view and the next tick
+ * publishes a fresh one.
+ */
+class StateViews {
+public:
+    /**
+     * @brief Whether anyone read a view since the last publish (clears it)
+     */
+    bool takeDemand() { return m_wanted.exchange(false, std::memory_order_relaxed); }
+
+    /**
+     * @brief Publish the state with its change versions (ticking task only)
+     */
+    void publish(const GameState& state, const ChangeTracker& changes);
+
+    /**
+     * @brief Copy a view out; false if the id was not live when published
+     */
+    bool terrarium(uint32_t id, TerrariumView& out) const;
+    bool reptile(uint32_t id, ReptileView& out) const;
+    WorldView world() const;
+
+private:
+    template <typename View>
+    struct Block {
+        uint32_t capacity;                  // Slots; fixed for the block's life
+        std::unique_ptr<View[]> views;
+    };
+
+    struct Copy {
+        WorldView world = {};
+        std::atomic<const Block<TerrariumView>*> terrariums{nullptr};
+        std::atomic<const Block<ReptileView>*> reptiles{nullptr};
+        uint32_t terrarium_slots = 0;       // Writer: slots filled last time
+        uint32_t reptile_slots = 0;
+    };
+
+    std::atomic<uint32_t> m_seq{0};
+    mutable std::atomic<bool> m_wanted{false};
+    Copy m_copies[2];
+
+    // Every block ever allocated (writer only), never freed
+    std::vector<std::unique_ptr<Block<TerrariumView>>> m_terrarium_blocks;
+    std::vector<std::unique_ptr<Block<ReptileView>>> m_reptile_blocks;
+
+    void fill(Copy& copy, const GameState& state, const ChangeTracker& changes, uint64_t version);
+
+    template <typename View>
+    Block<View>* blockFor(std::atomic<const Block<View>*>& current, uint32_t& filled, uint32_t slots,
+                          std::vector<std::unique_ptr<Block<View>>>& blocks);
+
+    template <typename View>
+    bool read(uint32_t id, View& out, std::atomic<const Block<View>*> Copy::*member) const;
+
+    void markWanted() const
+    {
+        if (!m_wanted.load(std::memory_order_relaxed)) {
+            m_wanted.store(true, std::memory_order_relaxed);
+        }
+    }
+};
+
+} // namespace ReptileSim
+
+#endif // STATE_VIEW_HPP
@@ -0,0 +1,168 @@
+/**
+ * @file telemetry_archive.hpp
+ * @brief Long-term append-only telemetry archive (SD card or any directory)
+ */
+
+#ifndef TELEMETRY_ARCHIVE_HPP
+#define TELEMETRY_ARCHIVE_HPP
+
+#include "game_state.hpp"
+#include "history.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ReptileSim {
+
+// Chunk alignment in the data files (a multiple of the SD sector size)
+constexpr size_t TELEMETRY_BLOCK_BYTES = 4096;
+
+/**
+ * @brief What is archived and how it is chunked
+ */
+struct TelemetryConfig {
+    uint32_t terrarium_slots;   // Ids whose slot is >= this are not archived (64)
+    uint32_t reptile_slots;     // (256)
+    uint32_t period_s;          // Seconds of tick() time between samples (60 = one per game hour)
+    uint32_t chunk_samples;     // Samples buffered per chunk (240)
+};
+
+/**
+ * @brief One archived sample
+ */
+struct TelemetryPoint {
+    uint64_t time_ms;           // Game clock
+    float value;
+};
+
+/**
+ * @brief Totals since open()
+ */
+struct TelemetryStats {
+    uint64_t samples;           // Sample times recorded
+    uint64_t chunks;            // Chunks written, all metrics
+    uint64_t bytes_written;     // Including alignment padding
+    uint64_t raw_bytes;         // The same values as plain floats + times
+};
+
+/**
+ * @brief Columnar archive of the HistoryChannel metrics, one file pair each
+ *
+ * Samples are buffered in RAM by id slot. A full chunk is sealed: its
+ * buffers are swapped for a second, empty set, and the SD card work is
+ * left to writeSealed() on another task, so the ticking task never waits
+ * for a dozen appends and fsyncs. Should the previous sealed chunk still
+ * be unwritten at the next seal, the ticking task writes it first. On
+ * write, each metric's chunk is written to its data file in one write,
+ * padded so every chunk starts and ends on a TELEMETRY_BLOCK_BYTES
+ * boundary, then one fixed-size entry (first/last time, offset, length)
+ * is appended to the metric's index file. The index is the sparse time
+ * index: one entry per chunk, in time order, so a range query binary
+ * searches it and reads only the chunks it overlaps.
+ *
+ * A chunk holds one timestamp column (delta-of-delta) and one column per
+ * entity (XOR floats, see compression.hpp), behind a directory sorted by
+ * id. A query reads the chunk header, the directory, the timestamps and
+ * the one column it wants.
+ *
+ * Files only grow. After a crash the index is cut back to the entries
+ * whose chunks are complete; a torn chunk is left as dead bytes. Samples
+ * older than the newest archived one (after loading an older save) are
+ * skipped, keeping the index in time order. Files use 8.3 names, so a
+ * FAT card without long file names works; on the host any directory does.
+ */
+class TelemetryArchive {
+public:
+    TelemetryArchive() = default;
+    TelemetryArchive(const TelemetryArchive&) = delete;
+    TelemetryArchive& operator=(const TelemetryArchive&) = delete;
+    ~TelemetryArchive() { close(); }
+
+    static TelemetryConfig defaultConfig();
+
+    /**
+     * @brief Open or create the archive in `dir` (created if missing)
+     */
+    bool open(const char* dir, const TelemetryConfig& config);
+
+    /**
+     * @brief Write the buffered samples and close; false if a write failed
+     */
+    bool close();
+
+    bool isOpen() const { return !m_dir.empty(); }
+
+    /**
+     * @brief Buffer a sample if a period boundary passed; seals full chunks
+     */
+    void record(const GameState& state);
+
+    /**
+     * @brief Write the sealed chunk, if any (any task; false if a write failed)
+     */
+    bool writeSealed();
+
+    /**
+     * @brief Write the sealed chunk and the buffered samples (a short chunk) now
+     */
+    bool flush();
+
+    /**
+     * @brief Archived and buffered samples of one series in [from_ms, to_ms]
+     *
+     * Appends to out, oldest first; NaN gaps (entity absent) are skipped.
+     * Waits for a writeSealed() in progress.
+     * @return false if the archive is closed or a read failed
+     */
+    bool query(HistoryChannel channel, uint32_t id, uint64_t from_ms, uint64_t to_ms,
+               std::vector<TelemetryPoint>& out) const;
+
+    TelemetryStats stats() const;       // Ticking task
+
+private:
+    // Samples of one entity kind, [channel][slot][sample]
+    struct Buffer {
+        uint32_t channels;
+        uint32_t slots;
+        std::vector<float> values;
+        std::vector<uint32_t> owner;    // [slot] id in this chunk, 0 = none
+    };
+
+    // Filled by the ticking task
+    struct Chunk {
+        Buffer terrariums;
+        Buffer reptiles;
+        std::vector<uint64_t> times;    // Of the buffered samples
+    };
+
+    std::string m_dir;
+    TelemetryConfig m_config = {};
+    Chunk m_active = {};                // Ticking task only
+    uint64_t m_period = 0;              // Of the last sample (game clock / period)
+    uint64_t m_last_ms = 0;             // Newest sample archived or buffered
+    bool m_any = false;                 // m_last_ms is set
+    uint64_t m_samples = 0;
+
+    // Under m_write_mutex: the sealed chunk (no times = none), the files
+    // and what writing them counted
+    mutable std::mutex m_write_mutex;
+    Chunk m_sealed = {};
+    bool m_failed = false;
+    TelemetryStats m_stats = {};
+
+    std::string path(HistoryChannel channel, const char* extension) const;
+    bool recover(HistoryChannel channel);
+    void seal();
+    bool writeChunk(Chunk& chunk);
+    bool writeMetric(HistoryChannel channel, const Chunk& chunk, size_t channel_index,
+                     std::vector<uint8_t>& bytes);
+    static void resetChunk(Chunk& chunk);
+    void queryBuffered(const Chunk& chunk, bool is_terrarium, size_t channel_index, uint32_t id,
+                       uint64_t from_ms, uint64_t to_ms, std::vector<TelemetryPoint>& out) const;
+};
+
+} // namespace ReptileSim
+
+#endif // TELEMETRY_ARCHIVE_HPP
@@ -0,0 +1,85 @@
+/**
+ * @file worker_pool.hpp
+ * @brief Fixed worker pool for data-parallel ticks
+ */
+
+#ifndef WORKER_POOL_HPP
+#define WORKER_POOL_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ReptileSim {
+
+/**
+ * @brief Runs numbered chunks of one job on all workers plus the caller
+ *
+ * Chunks are dealt out as contiguous ranges, one per participant. Each
+ * participant claims chunks from the front of its own range and, once that is
+ * empty, steals from the other ranges; claims are a single atomic increment,
+ * so every chunk runs exactly once. Which thread runs a chunk is arbitrary:
+ * jobs must keep each chunk's writes disjoint and reduce any totals per chunk.
+ *
+ * Workers are std::threads on the host and FreeRTOS tasks pinned to the
+ * other cores on device (ESP_PLATFORM).
+ */
+class WorkerPool {
+public:
+    using ChunkFn = void (*)(void* job, uint32_t chunk);
+
+    WorkerPool();
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Start (or restart with) this many background workers
+     *
+     * The caller of run() always takes part, so 0 runs everything inline.
+     * On device, workers whose task cannot be created are left out;
+     * workerCount() reports how many started.
+     */
+    void start(unsigned workers);
+    void stop();
+
+    unsigned workerCount() const { return static_cast<unsigned>(m_workers.size()); }
+
+    /**
+     * @brief Run fn(job, c) for every c in [0, chunk_count), blocks until done
+     */
+    void run(uint32_t chunk_count, ChunkFn fn, void* job);
+
+    /**
+     * @brief Default worker count for this machine (cores - 1)
+     */
+    static unsigned defaultWorkers();
+
+private:
+    // One claim range per participant, on its own cache line
+    struct alignas(64) Range {
+        std::atomic<uint32_t> next;
+        uint32_t end;
+    };
+
+    struct Worker;      // Thread or task handle (platform specific)
+    struct Signals;     // Wake-up / completion primitives
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::unique_ptr<Signals> m_signals;
+    std::unique_ptr<Range[]> m_ranges;  // [0] = caller, [1 + k] = worker k
+
+    // Current job (published before workers are woken)
+    ChunkFn m_fn = nullptr;
+    void* m_job = nullptr;
+
+    void participate(unsigned self);
+    void workerMain(unsigned self);
+    static void workerEntry(void* arg);     // FreeRTOS task entry
+};
+
+} // namespace ReptileSim
+
+#endif // WORKER_POOL_HPP
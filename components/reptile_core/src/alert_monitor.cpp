@@ -0,0 +1,249 @@
+/**
+ * @file alert_monitor.cpp
+ * @brief Edge-triggered alert rules and the SPSC event queue
+ */
+
+#include "../include/alert_monitor.hpp"
+#include "../include/slot_map.hpp"
+
+namespace ReptileSim {
+
+namespace {
+
+constexpr uint8_t bit(AlertKind kind)
+{
+    return static_cast<uint8_t>(1u << static_cast<unsigned>(kind));
+}
+
+// Latch bit above the rules: the reptile is on the retry list
+constexpr uint8_t PENDING = 0x80;
+static_assert(static_cast<unsigned>(AlertKind::Count) < 8, "rules and PENDING share a byte");
+
+// Latched "above" rule: raised past `on`, held until back to `off` or below
+inline bool above(bool active, float value, float on, float off)
+{
+    return active ? value > off : value > on;
+}
+
+} // namespace
+
+AlertSeverity alertSeverity(AlertKind kind)
+{
+    switch (kind) {
+        case AlertKind::TempHigh:
+        case AlertKind::Sick:
+            return AlertSeverity::Critical;
+        case AlertKind::Hungry:
+            return AlertSeverity::Info;
+        default:
+            return AlertSeverity::Warning;
+    }
+}
+
+// ====================================================================================
+// QUEUE
+// ====================================================================================
+
+bool AlertQueue::push(const AlertEvent& event)
+{
+    const uint32_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_tail.load(std::memory_order_acquire) >= ALERT_QUEUE_CAPACITY) {
+        m_rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    m_events[head & (ALERT_QUEUE_CAPACITY - 1)] = event;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool AlertQueue::pop(AlertEvent& out)
+{
+    const uint32_t tail = m_tail.load(std::memory_order_relaxed);
+    if (tail == m_head.load(std::memory_order_acquire)) return false;
+    out = m_events[tail & (ALERT_QUEUE_CAPACITY - 1)];
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+// ====================================================================================
+// MONITOR
+// ====================================================================================
+
+AlertRules AlertMonitor::defaultRules()
+{
+    AlertRules rules;
+    rules.temp_high = 38.0f;
+    rules.temp_low = 20.0f;
+    rules.temp_band = 1.0f;
+    rules.waste_high = 80.0f;
+    rules.stress_high = 80.0f;
+    rules.percent_band = 10.0f;
+    return rules;
+}
+
+void AlertMonitor::setRules(const AlertRules& rules)
+{
+    m_rules = rules;
+    m_rescan = true;
+}
+
+void AlertMonitor::reset()
+{
+    m_terrariums.clear();
+    m_reptiles.clear();
+    m_touched.clear();
+    m_deferred.clear();
+    m_rescan = true;
+}
+
+bool AlertMonitor::takeRescan()
+{
+    const bool rescan = m_rescan;
+    m_rescan = false;
+    return rescan;
+}
+
+uint8_t& AlertMonitor::latchOf(Latches& latches, uint32_t id)
+{
+    const uint32_t slot = SlotMap::slotOf(id);
+    if (slot >= latches.size()) {
+        latches.resize(slot + 1, Latch{0, 0});
+    }
+    Latch& latch = latches[slot];
+    if (latch.owner != id) {
+        latch.owner = id;
+        latch.bits = 0;
+    }
+    return latch.bits;
+}
+
+// Queue one event per flipped bit; returns the latch with the queued flips applied
+uint8_t AlertMonitor::emit(uint8_t before, uint8_t after, uint32_t id, const float* values, uint64_t now_ms)
+{
+    const uint8_t flipped = before ^ after;
+    uint8_t latched = before;
+    if (m_queue.full()) return latched;     // Not worth a refused push per edge
+
+    for (unsigned k = 0; k < static_cast<unsigned>(AlertKind::Count); k++) {
+        const AlertKind kind = static_cast<AlertKind>(k);
+        if (!(flipped & bit(kind))) continue;
+
+        AlertEvent event;
+        event.game_clock_ms = now_ms;
+        event.entity_id = id;
+        event.value = values[k];
+        event.kind = kind;
+        event.severity = alertSeverity(kind);
+        event.raised = (after & bit(kind)) != 0;
+        if (!m_queue.push(event)) break;
+        latched ^= bit(kind);
+    }
+    return latched;
+}
+
+// Off the retry list; evaluateReptile() puts it back if its edge is refused again
+void AlertMonitor::unmark(uint32_t reptile_id)
+{
+    const uint32_t slot = SlotMap::slotOf(reptile_id);
+    if (slot < m_reptiles.size() && m_reptiles[slot].owner == reptile_id) {
+        m_reptiles[slot].bits &= static_cast<uint8_t>(~PENDING);
+    }
+}
+
+void AlertMonitor::endPass()
+{
+    // Refused edges are retried with the next tick
+    m_touched.swap(m_deferred);
+    m_deferred.clear();
+}
+
+void AlertMonitor::evaluateTerrariums(const TerrariumStore& terrariums, uint64_t now_ms)
+{
+    const AlertRules& r = m_rules;
+    const size_t count = terrariums.size();
+
+    for (size_t i = 0; i < count; i++) {
+        const float temp = terrariums.temp_hot_zone[i];
+        const float waste = terrariums.waste_level[i];
+        uint8_t& latched = latchOf(m_terrariums, terrariums.id[i]);
+
+        uint8_t now = 0;
+        if (above(latched & bit(AlertKind::TempHigh), temp, r.temp_high, r.temp_high - r.temp_band)) {
+            now |= bit(AlertKind::TempHigh);
+        }
+        if (above(latched & bit(AlertKind::TempLow), -temp, -r.temp_low, -(r.temp_low + r.temp_band))) {
+            now |= bit(AlertKind::TempLow);
+        }
+        if (above(latched & bit(AlertKind::WasteHigh), waste, r.waste_high, r.waste_high - r.percent_band)) {
+            now |= bit(AlertKind::WasteHigh);
+        }
+        if (now == latched) continue;
+
+        // Every terrarium is evaluated every tick, so a refused edge needs no retry list
+        const float values[static_cast<size_t>(AlertKind::Count)] = {temp, temp, waste, 0.0f, 0.0f, 0.0f};
+        latched = emit(latched, now, terrariums.id[i], values, now_ms);
+    }
+}
+
+void AlertMonitor::evaluateReptile(const ReptileStore& reptiles, size_t i, uint64_t now_ms)
+{
+    const AlertRules& r = m_rules;
+    const float stress = reptiles.stress_level[i];
+    const bool sick = !reptiles.hasFlag(i, REPTILE_FLAG_HEALTHY);
+    const bool hungry = reptiles.hasFlag(i, REPTILE_FLAG_HUNGRY);
+    uint8_t& latched = latchOf(m_reptiles, reptiles.id[i]);
+    const uint8_t held = latched & static_cast<uint8_t>(~PENDING);
+
+    // The flags carry the biology engine's own thresholds; no band on top
+    uint8_t now = 0;
+    if (sick) now |= bit(AlertKind::Sick);
+    if (above(held & bit(AlertKind::StressHigh), stress, r.stress_high, r.stress_high - r.percent_band)) {
+        now |= bit(AlertKind::StressHigh);
+    }
+    if (hungry) now |= bit(AlertKind::Hungry);
+    if (now == held) return;
+
+    const float values[static_cast<size_t>(AlertKind::Count)] = {
+        0.0f, 0.0f, 0.0f, sick ? 1.0f : 0.0f, stress, hungry ? 1.0f : 0.0f};
+    const uint8_t sent = emit(held, now, reptiles.id[i], values, now_ms);
+    if (sent == now) {
+        latched = sent | (latched & PENDING);
+    } else if (latched & PENDING) {
+        latched = sent | PENDING;
+    } else {
+        latched = sent | PENDING;
+        m_deferred.push_back(reptiles.id[i]);
+    }
+}
+
+void AlertMonitor::evaluateReptiles(const ReptileStore& reptiles, uint64_t now_ms)
+{
+    for (const uint32_t id : m_touched) {
+        unmark(id);
+    }
+    m_touched.clear();
+
+    const size_t count = reptiles.size();
+    for (size_t i = 0; i < count; i++) {
+        evaluateReptile(reptiles, i, now_ms);
+    }
+    endPass();
+}
+
+void AlertMonitor::evaluateTouched(const ReptileStore& reptiles, uint64_t now_ms)
+{
+    // A reptile already judged this pass while marked is judged again here.
+    // Once the queue is full the rest wait, still marked, for the next tick.
+    for (size_t n = 0; n < m_touched.size(); n++) {
+        if (m_queue.full()) {
+            m_deferred.insert(m_deferred.end(), m_touched.begin() + n, m_touched.end());
+            break;
+        }
+        unmark(m_touched[n]);
+        const size_t i = reptiles.indexOf(m_touched[n]);
+        if (i != ReptileStore::npos) evaluateReptile(reptiles, i, now_ms);
+    }
+    endPass();
+}
+
+} // namespace ReptileSim
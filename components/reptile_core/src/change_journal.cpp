@@ -0,0 +1,297 @@
+/**
+ * @file change_journal.cpp
+ * @brief Append-only log of everything applied since the last snapshot
+ */
+
+#include "../include/change_journal.hpp"
+#include "crc32.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+namespace ReptileSim {
+
+// Largest journal replay reads into RAM; compaction keeps real ones far below
+static constexpr long MAX_JOURNAL_BYTES = 64L * 1024 * 1024;
+
+// Write and flush to the storage device (fsync, not just the stdio buffer)
+static bool writeDurable(FILE* f, const void* data, size_t length)
+{
+    bool ok = (length == 0 || fwrite(data, 1, length, f) == length);
+    ok = ok && fflush(f) == 0 && fsync(fileno(f)) == 0;
+    return (fclose(f) == 0) && ok;
+}
+
+// ====================================================================================
+// WRITER
+// ====================================================================================
+
+void ChangeJournal::cut(const char* path, uint64_t generation, uint64_t base_clock_ms)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_path.empty()) {
+        // Reopen after a failure: nothing before the cut has a file to go to
+        m_path = path;
+        m_file_valid = false;
+        m_pending.clear();
+        m_stats = {};
+    }
+    m_cut = m_pending.size();
+    m_cut_generation = generation;
+    m_cut_clock_ms = base_clock_ms;
+    m_cut_records = m_stats.records;
+    m_cut_ticks = m_stats.ticks;
+
+    // Ticks after the cut must not be folded into a record before it
+    m_last_ticks = SIZE_MAX;
+}
+
+bool ChangeJournal::commitCut()
+{
+    std::lock_guard<std::mutex> file_lock(m_file_mutex);
+
+    JournalHeader header = {};
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_path.empty() || m_cut == SIZE_MAX) return false;
+        memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+        header.version = JOURNAL_VERSION;
+        header.generation = m_cut_generation;
+        header.base_clock_ms = m_cut_clock_ms;
+        header.header_crc = crc32(&header.generation, sizeof(header) - offsetof(JournalHeader, generation));
+        path = m_path;
+    }
+
+    // Only flush() and commitCut() write, both under m_file_mutex
+    FILE* f = fopen(path.c_str(), "wb");
+    const bool ok = f && writeDurable(f, &header, sizeof(header));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!ok) {
+        closeLocked();
+        return false;
+    }
+    dropFront(m_cut);
+    m_cut = SIZE_MAX;
+    m_file_valid = true;
+    m_stats.generation = header.generation;
+    m_stats.file_bytes = sizeof(header);
+    m_stats.records -= m_cut_records;
+    m_stats.ticks -= m_cut_ticks;
+    return true;
+}
+
+void ChangeJournal::cancelCut()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cut = SIZE_MAX;
+    if (!m_file_valid) {
+        closeLocked();
+    }
+}
+
+void ChangeJournal::resume(const char* path, uint64_t generation, uint64_t file_bytes, uint32_t records, uint64_t ticks)
+{
+    std::lock_guard<std::mutex> file_lock(m_file_mutex);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    closeLocked();
+    m_path = path;
+    m_file_valid = true;
+    m_stats.generation = generation;
+    m_stats.file_bytes = file_bytes;
+    m_stats.records = records;
+    m_stats.ticks = ticks;
+}
+
+void ChangeJournal::close()
+{
+    std::lock_guard<std::mutex> file_lock(m_file_mutex);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    closeLocked();
+}
+
+bool ChangeJournal::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_path.empty();
+}
+
+void ChangeJournal::closeLocked()
+{
+    m_path.clear();
+    m_file_valid = false;
+    m_pending.clear();
+    m_last_ticks = SIZE_MAX;
+    m_cut = SIZE_MAX;
+    m_stats = {};
+}
+
+void ChangeJournal::dropFront(size_t bytes)
+{
+    m_pending.erase(m_pending.begin(), m_pending.begin() + bytes);
+    if (m_last_ticks != SIZE_MAX) {
+        m_last_ticks = (m_last_ticks >= bytes) ? m_last_ticks - bytes : SIZE_MAX;
+    }
+    if (m_cut != SIZE_MAX) {
+        m_cut -= bytes;
+    }
+}
+
+void ChangeJournal::seal(uint8_t* record)
+{
+    JournalRecordHeader header;
+    memcpy(&header, record, sizeof(header));
+    uint32_t crc = crc32(record, offsetof(JournalRecordHeader, crc));
+    header.crc = crc32(record + sizeof(header), header.length, crc);
+    memcpy(record, &header, sizeof(header));
+}
+
+void ChangeJournal::ticks(uint32_t steps, float dt)
+{
+    if (steps == 0) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_path.empty()) return;
+    m_stats.ticks += steps;
+
+    // A running game records one Ticks record per flush, not per tick
+    if (m_last_ticks != SIZE_MAX) {
+        uint8_t* record = m_pending.data() + m_last_ticks;
+        JournalTicks last;
+        memcpy(&last, record + sizeof(JournalRecordHeader), sizeof(last));
+        if (last.dt == dt && last.steps <= UINT32_MAX - steps) {
+            last.steps += steps;
+            memcpy(record + sizeof(JournalRecordHeader), &last, sizeof(last));
+            seal(record);
+            return;
+        }
+    }
+
+    const JournalTicks payload = {steps, dt};
+    m_last_ticks = m_pending.size();
+    JournalRecordHeader header = {static_cast<uint16_t>(JournalOp::Ticks), 0, sizeof(payload), 0};
+    const uint8_t* h = reinterpret_cast<const uint8_t*>(&header);
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&payload);
+    m_pending.insert(m_pending.end(), h, h + sizeof(header));
+    m_pending.insert(m_pending.end(), p, p + sizeof(payload));
+    seal(m_pending.data() + m_last_ticks);
+    m_stats.records++;
+}
+
+void ChangeJournal::record(JournalOp op, const void* payload, size_t length, const void* extra, size_t extra_length)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_path.empty()) return;
+
+    const size_t at = m_pending.size();
+    JournalRecordHeader header = {static_cast<uint16_t>(op), 0, static_cast<uint32_t>(length + extra_length), 0};
+    const uint8_t* h = reinterpret_cast<const uint8_t*>(&header);
+    const uint8_t* p = static_cast<const uint8_t*>(payload);
+    m_pending.insert(m_pending.end(), h, h + sizeof(header));
+    m_pending.insert(m_pending.end(), p, p + length);
+    if (extra_length > 0) {
+        const uint8_t* e = static_cast<const uint8_t*>(extra);
+        m_pending.insert(m_pending.end(), e, e + extra_length);
+    }
+    seal(m_pending.data() + at);
+
+    // Ticks after an action must not be folded into the record before it
+    m_last_ticks = SIZE_MAX;
+    m_stats.records++;
+}
+
+bool ChangeJournal::flush()
+{
+    std::lock_guard<std::mutex> file_lock(m_file_mutex);
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_path.empty()) return false;
+
+        // Records after a pending cut wait for their snapshot
+        const size_t bytes = (m_cut != SIZE_MAX) ? m_cut : m_pending.size();
+        if (bytes == 0 || !m_file_valid) return true;
+        m_writing.assign(m_pending.begin(), m_pending.begin() + bytes);
+        dropFront(bytes);
+        path = m_path;
+    }
+
+    FILE* f = fopen(path.c_str(), "ab");
+    const bool ok = f && writeDurable(f, m_writing.data(), m_writing.size());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (ok) {
+        m_stats.file_bytes += m_writing.size();
+        m_stats.flushes++;
+    } else {
+        closeLocked();
+    }
+    m_writing.clear();
+    return ok;
+}
+
+ChangeJournal::Stats ChangeJournal::stats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats s = m_stats;
+    s.pending_bytes = static_cast<uint32_t>(m_pending.size());
+    return s;
+}
+
+// ====================================================================================
+// READER
+// ====================================================================================
+
+bool JournalReader::open(const char* path)
+{
+    m_data.clear();
+    m_pos = 0;
+
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    bool ok = fseek(f, 0, SEEK_END) == 0;
+    const long size = ok ? ftell(f) : -1;
+    ok = ok && size >= static_cast<long>(sizeof(JournalHeader)) && size <= MAX_JOURNAL_BYTES &&
+         fseek(f, 0, SEEK_SET) == 0;
+    if (ok) {
+        m_data.resize(static_cast<size_t>(size));
+        ok = fread(m_data.data(), 1, m_data.size(), f) == m_data.size();
+    }
+    fclose(f);
+    if (!ok) return false;
+
+    memcpy(&m_header, m_data.data(), sizeof(m_header));
+    if (memcmp(m_header.magic, JOURNAL_MAGIC, sizeof(m_header.magic)) != 0) return false;
+    if (m_header.version == 0 || m_header.version > JOURNAL_VERSION) return false;
+    if (m_header.header_crc !=
+        crc32(&m_header.generation, sizeof(m_header) - offsetof(JournalHeader, generation))) {
+        return false;
+    }
+    m_pos = sizeof(m_header);
+    return true;
+}
+
+bool JournalReader::next(JournalOp& op, const uint8_t*& payload, uint32_t& length)
+{
+    const size_t left = m_data.size() - m_pos;
+    if (left < sizeof(JournalRecordHeader)) return false;
+
+    JournalRecordHeader header;
+    const uint8_t* record = m_data.data() + m_pos;
+    memcpy(&header, record, sizeof(header));
+    if (header.length > left - sizeof(header)) return false;
+
+    const uint32_t crc = crc32(record + sizeof(header), header.length,
+                               crc32(record, offsetof(JournalRecordHeader, crc)));
+    if (crc != header.crc) return false;
+
+    op = static_cast<JournalOp>(header.op);
+    payload = record + sizeof(header);
+    length = header.length;
+    m_pos += sizeof(header) + header.length;
+    return true;
+}
+
+} // namespace ReptileSim
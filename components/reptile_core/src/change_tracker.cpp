@@ -0,0 +1,350 @@
+/**
+ * @file change_tracker.cpp
+ * @brief Per-entity change versions and the change log
+ */
+
+#include "../include/change_tracker.hpp"
+#include "../include/slot_map.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ReptileSim {
+
+namespace {
+
+// Flags a consumer sees; ASLEEP is the engine's own business
+constexpr uint8_t STATUS_FLAGS = REPTILE_FLAG_HEALTHY | REPTILE_FLAG_HUNGRY | REPTILE_FLAG_SHEDDING;
+
+// Multiples of an epsilon per unit; 1/0.1 is snapped to 10 so the products
+// below are exact enough to round the way printf rounds the value itself
+float scaleOf(float epsilon)
+{
+    if (!(epsilon > 0.0f)) return 0.0f;
+    const float scale = 1.0f / epsilon;
+    const float whole = std::nearbyint(scale);
+    return (std::fabs(scale - whole) <= whole * 1e-5f) ? whole : scale;
+}
+
+// Nearest integer, ties to even: adding 1.5 * 2^23 rounds off the fraction
+// (no libcall where there is no rounding instruction); larger floats are
+// whole already
+inline float nearestWhole(float x)
+{
+    constexpr float ROUNDER = 12582912.0f;
+    return (std::fabs(x) < 4194304.0f) ? (x + ROUNDER) - ROUNDER : x;
+}
+
+// Nearest multiple of the epsilon (in epsilons), ties to even
+inline float multipleOf(float value, float scale)
+{
+    const float product = value * scale;
+    const float multiple = nearestWhole(product);
+    const float off = product - multiple;
+    if (std::fabs(off) != 0.5f) return multiple;
+
+    // The product rounded onto a tie; the exact one is on one side of it
+    const float error = std::fma(value, scale, -product);
+    if (off > 0.0f && error > 0.0f) return multiple + 1.0f;
+    if (off < 0.0f && error < 0.0f) return multiple - 1.0f;
+    return multiple;
+}
+
+inline bool moved(float value, float baseline, float scale)
+{
+    if (value == baseline) return false;
+    if (scale == 0.0f) return true;
+    return multipleOf(value, scale) != multipleOf(baseline, scale);
+}
+
+// Track of a slot, grown with its versions on demand (owner 0 = free)
+template <typename Track>
+Track& trackOf(std::vector<Track>& tracks, std::vector<uint64_t>& versions, size_t groups, uint32_t slot)
+{
+    if (slot >= tracks.size()) {
+        tracks.resize(slot + 1, Track{});
+        versions.resize(tracks.size() * groups, 0);
+    }
+    return tracks[slot];
+}
+
+uint64_t newest(const uint64_t* versions, size_t count, uint8_t groups)
+{
+    uint64_t version = 0;
+    for (size_t g = 0; g < count; g++) {
+        if (groups & (1u << g)) version = std::max(version, versions[g]);
+    }
+    return version;
+}
+
+} // namespace
+
+ChangeEpsilons ChangeTracker::defaultEpsilons()
+{
+    ChangeEpsilons epsilons;
+    epsilons.temperature = 0.1f;
+    epsilons.level = 0.1f;
+    epsilons.weight = 0.1f;
+    return epsilons;
+}
+
+ChangeTracker::Scales ChangeTracker::scalesOf(const ChangeEpsilons& epsilons)
+{
+    return {scaleOf(epsilons.temperature), scaleOf(epsilons.level), scaleOf(epsilons.weight)};
+}
+
+void ChangeTracker::setEpsilons(const ChangeEpsilons& epsilons)
+{
+    m_epsilons = epsilons;
+    m_scales = scalesOf(epsilons);
+    m_rescan = true;
+}
+
+void ChangeTracker::reset()
+{
+    m_terrariums.clear();
+    m_reptiles.clear();
+    m_terrarium_versions.clear();
+    m_reptile_versions.clear();
+    m_log.clear();
+    m_removed.clear();
+    m_touched.clear();
+    m_version++;
+    m_floor = m_version;
+    m_log_limit = LOG_COMPACT_MIN;
+    m_changed = false;
+    m_rescan = true;
+}
+
+bool ChangeTracker::takeRescan()
+{
+    const bool rescan = m_rescan;
+    m_rescan = false;
+    return rescan;
+}
+
+// ====================================================================================
+// TRACKING
+// ====================================================================================
+
+// Move `groups` to this pass's version; the entity is logged once per version
+void ChangeTracker::stamp(uint64_t* versions, size_t count, uint8_t groups, Kind kind, uint32_t id)
+{
+    const uint64_t version = m_version + 1;
+    const bool logged = newest(versions, count, 0xFF) == version;
+    for (size_t g = 0; g < count; g++) {
+        if (groups & (1u << g)) versions[g] = version;
+    }
+    if (!logged) m_log.push_back(LogEntry{version, id, kind});
+    m_changed = true;
+}
+
+void ChangeTracker::logRemoval(Kind kind, uint32_t id)
+{
+    // Removals happen between passes and take a version of their own
+    m_version++;
+    m_removed.push_back(LogEntry{m_version, id, kind});
+
+    if (m_removed.size() > CHANGE_REMOVED_LOG) {
+        const size_t drop = m_removed.size() - CHANGE_REMOVED_LOG / 2;
+        m_floor = std::max(m_floor, m_removed[drop - 1].version);
+        m_removed.erase(m_removed.begin(), m_removed.begin() + drop);
+    }
+}
+
+void ChangeTracker::removedTerrarium(uint32_t id)
+{
+    const uint32_t slot = SlotMap::slotOf(id);
+    if (slot < m_terrariums.size() && m_terrariums[slot].owner == id) {
+        m_terrariums[slot].owner = 0;
+    }
+    logRemoval(Kind::Terrarium, id);
+}
+
+void ChangeTracker::removedReptile(uint32_t id)
+{
+    const uint32_t slot = SlotMap::slotOf(id);
+    if (slot < m_reptiles.size() && m_reptiles[slot].owner == id) {
+        m_reptiles[slot].owner = 0;
+    }
+    logRemoval(Kind::Reptile, id);
+}
+
+void ChangeTracker::beginPass()
+{
+    m_changed = false;
+}
+
+void ChangeTracker::trackTerrariums(const TerrariumStore& terrariums)
+{
+    const Scales& e = m_scales;
+    const size_t count = terrariums.size();
+
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t id = terrariums.id[i];
+        const uint32_t slot = SlotMap::slotOf(id);
+        TerrariumTrack& t = trackOf(m_terrariums, m_terrarium_versions, TERRARIUM_GROUPS, slot);
+        const float climate[4] = {terrariums.temp_hot_zone[i], terrariums.temp_cold_zone[i],
+                                  terrariums.humidity[i], terrariums.uv_index[i]};
+        const float hygiene[2] = {terrariums.waste_level[i], terrariums.bacteria_count[i]};
+        const uint8_t equipment = terrariums.equipment[i];
+
+        uint8_t groups = 0;
+        if (t.owner != id) {
+            t.owner = id;
+            groups = TERRARIUM_FIELDS_ALL;
+        } else {
+            if (moved(climate[0], t.climate[0], e.temperature) || moved(climate[1], t.climate[1], e.temperature) ||
+                moved(climate[2], t.climate[2], e.level) || moved(climate[3], t.climate[3], e.level)) {
+                groups |= TERRARIUM_FIELDS_CLIMATE;
+            }
+            if (moved(hygiene[0], t.hygiene[0], e.level) || moved(hygiene[1], t.hygiene[1], e.level)) {
+                groups |= TERRARIUM_FIELDS_HYGIENE;
+            }
+            if (equipment != t.equipment) groups |= TERRARIUM_FIELDS_EQUIPMENT;
+            if (!groups) continue;
+        }
+
+        if (groups & TERRARIUM_FIELDS_CLIMATE) std::copy(climate, climate + 4, t.climate);
+        if (groups & TERRARIUM_FIELDS_HYGIENE) std::copy(hygiene, hygiene + 2, t.hygiene);
+        if (groups & TERRARIUM_FIELDS_EQUIPMENT) t.equipment = equipment;
+        stamp(&m_terrarium_versions[slot * TERRARIUM_GROUPS], TERRARIUM_GROUPS, groups, Kind::Terrarium, id);
+    }
+}
+
+void ChangeTracker::trackReptile(const ReptileStore& reptiles, size_t i)
+{
+    const Scales& e = m_scales;
+    const uint32_t id = reptiles.id[i];
+    const uint32_t slot = SlotMap::slotOf(id);
+    ReptileTrack& t = trackOf(m_reptiles, m_reptile_versions, REPTILE_GROUPS, slot);
+    const float body[3] = {reptiles.weight_grams[i], reptiles.bone_density[i], reptiles.hydration[i]};
+    const float condition[3] = {reptiles.stress_level[i], reptiles.stomach_content[i], reptiles.immune_system[i]};
+    const uint8_t status = reptiles.flags[i] & STATUS_FLAGS;
+    const uint32_t terrarium_id = reptiles.assigned_terrarium_id[i];
+
+    uint8_t groups = 0;
+    if (t.owner != id) {
+        t.owner = id;
+        groups = REPTILE_FIELDS_ALL;
+    } else {
+        if (moved(body[0], t.body[0], e.weight) || moved(body[1], t.body[1], e.level) ||
+            moved(body[2], t.body[2], e.level)) {
+            groups |= REPTILE_FIELDS_BODY;
+        }
+        if (moved(condition[0], t.condition[0], e.level) || moved(condition[1], t.condition[1], e.level) ||
+            moved(condition[2], t.condition[2], e.level)) {
+            groups |= REPTILE_FIELDS_CONDITION;
+        }
+        if (status != t.status) groups |= REPTILE_FIELDS_STATUS;
+        if (terrarium_id != t.terrarium_id) groups |= REPTILE_FIELDS_PLACEMENT;
+        if (!groups) return;
+    }
+
+    if (groups & REPTILE_FIELDS_BODY) std::copy(body, body + 3, t.body);
+    if (groups & REPTILE_FIELDS_CONDITION) std::copy(condition, condition + 3, t.condition);
+    if (groups & REPTILE_FIELDS_STATUS) t.status = status;
+    if (groups & REPTILE_FIELDS_PLACEMENT) t.terrarium_id = terrarium_id;
+    stamp(&m_reptile_versions[slot * REPTILE_GROUPS], REPTILE_GROUPS, groups, Kind::Reptile, id);
+}
+
+void ChangeTracker::trackReptiles(const ReptileStore& reptiles)
+{
+    m_touched.clear();
+    const size_t count = reptiles.size();
+    for (size_t i = 0; i < count; i++) {
+        trackReptile(reptiles, i);
+    }
+}
+
+void ChangeTracker::trackTouched(const ReptileStore& reptiles)
+{
+    for (const uint32_t id : m_touched) {
+        const size_t i = reptiles.indexOf(id);
+        if (i != ReptileStore::npos) trackReptile(reptiles, i);
+    }
+    m_touched.clear();
+}
+
+void ChangeTracker::endPass()
+{
+    if (m_changed) {
+        m_version++;
+        m_changed = false;
+    }
+    if (m_log.size() > m_log_limit) compact();
+}
+
+// ====================================================================================
+// LOG
+// ====================================================================================
+
+// Group versions of `id`, or null if it is not tracked
+const uint64_t* ChangeTracker::versionsOf(Kind kind, uint32_t id) const
+{
+    const uint32_t slot = SlotMap::slotOf(id);
+    if (kind == Kind::Terrarium) {
+        if (slot >= m_terrariums.size() || m_terrariums[slot].owner != id) return nullptr;
+        return &m_terrarium_versions[slot * TERRARIUM_GROUPS];
+    }
+    if (slot >= m_reptiles.size() || m_reptiles[slot].owner != id) return nullptr;
+    return &m_reptile_versions[slot * REPTILE_GROUPS];
+}
+
+uint64_t ChangeTracker::entryVersion(const LogEntry& entry, uint8_t groups) const
+{
+    const uint64_t* versions = versionsOf(entry.kind, entry.id);
+    const size_t count = (entry.kind == Kind::Terrarium) ? TERRARIUM_GROUPS : REPTILE_GROUPS;
+    return versions ? newest(versions, count, groups) : 0;
+}
+
+// Some group of the entity still has this entry's version
+bool ChangeTracker::live(const LogEntry& entry) const
+{
+    const uint64_t* versions = versionsOf(entry.kind, entry.id);
+    const size_t count = (entry.kind == Kind::Terrarium) ? TERRARIUM_GROUPS : REPTILE_GROUPS;
+    return versions && std::find(versions, versions + count, entry.version) != versions + count;
+}
+
+void ChangeTracker::compact()
+{
+    m_log.erase(std::remove_if(m_log.begin(), m_log.end(),
+                               [this](const LogEntry& entry) { return !live(entry); }),
+                m_log.end());
+    m_log_limit = std::max(LOG_COMPACT_MIN, m_log.size() * 2);
+}
+
+uint64_t ChangeTracker::terrariumVersion(uint32_t id, uint8_t groups) const
+{
+    return entryVersion(LogEntry{0, id, Kind::Terrarium}, groups);
+}
+
+uint64_t ChangeTracker::reptileVersion(uint32_t id, uint8_t groups) const
+{
+    return entryVersion(LogEntry{0, id, Kind::Reptile}, groups);
+}
+
+void ChangeTracker::changedSince(uint64_t since, ChangeSet& out, uint8_t terrarium_groups,
+                                 uint8_t reptile_groups) const
+{
+    out.version = m_version;
+    out.complete = since >= m_floor;
+    out.terrariums.clear();
+    out.reptiles.clear();
+    out.removed_terrariums.clear();
+    out.removed_reptiles.clear();
+
+    const auto older = [](const LogEntry& entry, uint64_t version) { return entry.version <= version; };
+
+    // An entity is listed at the newest version of the requested groups only
+    for (auto it = std::lower_bound(m_log.begin(), m_log.end(), since, older); it != m_log.end(); ++it) {
+        const bool terrarium = it->kind == Kind::Terrarium;
+        if (entryVersion(*it, terrarium ? terrarium_groups : reptile_groups) != it->version) continue;
+        (terrarium ? out.terrariums : out.reptiles).push_back(it->id);
+    }
+
+    for (auto it = std::lower_bound(m_removed.begin(), m_removed.end(), since, older); it != m_removed.end(); ++it) {
+        (it->kind == Kind::Terrarium ? out.removed_terrariums : out.removed_reptiles).push_back(it->id);
+    }
+}
+
+} // namespace ReptileSim
@@ -0,0 +1,538 @@
+/**
+ * @file compression.cpp
+ * @brief Block compression for saves and archives (filters + LZ codec)
+ */
+
+#include "compression.hpp"
+#include <algorithm>
+#include <cstring>
+
+// Matches are compared and filters applied on little-endian words
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "block filters assume little-endian values"
+#endif
+
+namespace ReptileSim {
+
+namespace {
+
+// LZ sequence format: token (literal length << 4 | match length - 4, 15 =
+// more length bytes follow), literals, 16-bit offset, match length bytes.
+// The last sequence has literals only and ends the input.
+constexpr size_t LZ_MIN_MATCH = 4;
+constexpr size_t LZ_MAX_OFFSET = 65535;
+constexpr uint32_t LZ_HASH_BITS = 13;       // 32 KB match table per block
+constexpr uint32_t LZ_SKIP_SHIFT = 6;       // Step up after 64 misses in a row
+
+// Blocks saving less than 1/8 are left raw: decoding them would cost more
+// load time than reading the difference
+constexpr size_t MIN_GAIN_DIVISOR = 8;
+
+inline uint32_t read32(const uint8_t* p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t hash4(uint32_t v)
+{
+    return (v * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+uint8_t* writeLength(uint8_t* op, size_t length)
+{
+    while (length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = static_cast<uint8_t>(length);
+    return op;
+}
+
+bool readLength(const uint8_t*& ip, const uint8_t* iend, size_t& length)
+{
+    uint8_t b;
+    do {
+        if (ip >= iend) return false;
+        b = *ip++;
+        length += b;
+    } while (b == 255);
+    return true;
+}
+
+uint8_t* writeLiterals(uint8_t* op, uint8_t match_nibble, const uint8_t* literals, size_t count)
+{
+    *op++ = static_cast<uint8_t>((std::min<size_t>(count, 15) << 4) | match_nibble);
+    if (count >= 15) op = writeLength(op, count - 15);
+    memcpy(op, literals, count);
+    return op + count;
+}
+
+// Length of the common prefix of a and b, at most `limit` bytes
+size_t matchLength(const uint8_t* a, const uint8_t* b, size_t limit)
+{
+    size_t n = 0;
+    while (n + 8 <= limit) {
+        uint64_t x, y;
+        memcpy(&x, a + n, 8);
+        memcpy(&y, b + n, 8);
+        if (x != y) return n + (__builtin_ctzll(x ^ y) >> 3);
+        n += 8;
+    }
+    while (n < limit && a[n] == b[n]) n++;
+    return n;
+}
+
+void shuffle(const uint8_t* in, size_t length, uint32_t width, uint8_t* out)
+{
+    const size_t count = length / width;
+    for (uint32_t b = 0; b < width; b++) {
+        uint8_t* plane = out + b * count;
+        for (size_t i = 0; i < count; i++) {
+            plane[i] = in[i * width + b];
+        }
+    }
+    // A partial trailing value is kept as is
+    memcpy(out + count * width, in + count * width, length - count * width);
+}
+
+// Value i of four byte planes
+inline uint32_t gather32(const uint8_t* in, size_t count, size_t i)
+{
+    return static_cast<uint32_t>(in[i]) | static_cast<uint32_t>(in[count + i]) << 8 |
+           static_cast<uint32_t>(in[2 * count + i]) << 16 | static_cast<uint32_t>(in[3 * count + i]) << 24;
+}
+
+void unshuffle(const uint8_t* in, size_t length, uint32_t width, uint8_t* out)
+{
+    const size_t count = length / width;
+    if (width == 4) {
+        // Whole-word stores: the common case (floats, ids) is load-time critical
+        for (size_t i = 0; i < count; i++) {
+            const uint32_t v = gather32(in, count, i);
+            memcpy(out + i * 4, &v, 4);
+        }
+        memcpy(out + count * 4, in + count * 4, length - count * 4);
+        return;
+    }
+    for (uint32_t b = 0; b < width; b++) {
+        const uint8_t* plane = in + b * count;
+        for (size_t i = 0; i < count; i++) {
+            out[i * width + b] = plane[i];
+        }
+    }
+    memcpy(out + count * width, in + count * width, length - count * width);
+}
+
+// Delta and shuffle in one pass (4-byte values)
+void deltaShuffle(const uint8_t* in, size_t length, uint8_t* out)
+{
+    const size_t count = length / 4;
+    uint32_t prev = 0;
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t v = read32(in + i * 4);
+        const uint32_t d = v - prev;
+        prev = v;
+        out[i] = static_cast<uint8_t>(d);
+        out[count + i] = static_cast<uint8_t>(d >> 8);
+        out[2 * count + i] = static_cast<uint8_t>(d >> 16);
+        out[3 * count + i] = static_cast<uint8_t>(d >> 24);
+    }
+    memcpy(out + count * 4, in + count * 4, length - count * 4);
+}
+
+void unshuffleDelta(const uint8_t* in, size_t length, uint8_t* out)
+{
+    const size_t count = length / 4;
+    uint32_t prev = 0;
+    for (size_t i = 0; i < count; i++) {
+        prev += gather32(in, count, i);
+        memcpy(out + i * 4, &prev, 4);
+    }
+    memcpy(out + count * 4, in + count * 4, length - count * 4);
+}
+
+} // namespace
+
+// ====================================================================================
+// LZ CODEC
+// ====================================================================================
+
+size_t lzBound(size_t length)
+{
+    return length + length / 255 + 16;
+}
+
+size_t lzCompress(const uint8_t* in, size_t length, uint8_t* out)
+{
+    // Last position seen per 4-byte hash; 0 doubles as "none" (checked below)
+    std::vector<uint32_t> table(size_t(1) << LZ_HASH_BITS, 0);
+    uint8_t* op = out;
+    size_t anchor = 0;
+    size_t ip = 0;
+    uint32_t misses = 0;
+
+    while (length >= LZ_MIN_MATCH && ip <= length - LZ_MIN_MATCH) {
+        const uint32_t seq = read32(in + ip);
+        const uint32_t h = hash4(seq);
+        const size_t candidate = table[h];
+        table[h] = static_cast<uint32_t>(ip);
+
+        if (candidate >= ip || ip - candidate > LZ_MAX_OFFSET || read32(in + candidate) != seq) {
+            // Incompressible input is skipped faster the longer it lasts
+            ip += 1 + (misses++ >> LZ_SKIP_SHIFT);
+            continue;
+        }
+
+        const size_t match = LZ_MIN_MATCH + matchLength(in + candidate + LZ_MIN_MATCH, in + ip + LZ_MIN_MATCH,
+                                                        length - ip - LZ_MIN_MATCH);
+        const size_t extra = match - LZ_MIN_MATCH;
+        const size_t offset = ip - candidate;
+        op = writeLiterals(op, static_cast<uint8_t>(std::min<size_t>(extra, 15)), in + anchor, ip - anchor);
+        *op++ = static_cast<uint8_t>(offset);
+        *op++ = static_cast<uint8_t>(offset >> 8);
+        if (extra >= 15) op = writeLength(op, extra - 15);
+
+        ip += match;
+        anchor = ip;
+        misses = 0;
+
+        // Index the end of the match so a following repeat is found
+        if (ip <= length - LZ_MIN_MATCH) {
+            table[hash4(read32(in + ip - 2))] = static_cast<uint32_t>(ip - 2);
+        }
+    }
+
+    op = writeLiterals(op, 0, in + anchor, length - anchor);
+    return static_cast<size_t>(op - out);
+}
+
+bool lzDecompress(const uint8_t* in, size_t length, uint8_t* out, size_t out_length)
+{
+    const uint8_t* ip = in;
+    const uint8_t* const iend = in + length;
+    uint8_t* op = out;
+    uint8_t* const oend = out + out_length;
+
+    for (;;) {
+        if (ip >= iend) return false;
+        const uint8_t token = *ip++;
+
+        size_t literals = token >> 4;
+        if (literals == 15 && !readLength(ip, iend, literals)) return false;
+        if (literals > static_cast<size_t>(iend - ip) || literals > static_cast<size_t>(oend - op)) return false;
+        if (literals > 0) {
+            memcpy(op, ip, literals);
+        }
+        op += literals;
+        ip += literals;
+        if (ip == iend) return op == oend;
+
+        if (iend - ip < 2) return false;
+        const size_t offset = static_cast<size_t>(ip[0]) | static_cast<size_t>(ip[1]) << 8;
+        ip += 2;
+        size_t match = token & 15;
+        if (match == 15 && !readLength(ip, iend, match)) return false;
+        match += LZ_MIN_MATCH;
+        if (offset == 0 || offset > static_cast<size_t>(op - out) || match > static_cast<size_t>(oend - op)) {
+            return false;
+        }
+
+        // Overlapping matches repeat the last `offset` bytes; each copy
+        // doubles the span that is already in place
+        const uint8_t* ref = op - offset;
+        uint8_t* const end = op + match;
+        while (op < end) {
+            const size_t n = std::min(static_cast<size_t>(op - ref), static_cast<size_t>(end - op));
+            memcpy(op, ref, n);
+            op += n;
+        }
+    }
+}
+
+// ====================================================================================
+// BLOCKS
+// ====================================================================================
+
+bool encodeBlock(const void* data, size_t length, BlockFilter filter, uint32_t width,
+                 std::vector<uint8_t>& out, uint32_t& encoding)
+{
+    if (length == 0) return false;
+    if (filter == FILTER_DELTA_SHUFFLE && width != 4) filter = FILTER_SHUFFLE;
+    if (filter == FILTER_SHUFFLE && (width < 2 || width > 255)) filter = FILTER_NONE;
+
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+    std::vector<uint8_t> filtered;
+    if (filter != FILTER_NONE) {
+        filtered.resize(length);
+        if (filter == FILTER_DELTA_SHUFFLE) {
+            deltaShuffle(src, length, filtered.data());
+        } else {
+            shuffle(src, length, width, filtered.data());
+        }
+        src = filtered.data();
+    }
+
+    out.resize(lzBound(length));
+    const size_t n = lzCompress(src, length, out.data());
+    if (n > length - length / MIN_GAIN_DIVISOR) return false;
+    out.resize(n);
+    encoding = BLOCK_LZ | filter << 8 | (filter != FILTER_NONE ? width : 1) << 16;
+    return true;
+}
+
+bool decodeBlock(const uint8_t* in, size_t length, uint32_t encoding, void* out, size_t out_length,
+                 std::vector<uint8_t>& scratch)
+{
+    const uint32_t codec = encoding & 0xFF;
+    const uint32_t filter = (encoding >> 8) & 0xFF;
+    const uint32_t width = (encoding >> 16) & 0xFF;
+    uint8_t* dst = static_cast<uint8_t*>(out);
+
+    if (encoding == BLOCK_RAW) {
+        if (length != out_length) return false;
+        memcpy(dst, in, length);
+        return true;
+    }
+    if (codec != BLOCK_LZ) return false;
+    if (filter == FILTER_NONE) return lzDecompress(in, length, dst, out_length);
+    if (filter == FILTER_SHUFFLE && width < 2) return false;
+    if (filter == FILTER_DELTA_SHUFFLE && width != 4) return false;
+    if (filter > FILTER_DELTA_SHUFFLE) return false;
+
+    if (scratch.size() < out_length) scratch.resize(out_length);
+    if (!lzDecompress(in, length, scratch.data(), out_length)) return false;
+    if (filter == FILTER_DELTA_SHUFFLE) {
+        unshuffleDelta(scratch.data(), out_length, dst);
+    } else {
+        unshuffle(scratch.data(), out_length, width, dst);
+    }
+    return true;
+}
+
+// ====================================================================================
+// TIME SERIES
+// ====================================================================================
+
+namespace {
+
+/**
+ * @brief MSB-first bit appender
+ */
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : m_out(out) {}
+    ~BitWriter() { finish(); }
+
+    void put(uint64_t value, uint32_t bits)
+    {
+        while (bits > 0) {
+            const uint32_t n = std::min(bits, 56u - m_fill);
+            bits -= n;
+            m_acc = (m_acc << n) | ((value >> bits) & ((1ull << n) - 1));
+            m_fill += n;
+            while (m_fill >= 8) {
+                m_fill -= 8;
+                m_out.push_back(static_cast<uint8_t>(m_acc >> m_fill));
+            }
+        }
+    }
+
+    void finish()
+    {
+        if (m_fill > 0) {
+            m_out.push_back(static_cast<uint8_t>(m_acc << (8 - m_fill)));
+            m_fill = 0;
+        }
+    }
+
+private:
+    std::vector<uint8_t>& m_out;
+    uint64_t m_acc = 0;
+    uint32_t m_fill = 0;        // Bits held in m_acc (< 8 between calls)
+};
+
+/**
+ * @brief MSB-first bit reader; reading past the end sets failed()
+ */
+class BitReader {
+public:
+    BitReader(const uint8_t* in, size_t length) : m_in(in), m_bits(static_cast<uint64_t>(length) * 8) {}
+
+    uint64_t get(uint32_t bits)
+    {
+        if (m_pos + bits > m_bits) {
+            m_failed = true;
+            return 0;
+        }
+        uint64_t value = 0;
+        while (bits > 0) {
+            const uint32_t bit = static_cast<uint32_t>(m_pos & 7);
+            const uint32_t n = std::min(bits, 8 - bit);
+            const uint32_t byte = m_in[m_pos >> 3];
+            value = (value << n) | ((byte >> (8 - bit - n)) & ((1u << n) - 1));
+            m_pos += n;
+            bits -= n;
+        }
+        return value;
+    }
+
+    bool failed() const { return m_failed; }
+
+private:
+    const uint8_t* m_in;
+    uint64_t m_bits;
+    uint64_t m_pos = 0;
+    bool m_failed = false;
+};
+
+// Delta-of-delta prefix codes: 0 | 10 + 7 bits | 110 + 9 | 1110 + 12 | 1111 + 64
+struct DodCode {
+    uint32_t prefix;
+    uint32_t prefix_bits;
+    uint32_t value_bits;
+};
+constexpr DodCode DOD_CODES[] = {{0x2, 2, 7}, {0x6, 3, 9}, {0xE, 4, 12}};
+
+inline uint32_t countLeadingZeros(uint32_t v) { return v ? static_cast<uint32_t>(__builtin_clz(v)) : 32; }
+inline uint32_t countTrailingZeros(uint32_t v) { return v ? static_cast<uint32_t>(__builtin_ctz(v)) : 32; }
+
+} // namespace
+
+void encodeTimestamps(const uint64_t* times, size_t count, std::vector<uint8_t>& out)
+{
+    BitWriter bits(out);
+    uint64_t prev = 0;
+    int64_t prev_delta = 0;
+    for (size_t k = 0; k < count; k++) {
+        if (k == 0) {
+            bits.put(times[0], 64);
+            prev = times[0];
+            continue;
+        }
+        const int64_t delta = static_cast<int64_t>(times[k] - prev);
+        const int64_t dod = delta - prev_delta;
+        prev = times[k];
+        prev_delta = delta;
+
+        if (dod == 0) {
+            bits.put(0, 1);
+            continue;
+        }
+        bool coded = false;
+        for (const DodCode& code : DOD_CODES) {
+            const int64_t half = int64_t(1) << (code.value_bits - 1);
+            if (dod >= -half + 1 && dod <= half) {
+                // Shifted so the range is [1 - half, half] -> [0, 2 * half)
+                bits.put(code.prefix, code.prefix_bits);
+                bits.put(static_cast<uint64_t>(dod + half - 1), code.value_bits);
+                coded = true;
+                break;
+            }
+        }
+        if (!coded) {
+            bits.put(0xF, 4);
+            bits.put(static_cast<uint64_t>(dod), 64);
+        }
+    }
+}
+
+bool decodeTimestamps(const uint8_t* in, size_t length, uint64_t* out, size_t count)
+{
+    BitReader bits(in, length);
+    uint64_t prev = 0;
+    int64_t prev_delta = 0;
+    for (size_t k = 0; k < count && !bits.failed(); k++) {
+        if (k == 0) {
+            prev = out[0] = bits.get(64);
+            continue;
+        }
+        int64_t dod = 0;
+        if (bits.get(1) != 0) {
+            size_t c = 0;
+            while (c < 3 && bits.get(1) != 0) c++;
+            if (c < 3) {
+                const uint32_t value_bits = DOD_CODES[c].value_bits;
+                const int64_t half = int64_t(1) << (value_bits - 1);
+                dod = static_cast<int64_t>(bits.get(value_bits)) - half + 1;
+            } else {
+                dod = static_cast<int64_t>(bits.get(64));
+            }
+        }
+        prev_delta += dod;
+        prev += static_cast<uint64_t>(prev_delta);
+        out[k] = prev;
+    }
+    return !bits.failed();
+}
+
+void encodeXorFloats(const float* values, size_t count, std::vector<uint8_t>& out)
+{
+    BitWriter bits(out);
+    uint32_t prev = 0;
+    uint32_t window_lead = 33;      // No window yet
+    uint32_t window_trail = 0;
+    for (size_t k = 0; k < count; k++) {
+        uint32_t v;
+        memcpy(&v, &values[k], sizeof(v));
+        if (k == 0) {
+            bits.put(v, 32);
+            prev = v;
+            continue;
+        }
+        const uint32_t x = v ^ prev;
+        prev = v;
+        if (x == 0) {
+            bits.put(0, 1);
+            continue;
+        }
+
+        const uint32_t lead = std::min(countLeadingZeros(x), 31u);
+        const uint32_t trail = countTrailingZeros(x);
+        if (window_lead <= 32 && lead >= window_lead && trail >= window_trail) {
+            // Fits the previous window: 10 + its meaningful bits
+            bits.put(0x2, 2);
+            bits.put(x >> window_trail, 32 - window_lead - window_trail);
+        } else {
+            // 11 + leading zeros (5 bits) + length - 1 (5 bits) + bits
+            const uint32_t length = 32 - lead - trail;
+            bits.put(0x3, 2);
+            bits.put(lead, 5);
+            bits.put(length - 1, 5);
+            bits.put(x >> trail, length);
+            window_lead = lead;
+            window_trail = trail;
+        }
+    }
+}
+
+bool decodeXorFloats(const uint8_t* in, size_t length, float* out, size_t count)
+{
+    BitReader bits(in, length);
+    uint32_t prev = 0;
+    uint32_t window_lead = 0;
+    uint32_t window_trail = 0;
+    bool window = false;
+    for (size_t k = 0; k < count && !bits.failed(); k++) {
+        if (k == 0) {
+            prev = static_cast<uint32_t>(bits.get(32));
+        } else if (bits.get(1) != 0) {
+            if (bits.get(1) == 0) {
+                if (!window) return false;
+            } else {
+                window_lead = static_cast<uint32_t>(bits.get(5));
+                const uint32_t bits_used = static_cast<uint32_t>(bits.get(5)) + 1;
+                if (window_lead + bits_used > 32) return false;
+                window_trail = 32 - window_lead - bits_used;
+                window = true;
+            }
+            const uint32_t x = static_cast<uint32_t>(bits.get(32 - window_lead - window_trail)) << window_trail;
+            prev ^= x;
+        }
+        memcpy(&out[k], &prev, sizeof(prev));
+    }
+    return !bits.failed();
+}
+
+} // namespace ReptileSim
@@ -0,0 +1,106 @@
+/**
+ * @file compression.hpp
+ * @brief Block compression for saves and archives (filters + LZ codec)
+ *
+ * A block is encoded in up to three reversible passes:
+ *
+ *   delta     each 32-bit value minus the previous one, in wrapping integer
+ *             arithmetic on the bit pattern (floats round-trip exactly)
+ *   shuffle   byte planes: every value's byte 0, then every byte 1, ...
+ *   LZ        byte-oriented LZ77, LZ4-style sequences, 64 KB window
+ *
+ * Ascending ids and slowly varying floats become long runs of equal high
+ * bytes after delta and shuffle, which the LZ pass removes. There is no
+ * entropy stage, so decoding is a bounds-checked copy loop that runs far
+ * faster than flash reads.
+ *
+ * The encoding word stored with each block is
+ * codec | filter << 8 | element width << 16; 0 means stored raw.
+ *
+ * Time series (telemetry archive) use Gorilla-style bit streams instead:
+ * timestamps as delta-of-delta with short prefix codes, floats as the XOR
+ * with the previous value, storing only the bits between its leading and
+ * trailing zeros (or reusing the previous window). A regular sample
+ * period costs one bit per timestamp and an unchanged value one bit.
+ */
+
+#ifndef COMPRESSION_HPP
+#define COMPRESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ReptileSim {
+
+// On-disk values, never renumber
+enum BlockCodec : uint32_t {
+    BLOCK_RAW = 0,
+    BLOCK_LZ  = 1,
+};
+
+enum BlockFilter : uint32_t {
+    FILTER_NONE          = 0,
+    FILTER_SHUFFLE       = 1,   // Byte planes of `width`-byte values
+    FILTER_DELTA_SHUFFLE = 2,   // 32-bit delta, then byte planes (width 4)
+};
+
+/**
+ * @brief Worst-case lzCompress() output for `length` input bytes
+ */
+size_t lzBound(size_t length);
+
+/**
+ * @brief Compress into out (lzBound(length) bytes); returns bytes written
+ */
+size_t lzCompress(const uint8_t* in, size_t length, uint8_t* out);
+
+/**
+ * @brief Decompress exactly out_length bytes; false on malformed input
+ */
+bool lzDecompress(const uint8_t* in, size_t length, uint8_t* out, size_t out_length);
+
+/**
+ * @brief Filter and compress a block of `width`-byte values
+ *
+ * Filters that do not apply to the width (delta needs 4 bytes, shuffle
+ * needs more than 1) are dropped.
+ * @return false if the result would not be at least 1/8 smaller; store
+ * the block raw
+ */
+bool encodeBlock(const void* data, size_t length, BlockFilter filter, uint32_t width,
+                 std::vector<uint8_t>& out, uint32_t& encoding);
+
+/**
+ * @brief Decode a block into exactly out_length bytes
+ *
+ * Filtered blocks are decompressed into `scratch` first; pass the same
+ * vector for a series of blocks to allocate it once.
+ * @return false on an unknown encoding or malformed input
+ */
+bool decodeBlock(const uint8_t* in, size_t length, uint32_t encoding, void* out, size_t out_length,
+                 std::vector<uint8_t>& scratch);
+
+/**
+ * @brief Append `count` ascending timestamps as a delta-of-delta bit stream
+ */
+void encodeTimestamps(const uint64_t* times, size_t count, std::vector<uint8_t>& out);
+
+/**
+ * @brief Decode exactly `count` timestamps; false on truncated input
+ */
+bool decodeTimestamps(const uint8_t* in, size_t length, uint64_t* out, size_t count);
+
+/**
+ * @brief Append `count` floats as an XOR bit stream (exact, NaN included)
+ */
+void encodeXorFloats(const float* values, size_t count, std::vector<uint8_t>& out);
+
+/**
+ * @brief Decode exactly `count` floats; false on truncated input
+ */
+bool decodeXorFloats(const uint8_t* in, size_t length, float* out, size_t count);
+
+} // namespace ReptileSim
+
+#endif // COMPRESSION_HPP
@@ -0,0 +1,77 @@
+/**
+ * @file crc32.cpp
+ * @brief CRC-32 (IEEE 802.3, zlib-compatible)
+ */
+
+#include "crc32.hpp"
+
+#ifdef ESP_PLATFORM
+#include "esp_rom_crc.h"
+#endif
+
+namespace ReptileSim {
+
+#ifdef ESP_PLATFORM
+
+uint32_t crc32(const void* data, size_t len, uint32_t crc)
+{
+    return esp_rom_crc32_le(crc, static_cast<const uint8_t*>(data), static_cast<uint32_t>(len));
+}
+
+#else
+
+namespace {
+
+// table[k][b]: CRC of byte b followed by k zero bytes
+struct Crc32Tables {
+    uint32_t table[8][256];
+
+    Crc32Tables()
+    {
+        for (uint32_t b = 0; b < 256; b++) {
+            uint32_t c = b;
+            for (int bit = 0; bit < 8; bit++) {
+                c = (c & 1) ? (c >> 1) ^ 0xEDB88320u : c >> 1;
+            }
+            table[0][b] = c;
+        }
+        for (uint32_t b = 0; b < 256; b++) {
+            for (int k = 1; k < 8; k++) {
+                table[k][b] = (table[k - 1][b] >> 8) ^ table[0][table[k - 1][b] & 0xFF];
+            }
+        }
+    }
+};
+
+const Crc32Tables& tables()
+{
+    static const Crc32Tables t;
+    return t;
+}
+
+} // namespace
+
+uint32_t crc32(const void* data, size_t len, uint32_t crc)
+{
+    const uint32_t (&t)[8][256] = tables().table;
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+
+    // Eight bytes per step (little-endian load order)
+    while (len >= 8) {
+        const uint32_t lo = crc ^ (static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 |
+                                   static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24);
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+              t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+        p += 8;
+        len -= 8;
+    }
+    while (len--) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+    }
+    return ~crc;
+}
+
+#endif // ESP_PLATFORM
+
+} // namespace ReptileSim
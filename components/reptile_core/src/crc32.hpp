@@ -0,0 +1,24 @@
+/**
+ * @file crc32.hpp
+ * @brief CRC-32 (IEEE 802.3, zlib-compatible) for save files
+ */
+
+#ifndef CRC32_HPP
+#define CRC32_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ReptileSim {
+
+/**
+ * @brief Update a CRC-32 with len bytes (start with crc = 0)
+ *
+ * Same value as zlib's crc32(). Uses the ROM routine on device and a
+ * slice-by-8 table on the host.
+ */
+uint32_t crc32(const void* data, size_t len, uint32_t crc = 0);
+
+} // namespace ReptileSim
+
+#endif // CRC32_HPP
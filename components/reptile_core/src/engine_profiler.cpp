@@ -0,0 +1,53 @@
+/**
+ * @file engine_profiler.cpp
+ * @brief Per-engine timing counters
+ */
+
+#include "engine_profiler.hpp"
+#include <cstring>
+
+namespace ReptileSim {
+
+static const char* const PROFILE_SLOT_NAMES[] = {
+    "physics",
+    "biology",
+    "nutrition",
+    "sanitary",
+    "economy",
+    "behavior",
+    "genetics",
+    "reproduction",
+    "social",
+    "seasonal",
+    "security",
+    "technical",
+    "admin",
+    "weather",
+    "fused",
+    "parallel",
+    "step",
+    "capture",
+    "step_saving",
+    "history",
+    "telemetry",
+    "alerts",
+    "changes",
+};
+
+static_assert(sizeof(PROFILE_SLOT_NAMES) / sizeof(PROFILE_SLOT_NAMES[0]) ==
+              static_cast<size_t>(ProfileSlot::Count), "one name per profile slot");
+
+const char* profileSlotName(ProfileSlot slot)
+{
+    return (slot < ProfileSlot::Count) ? PROFILE_SLOT_NAMES[static_cast<size_t>(slot)] : "";
+}
+
+void EngineProfiler::reset()
+{
+    std::memset(m_stats, 0, sizeof(m_stats));
+    for (ProfileStats& s : m_stats) {
+        s.min_ns = UINT32_MAX;
+    }
+}
+
+} // namespace ReptileSim
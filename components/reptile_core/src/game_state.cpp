@@ -0,0 +1,268 @@
+/**
+ * @file game_state.cpp
+ * @brief Column storage for reptiles and terrariums
+ */
+
+#include "../include/game_state.hpp"
+#include <utility>
+
+namespace ReptileSim {
+
+// ====================================================================================
+// REPTILE STORE
+// ====================================================================================
+
+void ReptileStore::reserve(size_t n)
+{
+    weight_grams.reserve(n);
+    bone_density.reserve(n);
+    hydration.reserve(n);
+    stress_level.reserve(n);
+    stomach_content.reserve(n);
+    immune_system.reserve(n);
+    assigned_terrarium_id.reserve(n);
+    terrarium_index.reserve(n);
+    id.reserve(n);
+    flags.reserve(n);
+    name.reserve(n);
+    species.reserve(n);
+}
+
+void ReptileStore::clear()
+{
+    weight_grams.clear();
+    bone_density.clear();
+    hydration.clear();
+    stress_level.clear();
+    stomach_content.clear();
+    immune_system.clear();
+    assigned_terrarium_id.clear();
+    terrarium_index.clear();
+    id.clear();
+    flags.clear();
+    name.clear();
+    species.clear();
+    index.clear();
+}
+
+size_t ReptileStore::append(Reptile& r)
+{
+    const uint32_t slot = static_cast<uint32_t>(id.size());
+    if (r.id == 0) {
+        r.id = index.allocate(slot);
+        if (r.id == 0) return npos;
+    } else if (!index.insert(r.id, slot)) {
+        return npos;
+    }
+
+    weight_grams.push_back(r.weight_grams);
+    bone_density.push_back(r.bone_density);
+    hydration.push_back(r.hydration);
+    stress_level.push_back(r.stress_level);
+    stomach_content.push_back(r.stomach_content);
+    immune_system.push_back(r.immune_system);
+    assigned_terrarium_id.push_back(r.assigned_terrarium_id);
+    terrarium_index.push_back(SlotMap::INVALID);
+    id.push_back(r.id);
+
+    uint8_t f = 0;
+    if (r.is_healthy) f |= REPTILE_FLAG_HEALTHY;
+    if (r.is_hungry) f |= REPTILE_FLAG_HUNGRY;
+    if (r.is_shedding) f |= REPTILE_FLAG_SHEDDING;
+    flags.push_back(f);
+
+    name.push_back(r.name);
+    species.push_back(r.species);
+    return slot;
+}
+
+void ReptileStore::swapRemove(size_t i)
+{
+    const size_t last = id.size() - 1;
+    index.release(id[i]);
+
+    if (i != last) {
+        weight_grams[i] = weight_grams[last];
+        bone_density[i] = bone_density[last];
+        hydration[i] = hydration[last];
+        stress_level[i] = stress_level[last];
+        stomach_content[i] = stomach_content[last];
+        immune_system[i] = immune_system[last];
+        assigned_terrarium_id[i] = assigned_terrarium_id[last];
+        terrarium_index[i] = terrarium_index[last];
+        id[i] = id[last];
+        flags[i] = flags[last];
+        name[i] = std::move(name[last]);
+        species[i] = std::move(species[last]);
+        index.relocate(id[i], static_cast<uint32_t>(i));
+    }
+
+    weight_grams.pop_back();
+    bone_density.pop_back();
+    hydration.pop_back();
+    stress_level.pop_back();
+    stomach_content.pop_back();
+    immune_system.pop_back();
+    assigned_terrarium_id.pop_back();
+    terrarium_index.pop_back();
+    id.pop_back();
+    flags.pop_back();
+    name.pop_back();
+    species.pop_back();
+}
+
+Reptile ReptileStore::get(size_t i) const
+{
+    Reptile r;
+    r.id = id[i];
+    r.name = name[i];
+    r.species = species[i];
+    r.weight_grams = weight_grams[i];
+    r.bone_density = bone_density[i];
+    r.hydration = hydration[i];
+    r.stress_level = stress_level[i];
+    r.stomach_content = stomach_content[i];
+    r.immune_system = immune_system[i];
+    r.is_healthy = hasFlag(i, REPTILE_FLAG_HEALTHY);
+    r.is_hungry = hasFlag(i, REPTILE_FLAG_HUNGRY);
+    r.is_shedding = hasFlag(i, REPTILE_FLAG_SHEDDING);
+    r.assigned_terrarium_id = assigned_terrarium_id[i];
+    return r;
+}
+
+// ====================================================================================
+// TERRARIUM STORE
+// ====================================================================================
+
+void TerrariumStore::reserve(size_t n)
+{
+    temp_hot_zone.reserve(n);
+    temp_cold_zone.reserve(n);
+    humidity.reserve(n);
+    uv_index.reserve(n);
+    waste_level.reserve(n);
+    bacteria_count.reserve(n);
+    volume.reserve(n);
+    equipment.reserve(n);
+    id.reserve(n);
+    width.reserve(n);
+    height.reserve(n);
+    depth.reserve(n);
+}
+
+void TerrariumStore::clear()
+{
+    temp_hot_zone.clear();
+    temp_cold_zone.clear();
+    humidity.clear();
+    uv_index.clear();
+    waste_level.clear();
+    bacteria_count.clear();
+    volume.clear();
+    equipment.clear();
+    id.clear();
+    width.clear();
+    height.clear();
+    depth.clear();
+    index.clear();
+}
+
+size_t TerrariumStore::append(Terrarium& t)
+{
+    const uint32_t slot = static_cast<uint32_t>(id.size());
+    if (t.id == 0) {
+        t.id = index.allocate(slot);
+        if (t.id == 0) return npos;
+    } else if (!index.insert(t.id, slot)) {
+        return npos;
+    }
+
+    temp_hot_zone.push_back(t.temp_hot_zone);
+    temp_cold_zone.push_back(t.temp_cold_zone);
+    humidity.push_back(t.humidity);
+    uv_index.push_back(t.uv_index);
+    waste_level.push_back(t.waste_level);
+    bacteria_count.push_back(t.bacteria_count);
+    volume.push_back(t.width * t.height * t.depth);
+
+    uint8_t e = 0;
+    if (t.heater_on) e |= EQUIP_HEATER;
+    if (t.light_on) e |= EQUIP_LIGHT;
+    if (t.mister_on) e |= EQUIP_MISTER;
+    equipment.push_back(e);
+
+    id.push_back(t.id);
+    width.push_back(t.width);
+    height.push_back(t.height);
+    depth.push_back(t.depth);
+    return slot;
+}
+
+void TerrariumStore::swapRemove(size_t i)
+{
+    const size_t last = id.size() - 1;
+    index.release(id[i]);
+
+    if (i != last) {
+        temp_hot_zone[i] = temp_hot_zone[last];
+        temp_cold_zone[i] = temp_cold_zone[last];
+        humidity[i] = humidity[last];
+        uv_index[i] = uv_index[last];
+        waste_level[i] = waste_level[last];
+        bacteria_count[i] = bacteria_count[last];
+        volume[i] = volume[last];
+        equipment[i] = equipment[last];
+        id[i] = id[last];
+        width[i] = width[last];
+        height[i] = height[last];
+        depth[i] = depth[last];
+        index.relocate(id[i], static_cast<uint32_t>(i));
+    }
+
+    temp_hot_zone.pop_back();
+    temp_cold_zone.pop_back();
+    humidity.pop_back();
+    uv_index.pop_back();
+    waste_level.pop_back();
+    bacteria_count.pop_back();
+    volume.pop_back();
+    equipment.pop_back();
+    id.pop_back();
+    width.pop_back();
+    height.pop_back();
+    depth.pop_back();
+}
+
+Terrarium TerrariumStore::get(size_t i) const
+{
+    Terrarium t;
+    t.id = id[i];
+    t.width = width[i];
+    t.height = height[i];
+    t.depth = depth[i];
+    t.temp_hot_zone = temp_hot_zone[i];
+    t.temp_cold_zone = temp_cold_zone[i];
+    t.humidity = humidity[i];
+    t.uv_index = uv_index[i];
+    t.waste_level = waste_level[i];
+    t.bacteria_count = bacteria_count[i];
+    t.heater_on = hasEquipment(i, EQUIP_HEATER);
+    t.light_on = hasEquipment(i, EQUIP_LIGHT);
+    t.mister_on = hasEquipment(i, EQUIP_MISTER);
+    return t;
+}
+
+// ====================================================================================
+// GAME STATE
+// ====================================================================================
+
+void GameState::setGameClock(uint64_t clock_ms)
+{
+    // Hours are rebuilt from the integer clock every time, so they never
+    // drift however many steps have been taken
+    game_clock_ms = clock_ms;
+    game_day = static_cast<uint32_t>(clock_ms / GAME_MS_PER_DAY) + 1;
+    game_time_hours = static_cast<float>(static_cast<double>(clock_ms % GAME_MS_PER_DAY) / GAME_MS_PER_HOUR);
+}
+
+} // namespace ReptileSim
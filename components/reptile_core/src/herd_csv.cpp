@@ -0,0 +1,324 @@
+/**
+ * @file herd_csv.cpp
+ * @brief Streaming CSV reader/writer for bulk herd import and export
+ */
+
+#include "../include/herd_csv.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+#if !defined(REPTILE_SIM_NO_SIMD) && defined(__GNUC__) && defined(__x86_64__)
+#define CSV_SSE2 1
+#include <emmintrin.h>
+#else
+#define CSV_SSE2 0
+#endif
+
+namespace ReptileSim {
+
+namespace {
+
+// Bytes per fread; the buffer doubles for a longer record, up to the cap
+#ifdef ESP_PLATFORM
+constexpr size_t CSV_CHUNK_BYTES = 16 * 1024;
+#else
+constexpr size_t CSV_CHUNK_BYTES = 1024 * 1024;
+#endif
+constexpr size_t CSV_MAX_RECORD_BYTES = 4 * 1024 * 1024;
+constexpr size_t CSV_WRITE_BYTES = 64 * 1024;
+
+/**
+ * @brief First byte in [p, end) equal to a or b, or end
+ */
+const char* findEither(const char* p, const char* end, char a, char b)
+{
+#if CSV_SSE2
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    while (end - p >= 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb)));
+        if (mask != 0) return p + __builtin_ctz(static_cast<unsigned>(mask));
+        p += 16;
+    }
+#else
+    // SWAR: a zero byte in (word ^ pattern) marks a match
+    constexpr uint64_t ONES = 0x0101010101010101ull;
+    constexpr uint64_t HIGHS = 0x8080808080808080ull;
+    const uint64_t pa = ONES * static_cast<uint8_t>(a);
+    const uint64_t pb = ONES * static_cast<uint8_t>(b);
+    while (end - p >= 8) {
+        uint64_t w;
+        memcpy(&w, p, sizeof(w));
+        const uint64_t xa = w ^ pa;
+        const uint64_t xb = w ^ pb;
+        if ((((xa - ONES) & ~xa) | ((xb - ONES) & ~xb)) & HIGHS) break;
+        p += 8;
+    }
+#endif
+    while (p < end && *p != a && *p != b) p++;
+    return p;
+}
+
+// Split a complete record [p, end) (no line break) into fields
+void splitRecord(char* p, char* end, std::vector<std::string_view>& fields)
+{
+    for (;;) {
+        if (p < end && *p == '"') {
+            // Quoted: copy down over the doubled quotes
+            char* w = p;
+            const char* r = p + 1;
+            for (;;) {
+                const char* q = static_cast<const char*>(memchr(r, '"', static_cast<size_t>(end - r)));
+                if (!q) q = end;    // Unterminated: the rest of the record
+                memmove(w, r, static_cast<size_t>(q - r));
+                w += q - r;
+                if (q + 1 < end && q[1] == '"') {
+                    *w++ = '"';
+                    r = q + 2;
+                    continue;
+                }
+                r = (q < end) ? q + 1 : end;
+                break;
+            }
+            fields.emplace_back(p, static_cast<size_t>(w - p));
+
+            // Anything between the closing quote and the comma is dropped
+            p = const_cast<char*>(r);
+            char* comma = static_cast<char*>(memchr(p, ',', static_cast<size_t>(end - p)));
+            if (!comma) return;
+            p = comma + 1;
+            continue;
+        }
+
+        char* comma = static_cast<char*>(memchr(p, ',', static_cast<size_t>(end - p)));
+        char* field_end = comma ? comma : end;
+        fields.emplace_back(p, static_cast<size_t>(field_end - p));
+        if (!comma) return;
+        p = comma + 1;
+    }
+}
+
+} // namespace
+
+// ====================================================================================
+// READER
+// ====================================================================================
+
+CsvReader::~CsvReader()
+{
+    if (m_file) fclose(m_file);
+}
+
+bool CsvReader::open(const char* path)
+{
+    if (m_file) fclose(m_file);
+    m_pos = m_end = 0;
+    m_eof = m_failed = false;
+    m_line = 1;
+    m_record_line = 0;
+    m_file_bytes = m_consumed = 0;
+
+    m_file = fopen(path, "rb");
+    if (!m_file) return false;
+    if (fseek(m_file, 0, SEEK_END) == 0) {
+        const long size = ftell(m_file);
+        m_file_bytes = (size > 0) ? static_cast<uint64_t>(size) : 0;
+    }
+    fseek(m_file, 0, SEEK_SET);
+    m_buf.resize(CSV_CHUNK_BYTES);
+    return true;
+}
+
+bool CsvReader::refill()
+{
+    // Keep the partial record, then fill the rest of the buffer
+    if (m_pos > 0) {
+        memmove(m_buf.data(), m_buf.data() + m_pos, m_end - m_pos);
+        m_end -= m_pos;
+        m_pos = 0;
+    }
+    if (m_end == m_buf.size()) {
+        if (m_buf.size() >= CSV_MAX_RECORD_BYTES) {
+            m_failed = true;
+            return false;
+        }
+        m_buf.resize(m_buf.size() * 2);
+    }
+
+    const size_t n = fread(m_buf.data() + m_end, 1, m_buf.size() - m_end, m_file);
+    m_end += n;
+    if (n == 0) {
+        m_eof = true;
+        if (ferror(m_file)) m_failed = true;
+    }
+    return !m_failed;
+}
+
+bool CsvReader::next(std::vector<std::string_view>& fields)
+{
+    fields.clear();
+    if (!m_file || m_failed) return false;
+
+    for (;;) {
+        // Find the line break that ends the record, skipping quoted ones
+        char* const begin = m_buf.data() + m_pos;
+        char* const end = m_buf.data() + m_end;
+        const char* p = begin;
+        uint32_t breaks = 0;
+        bool quoted = false;
+        const char* record_end = nullptr;
+        while (p < end) {
+            p = findEither(p, end, '\n', '"');
+            if (p == end) break;
+            if (*p == '"') {
+                quoted = !quoted;
+            } else if (quoted) {
+                breaks++;
+            } else {
+                record_end = p;
+                break;
+            }
+            p++;
+        }
+
+        if (!record_end) {
+            if (!m_eof) {
+                if (!refill()) return false;
+                continue;
+            }
+            if (begin == end) return false;
+            record_end = end;   // Last record without a line break
+        }
+
+        const size_t used = static_cast<size_t>(record_end - begin) + (record_end < end ? 1 : 0);
+        m_record_line = m_line;
+        m_line += breaks + 1;
+        m_pos += used;
+        m_consumed += used;
+
+        char* stop = const_cast<char*>(record_end);
+        if (stop > begin && stop[-1] == '\r') stop--;
+        if (stop == begin) continue;    // Blank line
+
+        splitRecord(begin, stop, fields);
+        return true;
+    }
+}
+
+std::string_view trimSpaces(std::string_view s)
+{
+    while (!s.empty() && s.front() == ' ') s.remove_prefix(1);
+    while (!s.empty() && s.back() == ' ') s.remove_suffix(1);
+    return s;
+}
+
+int csvColumn(const std::vector<std::string_view>& header, std::string_view name)
+{
+    for (size_t c = 0; c < header.size(); c++) {
+        if (trimSpaces(header[c]) == name) return static_cast<int>(c);
+    }
+    return -1;
+}
+
+bool parseCsvNumber(std::string_view text, uint32_t& out)
+{
+    text = trimSpaces(text);
+    const char* end = text.data() + text.size();
+    const std::from_chars_result r = std::from_chars(text.data(), end, out);
+    return !text.empty() && r.ec == std::errc() && r.ptr == end;
+}
+
+bool parseCsvNumber(std::string_view text, float& out)
+{
+    text = trimSpaces(text);
+    if (!text.empty() && text.front() == '+') text.remove_prefix(1);
+    const char* end = text.data() + text.size();
+    const std::from_chars_result r = std::from_chars(text.data(), end, out);
+    return !text.empty() && r.ec == std::errc() && r.ptr == end && std::isfinite(out);
+}
+
+// ====================================================================================
+// WRITER
+// ====================================================================================
+
+CsvWriter::~CsvWriter()
+{
+    close();
+}
+
+bool CsvWriter::open(const char* path)
+{
+    close();
+    m_file = fopen(path, "wb");
+    m_failed = false;
+    m_row_started = false;
+    m_buf.clear();
+    m_buf.reserve(CSV_WRITE_BYTES + 256);
+    return m_file != nullptr;
+}
+
+void CsvWriter::separator()
+{
+    if (m_row_started) m_buf.push_back(',');
+    m_row_started = true;
+}
+
+void CsvWriter::flushIfFull()
+{
+    if (m_buf.size() < CSV_WRITE_BYTES) return;
+    if (m_file && fwrite(m_buf.data(), 1, m_buf.size(), m_file) != m_buf.size()) m_failed = true;
+    m_buf.clear();
+}
+
+void CsvWriter::field(std::string_view text)
+{
+    separator();
+    if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+        m_buf.insert(m_buf.end(), text.begin(), text.end());
+    } else {
+        m_buf.push_back('"');
+        for (const char c : text) {
+            if (c == '"') m_buf.push_back('"');
+            m_buf.push_back(c);
+        }
+        m_buf.push_back('"');
+    }
+    flushIfFull();
+}
+
+void CsvWriter::field(uint32_t value)
+{
+    separator();
+    char digits[16];
+    const std::to_chars_result r = std::to_chars(digits, digits + sizeof(digits), value);
+    m_buf.insert(m_buf.end(), digits, r.ptr);
+}
+
+void CsvWriter::field(float value)
+{
+    separator();
+    char digits[32];
+    const std::to_chars_result r = std::to_chars(digits, digits + sizeof(digits), value);
+    m_buf.insert(m_buf.end(), digits, r.ptr);
+}
+
+void CsvWriter::endRow()
+{
+    m_buf.push_back('\n');
+    m_row_started = false;
+    flushIfFull();
+}
+
+bool CsvWriter::close()
+{
+    if (!m_file) return false;
+    if (!m_buf.empty() && fwrite(m_buf.data(), 1, m_buf.size(), m_file) != m_buf.size()) m_failed = true;
+    m_buf.clear();
+    const bool closed = fclose(m_file) == 0;
+    m_file = nullptr;
+    return closed && !m_failed;
+}
+
+} // namespace ReptileSim
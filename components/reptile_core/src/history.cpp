@@ -0,0 +1,379 @@
+/**
+ * @file history.cpp
+ * @brief Multi-resolution environment history rings
+ */
+
+#include "../include/history.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#ifdef ESP_PLATFORM
+#include "esp_heap_caps.h"
+#endif
+
+namespace ReptileSim {
+
+namespace {
+
+constexpr uint64_t TIER_MS[] = {HISTORY_RAW_MS, HISTORY_MINUTE_MS, HISTORY_HOUR_MS};
+
+/**
+ * @brief Hands out aligned arrays from one block (sizes only if base is null)
+ */
+class Carver {
+public:
+    explicit Carver(uint8_t* base) : m_base(base) {}
+
+    template <typename T>
+    T* take(uint64_t count)
+    {
+        m_offset = (m_offset + alignof(T) - 1) / alignof(T) * alignof(T);
+        T* p = m_base ? reinterpret_cast<T*>(m_base + m_offset) : nullptr;
+        m_offset += count * sizeof(T);
+        return p;
+    }
+
+    uint64_t offset() const { return m_offset; }
+
+private:
+    uint8_t* m_base;
+    uint64_t m_offset = 0;
+};
+
+template <typename Acc>
+void resetAccumulators(Acc* acc, size_t count)
+{
+    for (size_t k = 0; k < count; k++) {
+        acc[k].min = std::numeric_limits<float>::infinity();
+        acc[k].max = -std::numeric_limits<float>::infinity();
+        acc[k].sum = 0.0f;
+        acc[k].count = 0;
+    }
+}
+
+} // namespace
+
+HistoryConfig HistoryRecorder::defaultConfig()
+{
+    HistoryConfig config;
+    config.terrarium_slots = 64;
+    config.reptile_slots = 256;
+    config.raw_samples = 300;
+    config.minute_buckets = 240;
+    config.hour_buckets = 168;
+    config.external_ram = true;
+    return config;
+}
+
+// ====================================================================================
+// ALLOCATION
+// ====================================================================================
+
+uint64_t HistoryRecorder::layout(uint8_t* base)
+{
+    Carver carver(base);
+    const uint32_t capacity[] = {m_config.raw_samples, m_config.minute_buckets, m_config.hour_buckets};
+    for (size_t t = 0; t < static_cast<size_t>(HistoryTier::Count); t++) {
+        m_rings[t] = {carver.take<uint64_t>(capacity[t]), capacity[t], 0, 0};
+    }
+
+    m_terrariums.channels = HISTORY_TERRARIUM_CHANNELS;
+    m_terrariums.slots = m_config.terrarium_slots;
+    m_reptiles.channels = HISTORY_REPTILE_CHANNELS;
+    m_reptiles.slots = m_config.reptile_slots;
+    for (Group* group : {&m_terrariums, &m_reptiles}) {
+        const uint64_t series = static_cast<uint64_t>(group->channels) * group->slots;
+        group->raw = carver.take<float>(series * m_config.raw_samples);
+        group->minutes = carver.take<Bucket>(series * m_config.minute_buckets);
+        group->hours = carver.take<Bucket>(series * m_config.hour_buckets);
+        group->minute_acc = carver.take<Accumulator>(series);
+        group->hour_acc = carver.take<Accumulator>(series);
+        group->owner = carver.take<uint32_t>(group->slots);
+        group->first_ms = carver.take<uint64_t>(group->slots);
+        group->last_ms = carver.take<uint64_t>(group->slots);
+    }
+    return carver.offset();
+}
+
+size_t HistoryRecorder::bytesFor(const HistoryConfig& config)
+{
+    HistoryRecorder sizing;
+    sizing.m_config = config;
+    const uint64_t bytes = sizing.layout(nullptr);
+    return (bytes > std::numeric_limits<size_t>::max()) ? std::numeric_limits<size_t>::max()
+                                                         : static_cast<size_t>(bytes);
+}
+
+bool HistoryRecorder::enable(const HistoryConfig& config)
+{
+    disable();
+    if (config.terrarium_slots == 0 || config.reptile_slots == 0 || config.raw_samples == 0 ||
+        config.minute_buckets == 0 || config.hour_buckets == 0) {
+        return false;
+    }
+
+    const size_t bytes = bytesFor(config);
+    if (bytes == std::numeric_limits<size_t>::max()) return false;
+
+    void* block = nullptr;
+#ifdef ESP_PLATFORM
+    if (config.external_ram) {
+        block = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+#endif
+    if (!block) block = malloc(bytes);
+    if (!block) return false;
+
+    m_config = config;
+    m_block = block;
+    m_bytes = bytes;
+    layout(static_cast<uint8_t*>(block));
+    clear();
+    return true;
+}
+
+void HistoryRecorder::disable()
+{
+    free(m_block);      // heap_caps_malloc() memory is freed by free() too
+    m_block = nullptr;
+    m_bytes = 0;
+    m_config = {};
+    m_started = false;
+}
+
+void HistoryRecorder::clear()
+{
+    if (!m_block) return;
+    for (Ring& ring : m_rings) {
+        ring.head = 0;
+        ring.count = 0;
+    }
+    for (Group* group : {&m_terrariums, &m_reptiles}) {
+        const size_t series = static_cast<size_t>(group->channels) * group->slots;
+        resetAccumulators(group->minute_acc, series);
+        resetAccumulators(group->hour_acc, series);
+        memset(group->owner, 0, group->slots * sizeof(uint32_t));
+    }
+    m_started = false;
+}
+
+// ====================================================================================
+// RECORDING
+// ====================================================================================
+
+uint32_t HistoryRecorder::push(Ring& ring, uint64_t time_ms)
+{
+    const uint32_t row = ring.head;
+    ring.time_ms[row] = time_ms;
+    ring.head = (row + 1 == ring.capacity) ? 0 : row + 1;
+    if (ring.count < ring.capacity) ring.count++;
+    return row;
+}
+
+void HistoryRecorder::record(const GameState& state)
+{
+    if (!m_block) return;
+
+    const uint64_t now = state.game_clock_ms;
+    const uint64_t second = now / HISTORY_RAW_MS;
+    if (m_started) {
+        if (second == m_second) return;
+        if (second < m_second) clear();     // Clock went back (a load)
+    }
+
+    // Close the buckets this sample no longer falls in
+    const uint64_t minute = now / HISTORY_MINUTE_MS;
+    const uint64_t hour = now / HISTORY_HOUR_MS;
+    if (m_started && minute != m_minute) {
+        uint32_t row = push(m_rings[static_cast<size_t>(HistoryTier::Minute)], m_minute * HISTORY_MINUTE_MS);
+        closeBuckets(m_terrariums, HistoryTier::Minute, row);
+        closeBuckets(m_reptiles, HistoryTier::Minute, row);
+        if (hour != m_hour) {
+            row = push(m_rings[static_cast<size_t>(HistoryTier::Hour)], m_hour * HISTORY_HOUR_MS);
+            closeBuckets(m_terrariums, HistoryTier::Hour, row);
+            closeBuckets(m_reptiles, HistoryTier::Hour, row);
+        }
+    }
+    m_second = second;
+    m_minute = minute;
+    m_hour = hour;
+    m_started = true;
+
+    const uint32_t row = push(m_rings[static_cast<size_t>(HistoryTier::Raw)], now);
+
+    const TerrariumStore& terra = state.terrariums;
+    const float* const terrarium_columns[HISTORY_TERRARIUM_CHANNELS] = {
+        terra.temp_hot_zone.data(), terra.humidity.data(), terra.waste_level.data(), terra.bacteria_count.data()};
+    recordGroup(m_terrariums, terra.id, terrarium_columns, row, now);
+
+    const ReptileStore& reptiles = state.reptiles;
+    const float* const reptile_columns[HISTORY_REPTILE_CHANNELS] = {
+        reptiles.stress_level.data(), reptiles.weight_grams.data()};
+    recordGroup(m_reptiles, reptiles.id, reptile_columns, row, now);
+}
+
+void HistoryRecorder::recordGroup(Group& group, const std::vector<uint32_t>& ids, const float* const* columns,
+                                  uint32_t row, uint64_t now_ms)
+{
+    const size_t slots = group.slots;
+    const size_t raw_stride = static_cast<size_t>(m_config.raw_samples) * slots;
+    float* const raw_row = group.raw + static_cast<size_t>(row) * slots;
+
+    for (size_t i = 0; i < ids.size(); i++) {
+        const uint32_t id = ids[i];
+        const uint32_t slot = SlotMap::slotOf(id);
+        if (slot >= slots) continue;
+
+        if (group.owner[slot] != id) {
+            // New entity in this slot: its series starts now
+            group.owner[slot] = id;
+            group.first_ms[slot] = now_ms;
+            for (uint32_t c = 0; c < group.channels; c++) {
+                resetAccumulators(group.minute_acc + c * slots + slot, 1);
+                resetAccumulators(group.hour_acc + c * slots + slot, 1);
+            }
+        }
+        group.last_ms[slot] = now_ms;
+
+        for (uint32_t c = 0; c < group.channels; c++) {
+            const float v = columns[c][i];
+            raw_row[c * raw_stride + slot] = v;
+            Accumulator& acc = group.minute_acc[c * slots + slot];
+            acc.min = std::min(acc.min, v);
+            acc.max = std::max(acc.max, v);
+            acc.sum += v;
+            acc.count++;
+        }
+    }
+}
+
+void HistoryRecorder::closeBuckets(Group& group, HistoryTier tier, uint32_t row)
+{
+    const bool minute = (tier == HistoryTier::Minute);
+    const size_t slots = group.slots;
+    const size_t capacity = m_rings[static_cast<size_t>(tier)].capacity;
+    const float none = std::numeric_limits<float>::quiet_NaN();
+
+    for (uint32_t c = 0; c < group.channels; c++) {
+        Bucket* const out = (minute ? group.minutes : group.hours) + (c * capacity + row) * slots;
+        Accumulator* const acc = (minute ? group.minute_acc : group.hour_acc) + c * slots;
+        Accumulator* const hour = group.hour_acc + c * slots;
+        for (size_t s = 0; s < slots; s++) {
+            Accumulator& a = acc[s];
+            if (a.count == 0) {
+                out[s] = {none, none, none};
+                continue;
+            }
+            out[s] = {a.min, a.max, a.sum / static_cast<float>(a.count)};
+            if (minute) {
+                hour[s].min = std::min(hour[s].min, a.min);
+                hour[s].max = std::max(hour[s].max, a.max);
+                hour[s].sum += a.sum;
+                hour[s].count += a.count;
+            }
+            a.min = std::numeric_limits<float>::infinity();
+            a.max = -std::numeric_limits<float>::infinity();
+            a.sum = 0.0f;
+            a.count = 0;
+        }
+    }
+}
+
+// ====================================================================================
+// QUERY
+// ====================================================================================
+
+size_t HistoryRecorder::query(HistoryChannel channel, uint32_t id, uint64_t from_ms, uint64_t to_ms,
+                              HistoryPoint* out, size_t max_points, HistoryTier* tier) const
+{
+    if (!m_block || !m_started || channel >= HistoryChannel::Count || max_points == 0) return 0;
+
+    const bool is_terrarium = static_cast<size_t>(channel) < HISTORY_TERRARIUM_CHANNELS;
+    const Group& group = is_terrarium ? m_terrariums : m_reptiles;
+    const size_t c = is_terrarium ? static_cast<size_t>(channel)
+                                  : static_cast<size_t>(channel) - HISTORY_TERRARIUM_CHANNELS;
+    const uint32_t slot = SlotMap::slotOf(id);
+    if (id == 0 || slot >= group.slots || group.owner[slot] != id) return 0;
+
+    // Only the span this id was recorded for
+    const uint64_t lo = std::max(from_ms, group.first_ms[slot]);
+    const uint64_t hi = std::min(to_ms, group.last_ms[slot]);
+    if (lo > hi) return 0;
+
+    // Finest ring that still holds `lo` (counting the open bucket), else the
+    // one reaching furthest back
+    const uint64_t open_start[] = {UINT64_MAX, m_minute * HISTORY_MINUTE_MS, m_hour * HISTORY_HOUR_MS};
+    size_t t = 0;
+    uint64_t best_oldest = UINT64_MAX;
+    for (size_t k = 0; k < static_cast<size_t>(HistoryTier::Count); k++) {
+        const Ring& ring = m_rings[k];
+        uint64_t oldest = open_start[k];
+        if (ring.count > 0) {
+            oldest = std::min(oldest, ring.time_ms[(ring.head + ring.capacity - ring.count) % ring.capacity]);
+        }
+        if (oldest <= lo / TIER_MS[k] * TIER_MS[k]) {
+            t = k;
+            break;
+        }
+        if (oldest < best_oldest) {
+            best_oldest = oldest;
+            t = k;
+        }
+    }
+    if (tier) *tier = static_cast<HistoryTier>(t);
+
+    // First row at or after the start of the bucket holding `lo`
+    const Ring& ring = m_rings[t];
+    const uint64_t start = (t == 0) ? lo : lo / TIER_MS[t] * TIER_MS[t];
+    const uint32_t first_row = (ring.head + ring.capacity - ring.count) % ring.capacity;
+    auto rowAt = [&](uint32_t k) {
+        const uint32_t row = first_row + k;
+        return (row >= ring.capacity) ? row - ring.capacity : row;
+    };
+    uint32_t k = 0;
+    uint32_t count = ring.count;
+    while (count > 0) {
+        const uint32_t half = count / 2;
+        if (ring.time_ms[rowAt(k + half)] < start) {
+            k += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+
+    const size_t slots = group.slots;
+    size_t n = 0;
+    for (; k < ring.count && n < max_points; k++) {
+        const uint32_t row = rowAt(k);
+        const uint64_t time = ring.time_ms[row];
+        if (time > hi) break;
+        if (t == 0) {
+            const float v = group.raw[(c * m_config.raw_samples + row) * slots + slot];
+            out[n++] = {time, v, v, v};
+        } else {
+            const Bucket* rows = (t == 1) ? group.minutes : group.hours;
+            const Bucket& b = rows[(c * ring.capacity + row) * slots + slot];
+            if (!std::isnan(b.avg)) out[n++] = {time, b.min, b.max, b.avg};
+        }
+    }
+
+    // The open bucket so far (the open hour includes the open minute)
+    if (t > 0 && n < max_points && open_start[t] >= start && open_start[t] <= hi) {
+        Accumulator a = group.minute_acc[c * slots + slot];
+        if (t == 2) {
+            const Accumulator& h = group.hour_acc[c * slots + slot];
+            a.min = std::min(a.min, h.min);
+            a.max = std::max(a.max, h.max);
+            a.sum += h.sum;
+            a.count += h.count;
+        }
+        if (a.count > 0) out[n++] = {open_start[t], a.min, a.max, a.sum / static_cast<float>(a.count)};
+    }
+    return n;
+}
+
+} // namespace ReptileSim
@@ -0,0 +1,189 @@
+/**
+ * @file occupancy_index.cpp
+ * @brief Reptiles grouped by terrarium (compressed sparse rows)
+ */
+
+#include "../include/occupancy_index.hpp"
+
+namespace ReptileSim {
+
+// Capacity given to a bucket when the array is (re)laid out
+static uint32_t slackCapacity(uint32_t count)
+{
+    return count + count / 2 + 2;
+}
+
+void OccupancyIndex::clear()
+{
+    m_buckets.clear();
+    m_unassigned = {0, 0, 0};
+    m_members.clear();
+    m_position.clear();
+    m_reserved = 0;
+}
+
+void OccupancyIndex::rebuild(const std::vector<uint32_t>& terrarium_of, size_t terrarium_count)
+{
+    m_buckets.assign(terrarium_count, Bucket{0, 0, 0});
+    m_unassigned = {0, 0, 0};
+    m_position.assign(terrarium_of.size(), 0);
+
+    for (uint32_t t : terrarium_of) {
+        bucket(t).count++;
+    }
+    layout();
+
+    // Counting sort: fill each bucket in reptile order
+    for (Bucket& b : m_buckets) b.count = 0;
+    m_unassigned.count = 0;
+    for (size_t r = 0; r < terrarium_of.size(); r++) {
+        Bucket& b = bucket(terrarium_of[r]);
+        const uint32_t pos = b.offset + b.count++;
+        m_members[pos] = static_cast<uint32_t>(r);
+        m_position[r] = pos;
+    }
+}
+
+void OccupancyIndex::addReptile(uint32_t reptile, uint32_t terrarium)
+{
+    if (m_position.size() <= reptile) m_position.resize(reptile + 1);
+    push(bucket(terrarium), reptile);
+}
+
+void OccupancyIndex::moveReptile(uint32_t reptile, uint32_t from, uint32_t to)
+{
+    if (from == to) return;
+    erase(bucket(from), reptile);
+    push(bucket(to), reptile);
+}
+
+void OccupancyIndex::removeReptile(uint32_t reptile, uint32_t terrarium)
+{
+    erase(bucket(terrarium), reptile);
+
+    // The store moves its last reptile into the freed index
+    const uint32_t last = static_cast<uint32_t>(m_position.size() - 1);
+    if (reptile != last) {
+        const uint32_t pos = m_position[last];
+        m_members[pos] = reptile;
+        m_position[reptile] = pos;
+    }
+    m_position.pop_back();
+}
+
+void OccupancyIndex::addTerrarium()
+{
+    m_buckets.push_back({static_cast<uint32_t>(m_members.size()), 0, 0});
+}
+
+void OccupancyIndex::removeTerrarium(uint32_t terrarium, std::vector<uint32_t>& terrarium_of)
+{
+    // Evict occupants first; pushing them may relayout the array
+    Bucket& removed = m_buckets[terrarium];
+    std::vector<uint32_t> evicted(m_members.begin() + removed.offset,
+                                  m_members.begin() + removed.offset + removed.count);
+    m_reserved -= removed.capacity;
+    removed = {0, 0, 0};
+
+    // The last terrarium takes over the removed index
+    const uint32_t last = static_cast<uint32_t>(m_buckets.size() - 1);
+    if (terrarium != last) {
+        m_buckets[terrarium] = m_buckets[last];
+        const Bucket& moved = m_buckets[terrarium];
+        for (uint32_t j = 0; j < moved.count; j++) {
+            terrarium_of[m_members[moved.offset + j]] = terrarium;
+        }
+    }
+    m_buckets.pop_back();
+
+    for (uint32_t r : evicted) {
+        terrarium_of[r] = UNASSIGNED;
+        push(m_unassigned, r);
+    }
+}
+
+void OccupancyIndex::push(Bucket& b, uint32_t reptile)
+{
+    if (b.count == b.capacity) grow(b);
+    const uint32_t pos = b.offset + b.count++;
+    m_members[pos] = reptile;
+    m_position[reptile] = pos;
+}
+
+void OccupancyIndex::erase(Bucket& b, uint32_t reptile)
+{
+    // Fill the hole with the bucket's last member
+    const uint32_t pos = m_position[reptile];
+    const uint32_t tail = b.offset + --b.count;
+    const uint32_t moved = m_members[tail];
+    m_members[pos] = moved;
+    m_position[moved] = pos;
+}
+
+void OccupancyIndex::grow(Bucket& b)
+{
+    // Too many holes left behind by moved buckets: relayout everything
+    if (m_members.size() > 2 * m_reserved + 1024) {
+        compact();
+        if (b.count < b.capacity) return;
+    }
+
+    // Move the bucket to the end of the array with twice the room
+    const uint32_t capacity = (b.capacity < MIN_CAPACITY) ? MIN_CAPACITY : b.capacity * 2;
+    const uint32_t offset = static_cast<uint32_t>(m_members.size());
+    m_members.resize(m_members.size() + capacity);
+
+    for (uint32_t j = 0; j < b.count; j++) {
+        const uint32_t reptile = m_members[b.offset + j];
+        m_members[offset + j] = reptile;
+        m_position[reptile] = offset + j;
+    }
+
+    m_reserved += capacity - b.capacity;
+    b.offset = offset;
+    b.capacity = capacity;
+}
+
+void OccupancyIndex::compact()
+{
+    // Snapshot members bucket by bucket, then lay them out again
+    std::vector<uint32_t> packed;
+    packed.reserve(m_position.size());
+    for (const Bucket& b : m_buckets) {
+        packed.insert(packed.end(), m_members.begin() + b.offset, m_members.begin() + b.offset + b.count);
+    }
+    packed.insert(packed.end(), m_members.begin() + m_unassigned.offset,
+                  m_members.begin() + m_unassigned.offset + m_unassigned.count);
+
+    layout();
+
+    size_t next = 0;
+    auto fill = [&](const Bucket& b) {
+        for (uint32_t j = 0; j < b.count; j++) {
+            const uint32_t reptile = packed[next++];
+            m_members[b.offset + j] = reptile;
+            m_position[reptile] = b.offset + j;
+        }
+    };
+    for (const Bucket& b : m_buckets) fill(b);
+    fill(m_unassigned);
+}
+
+void OccupancyIndex::layout()
+{
+    // Assign offsets/capacities from the current counts
+    uint32_t offset = 0;
+    for (Bucket& b : m_buckets) {
+        b.offset = offset;
+        b.capacity = slackCapacity(b.count);
+        offset += b.capacity;
+    }
+    m_unassigned.offset = offset;
+    m_unassigned.capacity = slackCapacity(m_unassigned.count);
+    offset += m_unassigned.capacity;
+
+    m_members.assign(offset, 0);
+    m_reserved = offset;
+}
+
+} // namespace ReptileSim
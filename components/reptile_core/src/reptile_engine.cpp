@@ -4,12 +4,24 @@
  */
 
 #include "reptile_engine.hpp"
+#include "sim_fast_forward.hpp"
+#include "sim_kernels.hpp"
+#include "sim_stages.hpp"
+#include "snapshot.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cinttypes>
 #include <cmath>
 #include <cstring>
 #include <cstdio>
+#include <chrono>
+#include <unordered_map>
 
 namespace ReptileSim {
 
+static_assert(static_cast<size_t>(ProfileSlot::Weather) == static_cast<size_t>(SimEngine::Weather),
+              "profile slots start with the engines in SimEngine order");
+
 // ====================================================================================
 // SINGLETON PATTERN
 // ====================================================================================
@@ -26,19 +38,31 @@ ReptileEngine& ReptileEngine::getInstance()
 
 void ReptileEngine::init()
 {
+    // Recorded as a whole by the compaction below
+    m_journal_muted = true;
+
     // Initialize game state
-    m_state.game_day = 1;
-    m_state.game_time_hours = 12.0f; // Start at noon
+    m_state.setGameClock(12 * GAME_MS_PER_HOUR); // Day 1, start at noon
+    m_accumulator = 0.0;
+    for (EngineSchedule& s : m_schedule) {
+        s.pending_dt = 0.0f;
+        s.runs = 0;
+    }
+    seedEngineSlots();
+    m_profiler.reset();
+    m_history.clear();
+    m_alerts.reset();
+    m_changes.reset();
 
     // Create initial terrarium (100x60x50 cm)
     addTerrarium(100.0f, 60.0f, 50.0f);
 
     // Create test reptile
-    [[maybe_unused]] uint32_t rex_id = addReptile("Rex", "Pogona vitticeps");
+    uint32_t rex_id = addReptile("Rex", "Pogona vitticeps");
 
     // Assign to first terrarium
-    if (!m_state.reptiles.empty() && !m_state.terrariums.empty()) {
-        m_state.reptiles[0].assigned_terrarium_id = m_state.terrariums[0].id;
+    if (!m_state.terrariums.empty()) {
+        assignReptile(rex_id, m_state.terrariums.id[0]);
     }
 
     // Initialize economy
@@ -48,6 +72,11 @@ void ReptileEngine::init()
     m_state.external_temperature = 22.0f;
     m_state.external_humidity = 50.0f;
     m_state.heatwave_active = false;
+
+    m_journal_muted = false;
+    if (isJournaling()) {
+        compactJournal();
+    }
 }
 
 // ====================================================================================
@@ -56,139 +85,510 @@ void ReptileEngine::init()
 
 void ReptileEngine::tick(float delta_time)
 {
-    // Update game time (1 real second = 1 game minute)
-    // delta_time is in seconds, so divide by 60 to get game hours
-    m_state.game_time_hours += delta_time / 60.0f;
-    if (m_state.game_time_hours >= 24.0f) {
-        m_state.game_time_hours -= 24.0f;
-        m_state.game_day++;
-    }
-
-    // Update all 14 simulation engines
-    updatePhysics(delta_time);
-    updateBiology(delta_time);
-    updateNutrition(delta_time);
-    updateSanitary(delta_time);
-    updateEconomy(delta_time);
-    updateBehavior(delta_time);
-    updateGenetics(delta_time);
-    updateReproduction(delta_time);
-    updateSocial(delta_time);
-    updateSeasonal(delta_time);
-    updateSecurity(delta_time);
-    updateTechnical(delta_time);
-    updateAdmin(delta_time);
-    updateWeather(delta_time);
+    tickBatch(1, delta_time);
+}
+
+void ReptileEngine::tickBatch(uint32_t steps, float dt)
+{
+    // Tick boundary: copy the state for a waiting background save
+    serviceCapture();
+
+    if (steps > 0) {
+        if (!m_journal_muted) {
+            m_journal.ticks(steps, dt);
+        }
+
+        // Occupancy cannot change inside a batch, so one chunk plan covers it
+        if (m_tick_mode == TickMode::Parallel) {
+            planChunks();
+        }
+        for (uint32_t n = 0; n < steps; n++) {
+            step(dt);
+        }
+    } else {
+        // Paused: the player's actions still get their versions
+        const EngineProfiler::Stamp start = m_profiler.mark();
+        trackActions();
+        m_profiler.lapSince(ProfileSlot::Changes, start);
+    }
+
+    // Publish only if a view was read since the last batch; a paused game
+    // (no steps) still publishes the player's actions
+    if (m_views.takeDemand()) {
+        m_views.publish(m_state, m_changes);
+    }
+}
+
+uint32_t ReptileEngine::advance(float real_seconds, float time_scale)
+{
+    if (real_seconds > 0.0f && time_scale > 0.0f) {
+        m_accumulator += static_cast<double>(real_seconds) * time_scale;
+    }
+
+    double whole = std::floor(m_accumulator / FIXED_STEP);
+    if (whole > MAX_STEPS_PER_ADVANCE) {
+        // Fell too far behind (stalled task, absurd scale): drop the backlog
+        // instead of stalling the caller while catching up
+        m_accumulator = 0.0;
+        whole = MAX_STEPS_PER_ADVANCE;
+    } else {
+        m_accumulator -= whole * FIXED_STEP;
+    }
+
+    const uint32_t steps = static_cast<uint32_t>(whole);
+    tickBatch(steps, FIXED_STEP);
+    return steps;
+}
+
+void ReptileEngine::setTimeScale(float time_scale)
+{
+    m_time_scale = (time_scale > 0.0f) ? time_scale : 0.0f;
+}
+
+void ReptileEngine::step(float delta_time)
+{
+    const EngineProfiler::Stamp step_start = m_profiler.mark();
+    const bool woke_all = m_wake_all;   // The pass below clears it
+    advanceClock(delta_time);
+
+    if (m_tick_mode == TickMode::Sequential) {
+        // Reference path: all 14 simulation engines, one pass each
+        updatePhysics(delta_time);
+        m_profiler.lap(ProfileSlot::Physics);
+        updateBiology(delta_time);
+        m_profiler.lap(ProfileSlot::Biology);
+        updateNutrition(delta_time);
+        m_profiler.lap(ProfileSlot::Nutrition);
+        updateSanitary(delta_time);
+        m_profiler.lap(ProfileSlot::Sanitary);
+        updateBehavior(delta_time);
+        m_profiler.lap(ProfileSlot::Behavior);
+        updateGenetics(delta_time);
+        m_profiler.lap(ProfileSlot::Genetics);
+        updateReproduction(delta_time);
+        m_profiler.lap(ProfileSlot::Reproduction);
+        updateSocial(delta_time);
+        m_profiler.lap(ProfileSlot::Social);
+        updateSeasonal(delta_time);
+        m_profiler.lap(ProfileSlot::Seasonal);
+
+        // Nobody sleeps here; the next fused/parallel pass starts afresh
+        m_wake_all = true;
+        m_sleep_stats = {static_cast<uint32_t>(m_state.reptiles.size()), 0};
+    } else if (m_tick_mode == TickMode::Fused) {
+        // Fused path: the seven per-reptile engines run back to back on each
+        // reptile in a single pass. Sanitary and economy do not read reptile
+        // state, so running them after that pass changes nothing.
+        updatePhysics(delta_time);
+        m_profiler.lap(ProfileSlot::Physics);
+        updateFusedReptiles(delta_time);
+        m_profiler.lap(ProfileSlot::FusedReptiles);
+        updateSanitary(delta_time);
+        m_profiler.lap(ProfileSlot::Sanitary);
+    } else {
+        // Parallel path: the fused pipeline, split by terrarium over the
+        // worker pool (physics and sanitary ride along per terrarium)
+        updateParallel(delta_time);
+        m_profiler.lap(ProfileSlot::Parallel);
+    }
+    countEntityRuns(1);
+
+    // Economy reads no entity state, so it may follow the entity engines
+    updateGlobalEngines(delta_time, false);
+    if (m_history.enabled()) {
+        m_history.record(m_state);
+        m_profiler.lap(ProfileSlot::History);
+    }
+    if (m_telemetry.isOpen()) {
+        m_telemetry.record(m_state);
+        m_profiler.lap(ProfileSlot::Telemetry);
+    }
+    evaluateAlerts(woke_all);
+    m_profiler.lap(ProfileSlot::Alerts);
+    trackChanges(woke_all);
+    m_profiler.lap(ProfileSlot::Changes);
+    m_profiler.lapSince(ProfileSlot::Step, step_start);
+    if (m_save_writing.load(std::memory_order_relaxed)) {
+        m_profiler.lapSince(ProfileSlot::StepWhileSaving, step_start);
+    }
 }
 
 // ====================================================================================
-// ENGINE UPDATES
+// ENGINE SCHEDULER
 // ====================================================================================
 
-void ReptileEngine::updatePhysics(float dt)
+static bool isEntityEngine(SimEngine engine)
 {
-    for (auto& terra : m_state.terrariums) {
-        // Temperature simulation (simplified)
-        if (terra.heater_on) {
-            terra.temp_hot_zone += 0.5f * dt;
-            if (terra.temp_hot_zone > 35.0f) terra.temp_hot_zone = 35.0f;
-        } else {
-            terra.temp_hot_zone -= 0.3f * dt;
-            if (terra.temp_hot_zone < m_state.external_temperature) {
-                terra.temp_hot_zone = m_state.external_temperature;
-            }
-        }
+    switch (engine) {
+        case SimEngine::Economy:
+        case SimEngine::Security:
+        case SimEngine::Technical:
+        case SimEngine::Admin:
+        case SimEngine::Weather:
+            return false;
+        default:
+            return true;
+    }
+}
 
-        terra.temp_cold_zone = terra.temp_hot_zone - 5.0f;
+bool ReptileEngine::setEnginePeriod(SimEngine engine, uint32_t period, uint32_t phase)
+{
+    if (engine >= SimEngine::Count || isEntityEngine(engine)) return false;
+    if (period == 0 || phase >= period) return false;
+
+    EngineSchedule& s = m_schedule[static_cast<size_t>(engine)];
+    s.period = period;
+    s.phase = phase;
+    s.slot = clockSlot(s);
+
+    if (journaling()) {
+        JournalEnginePeriod rec = {};
+        rec.engine = static_cast<uint8_t>(engine);
+        rec.period = period;
+        rec.phase = phase;
+        m_journal.record(JournalOp::EnginePeriod, &rec, sizeof(rec));
+    }
+    return true;
+}
 
-        // Humidity
-        if (terra.mister_on) {
-            terra.humidity += 1.0f * dt;
-            if (terra.humidity > 80.0f) terra.humidity = 80.0f;
-        } else {
-            terra.humidity -= 0.5f * dt;
-            if (terra.humidity < 30.0f) terra.humidity = 30.0f;
+uint32_t ReptileEngine::getEnginePeriod(SimEngine engine) const
+{
+    return (engine < SimEngine::Count) ? m_schedule[static_cast<size_t>(engine)].period : 0;
+}
+
+uint64_t ReptileEngine::getEngineRuns(SimEngine engine) const
+{
+    return (engine < SimEngine::Count) ? m_schedule[static_cast<size_t>(engine)].runs : 0;
+}
+
+void ReptileEngine::resetEngineRuns()
+{
+    for (EngineSchedule& s : m_schedule) {
+        s.runs = 0;
+    }
+}
+
+bool ReptileEngine::engineDue(SimEngine engine, float dt, float& run_dt)
+{
+    EngineSchedule& s = m_schedule[static_cast<size_t>(engine)];
+    s.pending_dt += dt;
+
+    // Slowed engines are pinned to the game clock, so "every 60" means on
+    // the hour whatever the step size or load time
+    if (s.period > 1) {
+        const uint64_t slot = clockSlot(s);
+        if (slot == s.slot) return false;
+        s.slot = slot;
+    }
+
+    run_dt = s.pending_dt;
+    s.pending_dt = 0.0f;
+    s.runs++;
+    return true;
+}
+
+uint64_t ReptileEngine::clockSlot(const EngineSchedule& s) const
+{
+    const uint64_t minute = m_state.game_clock_ms / GAME_MS_PER_SECOND;
+    return (minute + s.period - s.phase) / s.period;
+}
+
+void ReptileEngine::seedEngineSlots()
+{
+    // Slot 0 would look like a slot change at the first tick and run
+    // every slowed engine then, whatever its phase
+    for (EngineSchedule& s : m_schedule) {
+        s.slot = clockSlot(s);
+    }
+}
+
+void ReptileEngine::countEntityRuns(uint64_t ticks)
+{
+    for (size_t e = 0; e < static_cast<size_t>(SimEngine::Count); e++) {
+        if (isEntityEngine(static_cast<SimEngine>(e))) {
+            m_schedule[e].runs += ticks;
         }
+    }
+}
 
-        // UV (day/night cycle)
-        if (m_state.game_time_hours >= 8.0f && m_state.game_time_hours <= 20.0f && terra.light_on) {
-            terra.uv_index = 3.0f; // Daytime UV
+void ReptileEngine::updateGlobalEngines(float dt, bool fast_forward)
+{
+    // Engines that are not due cost a few compares, charged to the next lap
+    float run_dt;
+    m_profiler.mark();
+    if (engineDue(SimEngine::Economy, dt, run_dt)) {
+        updateEconomy(run_dt);
+        m_profiler.lap(ProfileSlot::Economy);
+    }
+    if (engineDue(SimEngine::Security, dt, run_dt)) {
+        updateSecurity(run_dt);
+        m_profiler.lap(ProfileSlot::Security);
+    }
+    if (engineDue(SimEngine::Technical, dt, run_dt)) {
+        // Fast-forward draws the failures itself, per terrarium and window
+        if (fast_forward) {
+            updateTechnicalCosts(m_state, run_dt);
         } else {
-            terra.uv_index = 0.0f; // Night
+            updateTechnical(run_dt);
         }
+        m_profiler.lap(ProfileSlot::Technical);
+    }
+    if (engineDue(SimEngine::Admin, dt, run_dt)) {
+        updateAdmin(run_dt);
+        m_profiler.lap(ProfileSlot::Admin);
+    }
+    if (engineDue(SimEngine::Weather, dt, run_dt)) {
+        updateWeather(run_dt);
+        m_profiler.lap(ProfileSlot::Weather);
     }
 }
 
-void ReptileEngine::updateBiology(float dt)
+void ReptileEngine::advanceClock(float dt)
 {
-    for (auto& reptile : m_state.reptiles) {
-        // Find terrarium
-        Terrarium* terra = nullptr;
-        for (auto& t : m_state.terrariums) {
-            if (t.id == reptile.assigned_terrarium_id) {
-                terra = &t;
-                break;
-            }
-        }
+    // Update game time (1 real second = 1 game minute) on the integer
+    // clock; day and hours are derived from it
+    if (dt <= 0.0f) return;
+    const uint64_t elapsed_ms = static_cast<uint64_t>(std::llround(static_cast<double>(dt) * GAME_MS_PER_SECOND));
+    m_state.setGameClock(m_state.game_clock_ms + elapsed_ms);
+}
 
-        if (!terra) {
-            // No terrarium = extreme stress
-            reptile.stress_level += 5.0f * dt;
-            if (reptile.stress_level > 100.0f) reptile.stress_level = 100.0f;
-            continue;
-        }
+// ====================================================================================
+// FAST FORWARD
+// ====================================================================================
 
-        // Temperature stress
-        if (terra->temp_hot_zone < 28.0f || terra->temp_hot_zone > 38.0f) {
-            reptile.stress_level += 1.0f * dt;
-        } else {
-            reptile.stress_level -= 0.5f * dt;
+void ReptileEngine::fastForward(double game_seconds)
+{
+    if (!(game_seconds > 0.0)) return;
+
+    // One record for the whole span; the ticks below replay from it
+    if (journaling()) {
+        const JournalFastForward rec = {game_seconds};
+        m_journal.record(JournalOp::FastForward, &rec, sizeof(rec));
+    }
+    const bool muted = m_journal_muted;
+    m_journal_muted = true;
+
+    m_wake_all = true;
+
+    // One tick(1.0f) is one game minute
+    const double ticks = game_seconds / 60.0;
+    const double whole = std::floor(ticks);
+    const float rest = static_cast<float>(ticks - whole);
+
+    if (whole >= 1.0) {
+        // Entities are integrated up to the last whole tick, which runs for
+        // real so flags and derived values come out of the normal engines
+        double remaining = whole - 1.0;
+        while (remaining > 0.0) {
+            const uint32_t window = static_cast<uint32_t>(std::min<double>(remaining, FAST_FORWARD_WINDOW));
+            fastForwardWindow(window);
+            remaining -= window;
         }
+        tick(1.0f);
+    }
+    if (rest > 0.0f) {
+        tick(rest);
+    }
+    m_journal_muted = muted;
+}
+
+void ReptileEngine::fastForwardWindow(uint32_t ticks)
+{
+    const float dt = 1.0f;
+
+    FastForwardTrack track;
+    track.dt = dt;
+    track.external_before.resize(ticks);
+    track.season.resize(ticks);
+
+    // Global engines in tick() order, recording what the entity engines see
+    for (uint32_t n = 0; n < ticks; n++) {
+        advanceClock(dt);
+
+        bool brumation_season, should_be_dark;
+        seasonalContext(m_state, brumation_season, should_be_dark);
+        const bool daytime = (m_state.game_time_hours >= 8.0f && m_state.game_time_hours <= 20.0f);
+        track.season[n] = (brumation_season ? FF_BRUMATION : 0) |
+                          (should_be_dark ? FF_DARK : 0) |
+                          (daytime ? FF_DAYTIME : 0);
+        track.external_before[n] = m_state.external_temperature;
+
+        updateGlobalEngines(dt, true);
+    }
+
+    fastForwardEntities(m_state, track);
+    countEntityRuns(ticks);
+}
+
+void ReptileEngine::setTickMode(TickMode mode)
+{
+    m_tick_mode = mode;
+}
 
-        // Clamp stress
-        if (reptile.stress_level < 0.0f) reptile.stress_level = 0.0f;
-        if (reptile.stress_level > 100.0f) reptile.stress_level = 100.0f;
+void ReptileEngine::setWorkerCount(int workers)
+{
+    m_pool.stop();
+    m_pool_started = false;
+    m_worker_count = (workers < 0) ? WorkerPool::defaultWorkers() : static_cast<unsigned>(workers);
+}
+
+void ReptileEngine::rebuildOccupancy()
+{
+    ReptileStore& reptiles = m_state.reptiles;
+    const SlotMap& terra_index = m_state.terrariums.index;
+    const size_t count = reptiles.size();
 
-        // Health status
-        reptile.is_healthy = (reptile.stress_level < 50.0f &&
-                              reptile.immune_system > 60.0f &&
-                              reptile.bone_density > 60.0f);
+    for (size_t i = 0; i < count; i++) {
+        reptiles.terrarium_index[i] = terra_index.find(reptiles.assigned_terrarium_id[i]);
     }
+    m_state.occupancy.rebuild(reptiles.terrarium_index, m_state.terrariums.size());
+    m_wake_all = true;
 }
 
-void ReptileEngine::updateNutrition(float dt)
+bool ReptileEngine::beginSettle(const StageContext& ctx)
 {
-    for (auto& reptile : m_state.reptiles) {
-        // Digestion
-        if (reptile.stomach_content > 0.0f) {
-            reptile.stomach_content -= 0.5f * dt;
-            if (reptile.stomach_content < 0.0f) reptile.stomach_content = 0.0f;
-        }
+    const size_t buckets = m_state.terrariums.size() + 1;   // + unassigned
+
+    // dt and the seasonal context are read by every reptile
+    const bool wake_all = m_wake_all || m_rest.size() != buckets ||
+                          ctx.dt != m_rest_dt ||
+                          ctx.brumation_season != m_rest_brumation ||
+                          ctx.should_be_dark != m_rest_dark;
+
+    m_rest.resize(buckets);
+    m_rest_dt = ctx.dt;
+    m_rest_brumation = ctx.brumation_season;
+    m_rest_dark = ctx.should_be_dark;
+    m_wake_all = false;
+    return wake_all;
+}
+
+void ReptileEngine::wakeReptile(size_t i)
+{
+    m_state.reptiles.setFlag(i, REPTILE_FLAG_ASLEEP, false);
+    m_alerts.touch(m_state.reptiles.id[i]);
+    m_changes.touch(m_state.reptiles.id[i]);
+
+    const uint32_t t = m_state.reptiles.terrarium_index[i];
+    const size_t slot = (t == SlotMap::INVALID) ? m_rest.size() - 1 : t;
+    if (slot < m_rest.size()) {
+        m_rest[slot].awake++;
+    }
+}
+
+template <typename Visit>
+void ReptileEngine::forEachAwake(Visit visit) const
+{
+    const ReptileStore& reptiles = m_state.reptiles;
 
-        // Hunger
-        reptile.is_hungry = (reptile.stomach_content < 30.0f);
+    // A mostly awake herd is cheaper in index order than bucket by bucket
+    if (m_sleep_stats.awake > reptiles.size() / 4) {
+        const size_t count = reptiles.size();
+        for (size_t i = 0; i < count; i++) {
+            if (!reptiles.hasFlag(i, REPTILE_FLAG_ASLEEP)) visit(i);
+        }
+        return;
+    }
 
-        // Bone density decay without proper nutrition
-        if (reptile.stomach_content < 20.0f) {
-            reptile.bone_density -= 0.1f * dt;
-            if (reptile.bone_density < 0.0f) reptile.bone_density = 0.0f;
+    // Otherwise only buckets with someone awake are walked
+    const OccupancyIndex& occupancy = m_state.occupancy;
+    const size_t buckets = m_rest.size();
+    for (size_t b = 0; b < buckets; b++) {
+        if (m_rest[b].awake == 0) continue;
+        const uint32_t bucket = (b + 1 == buckets) ? OccupancyIndex::UNASSIGNED : static_cast<uint32_t>(b);
+        const uint32_t* members = occupancy.members(bucket);
+        const uint32_t count = occupancy.count(bucket);
+        for (uint32_t j = 0; j < count; j++) {
+            const uint32_t i = members[j];
+            if (!reptiles.hasFlag(i, REPTILE_FLAG_ASLEEP)) visit(i);
         }
     }
 }
 
-void ReptileEngine::updateSanitary(float dt)
+void ReptileEngine::evaluateAlerts(bool woke_all)
+{
+    const uint64_t now = m_state.game_clock_ms;
+    const ReptileStore& reptiles = m_state.reptiles;
+
+    // Physics moves every terrarium every tick
+    m_alerts.evaluateTerrariums(m_state.terrariums, now);
+
+    // A reptile that slept through the pass, or settled in it, has the
+    // columns it was last judged on; only the awake ones are judged, plus
+    // the reptiles changed since the last tick. Without sleep information
+    // (sequential mode, wake-all, new rules) everyone is judged.
+    const bool rescan = m_alerts.takeRescan();
+    if (rescan || woke_all || m_tick_mode == TickMode::Sequential) {
+        m_alerts.evaluateReptiles(reptiles, now);
+        return;
+    }
+
+    forEachAwake([&](size_t i) { m_alerts.evaluateReptile(reptiles, i, now); });
+    m_alerts.evaluateTouched(reptiles, now);
+}
+
+void ReptileEngine::trackChanges(bool woke_all)
+{
+    const ReptileStore& reptiles = m_state.reptiles;
+
+    // Same candidates as the alerts: every terrarium, the awake and touched
+    // reptiles, or everyone when the sleep information cannot tell
+    m_changes.beginPass();
+    m_changes.trackTerrariums(m_state.terrariums);
+    if (m_changes.takeRescan() || woke_all || m_tick_mode == TickMode::Sequential) {
+        m_changes.trackReptiles(reptiles);
+    } else {
+        forEachAwake([&](size_t i) { m_changes.trackReptile(reptiles, i); });
+        m_changes.trackTouched(reptiles);
+    }
+    m_changes.endPass();
+}
+
+void ReptileEngine::trackActions()
+{
+    // No step ran, so only the player's actions can have changed anything
+    m_changes.beginPass();
+    m_changes.trackTerrariums(m_state.terrariums);
+    if (m_changes.takeRescan()) {
+        m_changes.trackReptiles(m_state.reptiles);
+    } else {
+        m_changes.trackTouched(m_state.reptiles);
+    }
+    m_changes.endPass();
+}
+
+// ====================================================================================
+// ENGINE UPDATES
+// ====================================================================================
+
+void ReptileEngine::updatePhysics(float dt)
+{
+    const bool daytime = (m_state.game_time_hours >= 8.0f && m_state.game_time_hours <= 20.0f);
+
+    physicsKernel(m_state.terrariums, 0, m_state.terrariums.size(), dt,
+                  daytime, m_state.external_temperature);
+}
+
+void ReptileEngine::updateBiology(float dt)
 {
-    for (auto& terra : m_state.terrariums) {
-        // Waste accumulation
-        terra.waste_level += 0.5f * dt;
-        if (terra.waste_level > 100.0f) terra.waste_level = 100.0f;
+    const StageContext ctx = {&m_state.terrariums, &m_state.occupancy, dt, false, false};
+    const size_t count = m_state.reptiles.size();
 
-        // Bacteria growth
-        terra.bacteria_count += (terra.waste_level * 0.01f) * dt;
-        if (terra.bacteria_count > 100.0f) terra.bacteria_count = 100.0f;
+    for (size_t i = 0; i < count; i++) {
+        biologyStage(m_state.reptiles, i, ctx);
     }
 }
 
+void ReptileEngine::updateNutrition(float dt)
+{
+    nutritionKernel(m_state.reptiles, 0, m_state.reptiles.size(), dt);
+}
+
+void ReptileEngine::updateSanitary(float dt)
+{
+    sanitaryKernel(m_state.terrariums, 0, m_state.terrariums.size(), dt);
+}
+
 void ReptileEngine::updateEconomy(float dt)
 {
     // Electricity costs (per game hour, dt is in real seconds)
@@ -205,12 +605,13 @@ void ReptileEngine::updateEconomy(float dt)
 // PLAYER ACTIONS
 // ====================================================================================
 
-uint32_t ReptileEngine::addReptile(const std::string& name, const std::string& species)
+namespace {
+
+// Condition of a reptile the player adds (id 0: allocated by the store)
+Reptile newReptile()
 {
     Reptile r;
-    r.id = m_next_reptile_id++;
-    r.name = name;
-    r.species = species;
+    r.id = 0;
     r.weight_grams = 350.0f;
     r.bone_density = 100.0f;
     r.hydration = 100.0f;
@@ -221,15 +622,14 @@ uint32_t ReptileEngine::addReptile(const std::string& name, const std::string& s
     r.is_hungry = false;
     r.is_shedding = false;
     r.assigned_terrarium_id = 0; // Not assigned
-
-    m_state.reptiles.push_back(r);
-    return r.id;
+    return r;
 }
 
-uint32_t ReptileEngine::addTerrarium(float width, float height, float depth)
+// Condition of a terrarium the player adds (id 0: allocated by the store)
+Terrarium newTerrarium(float width, float height, float depth)
 {
     Terrarium t;
-    t.id = m_next_terrarium_id++;
+    t.id = 0;
     t.width = width;
     t.height = height;
     t.depth = depth;
@@ -242,32 +642,156 @@ uint32_t ReptileEngine::addTerrarium(float width, float height, float depth)
     t.heater_on = true;
     t.light_on = true;
     t.mister_on = false;
+    return t;
+}
+
+} // namespace
+
+uint32_t ReptileEngine::addReptile(const std::string& name, const std::string& species)
+{
+    const uint32_t id = insertReptile(0, name, species);
+    if (id != 0 && journaling()) {
+        const JournalAddReptile rec = {id, static_cast<uint32_t>(name.size()), static_cast<uint32_t>(species.size())};
+        const std::string chars = name + species;
+        m_journal.record(JournalOp::AddReptile, &rec, sizeof(rec), chars.data(), chars.size());
+    }
+    return id;
+}
+
+uint32_t ReptileEngine::insertReptile(uint32_t id, const std::string& name, const std::string& species)
+{
+    Reptile r = newReptile();
+    r.id = id;
+    r.name = name;
+    r.species = species;
+
+    size_t i = m_state.reptiles.append(r);
+    if (i == ReptileStore::npos) return 0;
+
+    m_state.occupancy.addReptile(static_cast<uint32_t>(i), OccupancyIndex::UNASSIGNED);
+    m_changes.touch(r.id);
+    m_wake_all = true;
+    return r.id;
+}
+
+uint32_t ReptileEngine::addTerrarium(float width, float height, float depth)
+{
+    const uint32_t id = insertTerrarium(0, width, height, depth);
+    if (id != 0 && journaling()) {
+        const JournalAddTerrarium rec = {id, width, height, depth};
+        m_journal.record(JournalOp::AddTerrarium, &rec, sizeof(rec));
+    }
+    return id;
+}
+
+uint32_t ReptileEngine::insertTerrarium(uint32_t id, float width, float height, float depth)
+{
+    Terrarium t = newTerrarium(width, height, depth);
+    t.id = id;
 
-    m_state.terrariums.push_back(t);
+    if (m_state.terrariums.append(t) == TerrariumStore::npos) return 0;
+
+    m_state.occupancy.addTerrarium();
+    m_wake_all = true;
     return t.id;
 }
 
 void ReptileEngine::feedAnimal(uint32_t reptile_id)
 {
-    for (auto& reptile : m_state.reptiles) {
-        if (reptile.id == reptile_id) {
-            reptile.stomach_content += 30.0f;
-            if (reptile.stomach_content > 100.0f) reptile.stomach_content = 100.0f;
-            reptile.is_hungry = false;
-            m_state.economy.food_cost += 2.0f; // $2 per feeding
-            break;
-        }
+    ReptileStore& reptiles = m_state.reptiles;
+    size_t i = reptiles.indexOf(reptile_id);
+    if (i == ReptileStore::npos) return;
+
+    reptiles.stomach_content[i] += 30.0f;
+    if (reptiles.stomach_content[i] > 100.0f) reptiles.stomach_content[i] = 100.0f;
+    reptiles.setFlag(i, REPTILE_FLAG_HUNGRY, false);
+    wakeReptile(i);
+    m_state.economy.food_cost += 2.0f; // $2 per feeding
+
+    if (journaling()) {
+        const JournalId rec = {reptile_id};
+        m_journal.record(JournalOp::Feed, &rec, sizeof(rec));
+    }
+}
+
+bool ReptileEngine::removeReptile(uint32_t reptile_id)
+{
+    size_t i = m_state.reptiles.indexOf(reptile_id);
+    if (i == ReptileStore::npos) return false;
+
+    m_state.occupancy.removeReptile(static_cast<uint32_t>(i), m_state.reptiles.terrarium_index[i]);
+    m_state.reptiles.swapRemove(i);
+    m_changes.removedReptile(reptile_id);
+    m_wake_all = true;
+
+    if (journaling()) {
+        const JournalId rec = {reptile_id};
+        m_journal.record(JournalOp::RemoveReptile, &rec, sizeof(rec));
+    }
+    return true;
+}
+
+bool ReptileEngine::removeTerrarium(uint32_t terrarium_id)
+{
+    size_t i = m_state.terrariums.indexOf(terrarium_id);
+    if (i == TerrariumStore::npos) return false;
+
+    // Occupants become unassigned; replaying the journal record clears
+    // them the same way, so none points at the retired id after a reload
+    ReptileStore& reptiles = m_state.reptiles;
+    const uint32_t* occupants = m_state.occupancy.members(static_cast<uint32_t>(i));
+    for (uint32_t k = 0, n = m_state.occupancy.count(static_cast<uint32_t>(i)); k < n; k++) {
+        reptiles.assigned_terrarium_id[occupants[k]] = 0;
+    }
+    m_state.occupancy.removeTerrarium(static_cast<uint32_t>(i), reptiles.terrarium_index);
+    m_state.terrariums.swapRemove(i);
+    m_changes.removedTerrarium(terrarium_id);
+    m_wake_all = true;
+
+    if (journaling()) {
+        const JournalId rec = {terrarium_id};
+        m_journal.record(JournalOp::RemoveTerrarium, &rec, sizeof(rec));
+    }
+    return true;
+}
+
+bool ReptileEngine::assignReptile(uint32_t reptile_id, uint32_t terrarium_id)
+{
+    ReptileStore& reptiles = m_state.reptiles;
+    size_t i = reptiles.indexOf(reptile_id);
+    if (i == ReptileStore::npos) return false;
+
+    uint32_t t = OccupancyIndex::UNASSIGNED;
+    if (terrarium_id != 0) {
+        t = m_state.terrariums.index.find(terrarium_id);
+        if (t == SlotMap::INVALID) return false;
+    }
+
+    m_state.occupancy.moveReptile(static_cast<uint32_t>(i), reptiles.terrarium_index[i], t);
+    reptiles.assigned_terrarium_id[i] = terrarium_id;
+    reptiles.terrarium_index[i] = t;
+    m_changes.touch(reptile_id);
+    m_wake_all = true;
+
+    if (journaling()) {
+        const JournalAssign rec = {reptile_id, terrarium_id};
+        m_journal.record(JournalOp::Assign, &rec, sizeof(rec));
     }
+    return true;
 }
 
 void ReptileEngine::cleanTerrarium(uint32_t terrarium_id)
 {
-    for (auto& terra : m_state.terrariums) {
-        if (terra.id == terrarium_id) {
-            terra.waste_level = 0.0f;
-            terra.bacteria_count *= 0.2f; // 80% reduction
-            break;
-        }
+    TerrariumStore& terra = m_state.terrariums;
+    size_t i = terra.indexOf(terrarium_id);
+    if (i == TerrariumStore::npos) return;
+
+    terra.waste_level[i] = 0.0f;
+    terra.bacteria_count[i] *= 0.2f; // 80% reduction
+
+    if (journaling()) {
+        const JournalId rec = {terrarium_id};
+        m_journal.record(JournalOp::Clean, &rec, sizeof(rec));
     }
 }
 
@@ -275,13 +799,125 @@ void ReptileEngine::cleanTerrarium(uint32_t terrarium_id)
 // SAVE/LOAD SYSTEM
 // ====================================================================================
 
+namespace {
+
+bool fileExists(const char* path)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    fclose(f);
+    return true;
+}
+
+} // namespace
+
 bool ReptileEngine::saveGame(const char* filepath)
+{
+    return writeSnapshot(m_state, filepath, engineSection(), m_save_compression);
+}
+
+bool ReptileEngine::loadGame(const char* filepath)
+{
+    if (!loadState(filepath)) return false;
+
+    // The journal extended the state that was just replaced
+    if (isJournaling()) {
+        compactJournal();
+    }
+    return true;
+}
+
+bool ReptileEngine::loadState(const char* filepath)
+{
+    if (!isSnapshotFile(filepath)) {
+        // A device save interrupted between remove and rename leaves only
+        // the complete .tmp behind. Once it reads back (CRCs checked) it is
+        // moved into place; left as .tmp, the next save would overwrite
+        // the only copy
+        const std::string tmp = std::string(filepath) + ".tmp";
+        if (isSnapshotFile(tmp.c_str())) {
+            if (!loadState(tmp.c_str())) return false;
+            if (!fileExists(filepath)) rename(tmp.c_str(), filepath);
+            return true;
+        }
+        if (!importText(filepath)) return false;
+        seedEngineSlots();
+        m_history.clear();
+        m_alerts.reset();
+        m_changes.reset();
+        return true;
+    }
+
+    GameState loaded = {};
+    std::vector<uint8_t> engine;
+    if (!readSnapshot(filepath, loaded, &engine)) return false;
+
+    m_state = std::move(loaded);
+    rebuildOccupancy();
+    restoreEngineSection(engine);
+    m_history.clear();
+    m_alerts.reset();
+    m_changes.reset();
+    return true;
+}
+
+bool ReptileEngine::saveGameBackground(const char* filepath, uint32_t timeout_ms)
+{
+    return saveBackground(filepath, false, timeout_ms);
+}
+
+bool ReptileEngine::saveBackground(const std::string& filepath, bool compact, uint32_t timeout_ms)
+{
+    std::lock_guard<std::mutex> one_save(m_save_mutex);
+    {
+        std::unique_lock<std::mutex> lock(m_capture_mutex);
+        m_capture_compact = compact;
+        m_capture_requested.store(true, std::memory_order_release);
+        const bool captured = m_capture_done.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this] {
+            return !m_capture_requested.load(std::memory_order_relaxed);
+        });
+        if (!captured) {
+            m_capture_requested.store(false, std::memory_order_relaxed);
+            return false;
+        }
+    }
+
+    // The ticking task has moved on; only this task waits for the file
+    m_save_writing.store(true, std::memory_order_relaxed);
+    const bool saved = writeSnapshot(m_save_state, filepath.c_str(), m_save_engine, m_save_compression);
+    m_save_writing.store(false, std::memory_order_relaxed);
+    return compact ? finishCompaction(saved) : saved;
+}
+
+void ReptileEngine::serviceCapture()
+{
+    // One load per batch when no save is waiting. Inside fast-forward and
+    // replay the journal is mid-record, so the copy waits for the next batch
+    if (!m_capture_requested.load(std::memory_order_acquire) || m_journal_muted) return;
+
+    const EngineProfiler::Stamp start = m_profiler.mark();
+    {
+        std::lock_guard<std::mutex> lock(m_capture_mutex);
+        if (!m_capture_requested.load(std::memory_order_relaxed)) return;   // Timed out
+
+        if (m_capture_compact) {
+            beginCompaction();
+        }
+        copySnapshotState(m_state, m_save_state);
+        m_save_engine = engineSection();
+        m_capture_requested.store(false, std::memory_order_relaxed);
+    }
+    m_capture_done.notify_all();
+    m_profiler.lapSince(ProfileSlot::SaveCapture, start);
+}
+
+bool ReptileEngine::exportText(const char* filepath)
 {
     FILE* f = fopen(filepath, "w");
     if (!f) return false;
 
     // Save game state
-    fprintf(f, "GAME=%lu,%.2f,%.2f,%.2f,%d\n",
+    fprintf(f, "GAME=%" PRIu32 ",%.2f,%.2f,%.2f,%d\n",
             m_state.game_day,
             m_state.game_time_hours,
             m_state.external_temperature,
@@ -296,8 +932,9 @@ bool ReptileEngine::saveGame(const char* filepath)
             m_state.economy.veterinary_cost);
 
     // Save reptiles
-    for (const auto& r : m_state.reptiles) {
-        fprintf(f, "REPTILE=%lu,%s,%s,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%d,%d,%d,%lu\n",
+    for (size_t i = 0; i < m_state.reptiles.size(); i++) {
+        const Reptile r = m_state.reptiles.get(i);
+        fprintf(f, "REPTILE=%" PRIu32 ",%s,%s,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%d,%d,%d,%" PRIu32 "\n",
                 r.id,
                 r.name.c_str(),
                 r.species.c_str(),
@@ -314,8 +951,9 @@ bool ReptileEngine::saveGame(const char* filepath)
     }
 
     // Save terrariums
-    for (const auto& t : m_state.terrariums) {
-        fprintf(f, "TERRARIUM=%lu,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%d,%d,%d\n",
+    for (size_t i = 0; i < m_state.terrariums.size(); i++) {
+        const Terrarium t = m_state.terrariums.get(i);
+        fprintf(f, "TERRARIUM=%" PRIu32 ",%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%d,%d,%d\n",
                 t.id,
                 t.width,
                 t.height,
@@ -335,7 +973,7 @@ bool ReptileEngine::saveGame(const char* filepath)
     return true;
 }
 
-bool ReptileEngine::loadGame(const char* filepath)
+bool ReptileEngine::importText(const char* filepath)
 {
     FILE* f = fopen(filepath, "r");
     if (!f) return false;
@@ -345,17 +983,23 @@ bool ReptileEngine::loadGame(const char* filepath)
     // Clear existing state
     m_state.reptiles.clear();
     m_state.terrariums.clear();
+    m_state.occupancy.clear();
 
     while (fgets(line, sizeof(line), f)) {
         if (strncmp(line, "GAME=", 5) == 0) {
             int heatwave;
-            sscanf(line + 5, "%lu,%f,%f,%f,%d",
+            sscanf(line + 5, "%" SCNu32 ",%f,%f,%f,%d",
                    &m_state.game_day,
                    &m_state.game_time_hours,
                    &m_state.external_temperature,
                    &m_state.external_humidity,
                    &heatwave);
             m_state.heatwave_active = (heatwave != 0);
+
+            // The file keeps day + hours; rebuild the integer clock from them
+            const uint64_t day_ms = (m_state.game_day > 0) ? (m_state.game_day - 1) * GAME_MS_PER_DAY : 0;
+            const uint64_t hours_ms = static_cast<uint64_t>(std::llround(m_state.game_time_hours * static_cast<double>(GAME_MS_PER_HOUR)));
+            m_state.setGameClock(day_ms + hours_ms);
         }
         else if (strncmp(line, "ECONOMY=", 8) == 0) {
             sscanf(line + 8, "%f,%f,%f,%f",
@@ -368,7 +1012,7 @@ bool ReptileEngine::loadGame(const char* filepath)
             Reptile r;
             char name[64], species[64];
             int healthy, hungry, shedding;
-            sscanf(line + 8, "%lu,%63[^,],%63[^,],%f,%f,%f,%f,%f,%f,%d,%d,%d,%lu",
+            sscanf(line + 8, "%" SCNu32 ",%63[^,],%63[^,],%f,%f,%f,%f,%f,%f,%d,%d,%d,%" SCNu32,
                    &r.id,
                    name,
                    species,
@@ -387,17 +1031,12 @@ bool ReptileEngine::loadGame(const char* filepath)
             r.is_healthy = (healthy != 0);
             r.is_hungry = (hungry != 0);
             r.is_shedding = (shedding != 0);
-            m_state.reptiles.push_back(r);
-
-            // Update next ID
-            if (r.id >= m_next_reptile_id) {
-                m_next_reptile_id = r.id + 1;
-            }
+            m_state.reptiles.append(r); // Duplicate ids are dropped
         }
         else if (strncmp(line, "TERRARIUM=", 10) == 0) {
             Terrarium t;
             int heater, light, mister;
-            sscanf(line + 10, "%lu,%f,%f,%f,%f,%f,%f,%f,%f,%f,%d,%d,%d",
+            sscanf(line + 10, "%" SCNu32 ",%f,%f,%f,%f,%f,%f,%f,%f,%f,%d,%d,%d",
                    &t.id,
                    &t.width,
                    &t.height,
@@ -414,155 +1053,916 @@ bool ReptileEngine::loadGame(const char* filepath)
             t.heater_on = (heater != 0);
             t.light_on = (light != 0);
             t.mister_on = (mister != 0);
-            m_state.terrariums.push_back(t);
-
-            // Update next ID
-            if (t.id >= m_next_terrarium_id) {
-                m_next_terrarium_id = t.id + 1;
-            }
+            m_state.terrariums.append(t); // Duplicate ids are dropped
         }
     }
 
+    rebuildOccupancy();
+
     fclose(f);
     return true;
 }
 
 // ====================================================================================
-// EQUIPMENT CONTROL
+// JOURNALED AUTOSAVE
 // ====================================================================================
 
-void ReptileEngine::setHeater(uint32_t terrarium_id, bool on)
+namespace {
+
+// SNAP_ENGINE payload: engine state a replayed journal depends on
+struct EngineSection {
+    uint64_t journal_generation;
+    uint32_t random_state;          // Technical failure stream
+    uint32_t engine_count;          // SimEngine::Count when written
+    struct Schedule {
+        uint64_t slot;
+        uint32_t period;
+        uint32_t phase;
+        float pending_dt;
+        uint32_t reserved;
+    } schedule[static_cast<size_t>(SimEngine::Count)];
+};
+static_assert(sizeof(EngineSection) == 16 + 24 * static_cast<size_t>(SimEngine::Count), "on-disk layout");
+
+// Fixed part of a record payload; false if the record is too short
+template <typename T>
+bool readPayload(const uint8_t* payload, uint32_t length, T& out)
 {
-    for (auto& terra : m_state.terrariums) {
-        if (terra.id == terrarium_id) {
-            terra.heater_on = on;
-            break;
-        }
-    }
+    if (length < sizeof(T)) return false;
+    memcpy(&out, payload, sizeof(T));
+    return true;
 }
 
-void ReptileEngine::setLight(uint32_t terrarium_id, bool on)
+} // namespace
+
+std::vector<uint8_t> ReptileEngine::engineSection() const
+{
+    EngineSection section = {};
+    section.journal_generation = m_journal_generation;
+    section.random_state = technicalRandomState();
+    section.engine_count = static_cast<uint32_t>(SimEngine::Count);
+    for (size_t e = 0; e < static_cast<size_t>(SimEngine::Count); e++) {
+        section.schedule[e].slot = m_schedule[e].slot;
+        section.schedule[e].period = m_schedule[e].period;
+        section.schedule[e].phase = m_schedule[e].phase;
+        section.schedule[e].pending_dt = m_schedule[e].pending_dt;
+    }
+
+    std::vector<uint8_t> bytes(sizeof(section));
+    memcpy(bytes.data(), &section, sizeof(section));
+    return bytes;
+}
+
+void ReptileEngine::restoreEngineSection(const std::vector<uint8_t>& bytes)
+{
+    // Snapshots without one (older saves) keep the current periods, on the
+    // loaded clock
+    seedEngineSlots();
+    EngineSection section;
+    if (bytes.size() != sizeof(section)) return;
+    memcpy(&section, bytes.data(), sizeof(section));
+    if (section.engine_count != static_cast<uint32_t>(SimEngine::Count)) return;
+
+    m_journal_generation = section.journal_generation;
+    setTechnicalRandomState(section.random_state);
+    for (size_t e = 0; e < static_cast<size_t>(SimEngine::Count); e++) {
+        const EngineSection::Schedule& in = section.schedule[e];
+        if (in.period == 0 || in.phase >= in.period) continue;
+        m_schedule[e].slot = in.slot;
+        m_schedule[e].period = in.period;
+        m_schedule[e].phase = in.phase;
+        m_schedule[e].pending_dt = in.pending_dt;
+    }
+}
+
+bool ReptileEngine::startJournal(const char* snapshot_path, const char* journal_path)
 {
-    for (auto& terra : m_state.terrariums) {
-        if (terra.id == terrarium_id) {
-            terra.light_on = on;
-            break;
+    stopJournal();
+    m_journal_snapshot = snapshot_path;
+    m_journal_path = journal_path;
+    if (compactJournal()) return true;
+
+    m_journal_snapshot.clear();
+    m_journal_path.clear();
+    return false;
+}
+
+bool ReptileEngine::recoverJournal(const char* snapshot_path, const char* journal_path)
+{
+    stopJournal();
+    if (!loadState(snapshot_path)) return false;
+    m_journal_snapshot = snapshot_path;
+    m_journal_path = journal_path;
+
+    // Only a journal written on top of exactly this snapshot applies
+    JournalReader reader;
+    const bool matches = reader.open(journal_path) &&
+                         reader.header().generation == m_journal_generation &&
+                         reader.header().base_clock_ms == m_state.game_clock_ms;
+
+    uint32_t records = 0;
+    uint64_t ticks = 0;
+    bool clean = matches;
+    if (matches) {
+        m_journal_muted = true;
+        JournalOp op;
+        const uint8_t* payload;
+        uint32_t length;
+        while (reader.next(op, payload, length)) {
+            if (!replayRecord(op, payload, length, ticks)) {
+                clean = false;
+                break;
+            }
+            records++;
         }
+        m_journal_muted = false;
+        clean = clean && reader.atCleanEnd();
     }
+
+    if (clean) {
+        m_journal.resume(journal_path, m_journal_generation, reader.validBytes(), records, ticks);
+    } else if (records == 0) {
+        // Nothing applied: the state is the snapshot's
+        m_journal.cut(journal_path, m_journal_generation, m_state.game_clock_ms);
+        m_journal.commitCut();
+    } else {
+        // Appending after a torn record would hide everything behind it
+        compactJournal();
+    }
+    return true;
 }
 
-void ReptileEngine::setMister(uint32_t terrarium_id, bool on)
+bool ReptileEngine::flushJournal()
+{
+    return m_journal.flush();
+}
+
+bool ReptileEngine::compactJournal()
+{
+    if (!isJournaling()) return false;
+
+    beginCompaction();
+    return finishCompaction(saveGame(m_journal_snapshot.c_str()));
+}
+
+bool ReptileEngine::compactJournalBackground(uint32_t timeout_ms)
+{
+    if (!isJournaling()) return false;
+    return saveBackground(m_journal_snapshot, true, timeout_ms);
+}
+
+void ReptileEngine::beginCompaction()
+{
+    // Generations only need to differ, so a failed snapshot's is not reused
+    m_journal_generation++;
+    m_journal.cut(m_journal_path.c_str(), m_journal_generation, m_state.game_clock_ms);
+}
+
+bool ReptileEngine::finishCompaction(bool saved)
+{
+    // Snapshot first: until the new journal exists, the old one no longer
+    // matches the new snapshot and is ignored, which loses nothing
+    if (!saved) {
+        m_journal.cancelCut();
+        return false;
+    }
+    return m_journal.commitCut();
+}
+
+void ReptileEngine::stopJournal()
+{
+    m_journal.flush();
+    m_journal.close();
+    m_journal_snapshot.clear();
+    m_journal_path.clear();
+}
+
+void ReptileEngine::recordEquipment(uint32_t terrarium_id, uint8_t flag, bool on)
+{
+    if (journaling()) {
+        JournalEquipment rec = {};
+        rec.terrarium_id = terrarium_id;
+        rec.flag = flag;
+        rec.on = on ? 1 : 0;
+        m_journal.record(JournalOp::Equipment, &rec, sizeof(rec));
+    }
+}
+
+bool ReptileEngine::replayRecord(JournalOp op, const uint8_t* payload, uint32_t length, uint64_t& ticks)
 {
-    for (auto& terra : m_state.terrariums) {
-        if (terra.id == terrarium_id) {
-            terra.mister_on = on;
-            break;
+    // Every record describes a call that succeeded live, so one that fails
+    // now means the journal does not belong to this state
+    switch (op) {
+        case JournalOp::Ticks: {
+            JournalTicks rec;
+            if (!readPayload(payload, length, rec)) return false;
+            tickBatch(rec.steps, rec.dt);
+            ticks += rec.steps;
+            return true;
+        }
+        case JournalOp::FastForward: {
+            JournalFastForward rec;
+            if (!readPayload(payload, length, rec)) return false;
+            fastForward(rec.game_seconds);
+            return true;
+        }
+        case JournalOp::AddReptile: {
+            JournalAddReptile rec;
+            if (!readPayload(payload, length, rec)) return false;
+            const uint64_t chars = static_cast<uint64_t>(rec.name_length) + rec.species_length;
+            if (rec.id == 0 || length - sizeof(rec) != chars) return false;
+            const char* name = reinterpret_cast<const char*>(payload + sizeof(rec));
+            return insertReptile(rec.id, std::string(name, rec.name_length),
+                                 std::string(name + rec.name_length, rec.species_length)) == rec.id;
+        }
+        case JournalOp::AddTerrarium: {
+            JournalAddTerrarium rec;
+            if (!readPayload(payload, length, rec) || rec.id == 0) return false;
+            return insertTerrarium(rec.id, rec.width, rec.height, rec.depth) == rec.id;
+        }
+        case JournalOp::RemoveReptile: {
+            JournalId rec;
+            return readPayload(payload, length, rec) && removeReptile(rec.id);
+        }
+        case JournalOp::RemoveTerrarium: {
+            JournalId rec;
+            return readPayload(payload, length, rec) && removeTerrarium(rec.id);
+        }
+        case JournalOp::Assign: {
+            JournalAssign rec;
+            return readPayload(payload, length, rec) && assignReptile(rec.reptile_id, rec.terrarium_id);
+        }
+        case JournalOp::Feed: {
+            JournalId rec;
+            if (!readPayload(payload, length, rec) || m_state.reptiles.indexOf(rec.id) == ReptileStore::npos) {
+                return false;
+            }
+            feedAnimal(rec.id);
+            return true;
+        }
+        case JournalOp::Clean: {
+            JournalId rec;
+            if (!readPayload(payload, length, rec) || m_state.terrariums.indexOf(rec.id) == TerrariumStore::npos) {
+                return false;
+            }
+            cleanTerrarium(rec.id);
+            return true;
+        }
+        case JournalOp::Equipment: {
+            JournalEquipment rec;
+            if (!readPayload(payload, length, rec)) return false;
+            const size_t i = m_state.terrariums.indexOf(rec.terrarium_id);
+            if (i == TerrariumStore::npos) return false;
+            m_state.terrariums.setEquipment(i, rec.flag, rec.on != 0);
+            return true;
+        }
+        case JournalOp::EnginePeriod: {
+            JournalEnginePeriod rec;
+            return readPayload(payload, length, rec) &&
+                   setEnginePeriod(static_cast<SimEngine>(rec.engine), rec.period, rec.phase);
         }
     }
+    return false;
 }
 
 // ====================================================================================
-// STATE GETTERS
+// BULK IMPORT / EXPORT
 // ====================================================================================
 
-float ReptileEngine::getTerrariumTemp(uint32_t terrarium_id) const
+namespace {
+
+// Reptile rows handed to insertReptiles() per batch while importing
+constexpr size_t IMPORT_BATCH_ROWS = 8192;
+
+// Reserve for `count` more entities, growing by at least half, so a run of
+// small batches does not reallocate every column each time
+template <typename Store>
+void reserveMore(Store& store, size_t count)
 {
-    for (const auto& terra : m_state.terrariums) {
-        if (terra.id == terrarium_id) {
-            return terra.temp_hot_zone;
-        }
+    const size_t needed = store.size() + count;
+    const size_t capacity = store.id.capacity();
+    if (needed > capacity) {
+        store.reserve(std::max(needed, capacity + capacity / 2));
     }
-    return 0.0f;
 }
 
-float ReptileEngine::getTerrariumHumidity(uint32_t terrarium_id) const
+// Parsed reptile row; its strings wait in the batch arena
+struct PendingReptile {
+    size_t name_at;
+    size_t species_at;
+    uint32_t name_length;
+    uint32_t species_length;
+    uint32_t terrarium_id;
+    float weight_grams;
+    uint32_t line;
+};
+
+void reject(CsvImportReport& report, const char* file, uint32_t line, const char* message)
+{
+    report.rejected++;
+    if (report.errors.size() < CSV_MAX_REPORTED_ERRORS) {
+        report.errors.push_back({file, line, message});
+    }
+}
+
+} // namespace
+
+size_t ReptileEngine::addReptiles(const ReptileRow* rows, size_t count, uint32_t* out_ids)
+{
+    const size_t added = insertReptiles(rows, count, out_ids);
+    bulkAdded(added);
+    return added;
+}
+
+size_t ReptileEngine::addTerrariums(const TerrariumRow* rows, size_t count, uint32_t* out_ids)
+{
+    const size_t added = insertTerrariums(rows, count, out_ids);
+    bulkAdded(added);
+    return added;
+}
+
+size_t ReptileEngine::insertReptiles(const ReptileRow* rows, size_t count, uint32_t* out_ids)
 {
-    for (const auto& terra : m_state.terrariums) {
-        if (terra.id == terrarium_id) {
-            return terra.humidity;
+    ReptileStore& reptiles = m_state.reptiles;
+    reserveMore(reptiles, count);
+
+    const Reptile defaults = newReptile();
+    Reptile r = defaults;
+    size_t added = 0;
+    for (size_t k = 0; k < count; k++) {
+        const ReptileRow& row = rows[k];
+        if (out_ids) out_ids[k] = 0;
+
+        uint32_t t = OccupancyIndex::UNASSIGNED;
+        if (row.terrarium_id != 0) {
+            t = m_state.terrariums.index.find(row.terrarium_id);
+            if (t == SlotMap::INVALID) continue;
         }
+
+        r.id = 0;
+        r.name.assign(row.name.data(), row.name.size());
+        r.species.assign(row.species.data(), row.species.size());
+        r.weight_grams = (row.weight_grams > 0.0f) ? row.weight_grams : defaults.weight_grams;
+        r.assigned_terrarium_id = row.terrarium_id;
+
+        const size_t i = reptiles.append(r);
+        if (i == ReptileStore::npos) continue;
+        reptiles.terrarium_index[i] = t;
+        m_state.occupancy.addReptile(static_cast<uint32_t>(i), t);
+        m_changes.touch(r.id);
+        if (out_ids) out_ids[k] = r.id;
+        added++;
     }
-    return 0.0f;
+
+    if (added > 0) m_wake_all = true;
+    return added;
 }
 
-float ReptileEngine::getTerrariumWaste(uint32_t terrarium_id) const
+size_t ReptileEngine::insertTerrariums(const TerrariumRow* rows, size_t count, uint32_t* out_ids)
 {
-    for (const auto& terra : m_state.terrariums) {
-        if (terra.id == terrarium_id) {
-            return terra.waste_level;
+    reserveMore(m_state.terrariums, count);
+
+    size_t added = 0;
+    for (size_t k = 0; k < count; k++) {
+        Terrarium t = newTerrarium(rows[k].width, rows[k].height, rows[k].depth);
+        const bool ok = m_state.terrariums.append(t) != TerrariumStore::npos;
+        if (ok) {
+            m_state.occupancy.addTerrarium();
+            added++;
         }
+        if (out_ids) out_ids[k] = ok ? t.id : 0;
     }
-    return 0.0f;
+
+    if (added > 0) m_wake_all = true;
+    return added;
 }
 
-bool ReptileEngine::getHeaterState(uint32_t terrarium_id) const
+void ReptileEngine::bulkAdded(size_t added)
 {
-    for (const auto& terra : m_state.terrariums) {
-        if (terra.id == terrarium_id) {
-            return terra.heater_on;
+    // One snapshot is smaller and faster to replay than a record per row
+    if (added > 0 && journaling()) {
+        compactJournal();
+    }
+}
+
+bool ReptileEngine::importHerdCsv(const char* terrariums_path, const char* reptiles_path, CsvImportReport* report)
+{
+    CsvImportReport local;
+    CsvImportReport& out = report ? *report : local;
+    out = CsvImportReport();
+
+    // Both files are read and checked before anything is added, so a false
+    // return leaves the game as it was and the import can simply be retried
+    CsvReader terra_csv;
+    CsvReader reptile_csv;
+    std::vector<std::string_view> fields;
+
+    int c_id = -1, c_width = -1, c_height = -1, c_depth = -1;
+    size_t terra_columns = 0;
+    if (terrariums_path) {
+        if (!terra_csv.open(terrariums_path) || !terra_csv.next(fields)) return false;
+        c_id = csvColumn(fields, "id");
+        c_width = csvColumn(fields, "width");
+        c_height = csvColumn(fields, "height");
+        c_depth = csvColumn(fields, "depth");
+        if (c_width < 0 || c_height < 0 || c_depth < 0) return false;
+        terra_columns = static_cast<size_t>(std::max({c_id, c_width, c_height, c_depth})) + 1;
+    }
+
+    int c_name = -1, c_species = -1, c_terrarium = -1, c_weight = -1;
+    size_t reptile_columns = 0;
+    if (reptiles_path) {
+        if (!reptile_csv.open(reptiles_path) || !reptile_csv.next(fields)) return false;
+        c_name = csvColumn(fields, "name");
+        c_species = csvColumn(fields, "species");
+        c_terrarium = csvColumn(fields, "terrarium_id");
+        c_weight = csvColumn(fields, "weight_grams");
+        if (c_name < 0 || c_species < 0) return false;
+        reptile_columns = static_cast<size_t>(std::max({c_name, c_species, c_terrarium, c_weight})) + 1;
+    }
+
+    // Terrariums: file ids are mapped to new ids once they are added
+    std::unordered_map<uint32_t, uint32_t> file_terrariums;    // File id -> new id
+    std::vector<TerrariumRow> terra_rows;
+    std::vector<uint32_t> file_ids;
+    std::vector<uint32_t> terra_lines;
+    if (terrariums_path) {
+        while (terra_csv.next(fields)) {
+            TerrariumRow row;
+            uint32_t file_id = 0;
+            const char* error = nullptr;
+            if (fields.size() < terra_columns) {
+                error = "missing fields";
+            } else if (!parseCsvNumber(fields[c_width], row.width) || !parseCsvNumber(fields[c_height], row.height) ||
+                       !parseCsvNumber(fields[c_depth], row.depth)) {
+                error = "bad dimension";
+            } else if (row.width <= 0.0f || row.height <= 0.0f || row.depth <= 0.0f) {
+                error = "dimensions must be positive";
+            } else if (c_id >= 0 && (!parseCsvNumber(fields[c_id], file_id) || file_id == 0)) {
+                error = "bad id";
+            } else if (file_id != 0 && !file_terrariums.emplace(file_id, 0).second) {
+                error = "duplicate id";
+            }
+            if (error) {
+                reject(out, "terrariums", terra_csv.line(), error);
+                continue;
+            }
+            terra_rows.push_back(row);
+            file_ids.push_back(file_id);
+            terra_lines.push_back(terra_csv.line());
         }
+        if (terra_csv.failed()) return false;
     }
-    return false;
+
+    // Reptiles: parsed whole, strings in one arena; with a terrarium file
+    // terrarium_id stays the file id until the terrariums are added
+    std::vector<PendingReptile> pending;
+    std::string arena;
+    if (reptiles_path) {
+        while (reptile_csv.next(fields)) {
+            PendingReptile p = {};
+            p.line = reptile_csv.line();
+            const char* error = nullptr;
+            if (fields.size() < reptile_columns) {
+                error = "missing fields";
+            } else if (trimSpaces(fields[c_name]).empty()) {
+                error = "empty name";
+            } else if (c_terrarium >= 0 && !trimSpaces(fields[c_terrarium]).empty() &&
+                       !parseCsvNumber(fields[c_terrarium], p.terrarium_id)) {
+                error = "bad terrarium_id";
+            } else if (c_weight >= 0 && !trimSpaces(fields[c_weight]).empty() &&
+                       (!parseCsvNumber(fields[c_weight], p.weight_grams) || p.weight_grams <= 0.0f)) {
+                error = "bad weight_grams";
+            }
+
+            if (!error && p.terrarium_id != 0) {
+                if (terrariums_path) {
+                    if (file_terrariums.find(p.terrarium_id) == file_terrariums.end()) error = "unknown terrarium_id";
+                } else if (m_state.terrariums.index.find(p.terrarium_id) == SlotMap::INVALID) {
+                    error = "unknown terrarium_id";
+                }
+            }
+            if (error) {
+                reject(out, "reptiles", p.line, error);
+                continue;
+            }
+
+            const std::string_view name = trimSpaces(fields[c_name]);
+            const std::string_view species = trimSpaces(fields[c_species]);
+            p.name_at = arena.size();
+            p.name_length = static_cast<uint32_t>(name.size());
+            arena.append(name.data(), name.size());
+            p.species_at = arena.size();
+            p.species_length = static_cast<uint32_t>(species.size());
+            arena.append(species.data(), species.size());
+            pending.push_back(p);
+        }
+        if (reptile_csv.failed()) return false;
+    }
+
+    // Nothing below can fail the import; rows can still be refused one by one
+    size_t added = 0;
+    if (!terra_rows.empty()) {
+        std::vector<uint32_t> ids(terra_rows.size());
+        added += insertTerrariums(terra_rows.data(), terra_rows.size(), ids.data());
+        for (size_t k = 0; k < terra_rows.size(); k++) {
+            if (ids[k] == 0) {
+                reject(out, "terrariums", terra_lines[k], "terrarium limit reached");
+            } else {
+                out.terrariums++;
+            }
+            if (file_ids[k] != 0) file_terrariums[file_ids[k]] = ids[k];
+        }
+    }
+
+    if (!pending.empty()) {
+        reserveMore(m_state.reptiles, pending.size());
+        std::vector<ReptileRow> rows;
+        std::vector<uint32_t> lines;
+        std::vector<uint32_t> ids;
+        for (size_t begin = 0; begin < pending.size(); begin += IMPORT_BATCH_ROWS) {
+            const size_t end = std::min(pending.size(), begin + IMPORT_BATCH_ROWS);
+            rows.clear();
+            lines.clear();
+            for (size_t k = begin; k < end; k++) {
+                const PendingReptile& p = pending[k];
+                uint32_t terrarium_id = p.terrarium_id;
+                if (terrariums_path && terrarium_id != 0) {
+                    terrarium_id = file_terrariums[terrarium_id];
+                    if (terrarium_id == 0) {
+                        reject(out, "reptiles", p.line, "unknown terrarium_id");
+                        continue;
+                    }
+                }
+                rows.push_back({std::string_view(arena.data() + p.name_at, p.name_length),
+                                std::string_view(arena.data() + p.species_at, p.species_length), terrarium_id,
+                                p.weight_grams});
+                lines.push_back(p.line);
+            }
+            ids.resize(rows.size());
+            const size_t n = insertReptiles(rows.data(), rows.size(), ids.data());
+            added += n;
+            out.reptiles += static_cast<uint32_t>(n);
+            for (size_t k = 0; k < rows.size(); k++) {
+                if (ids[k] == 0) reject(out, "reptiles", lines[k], "reptile limit reached");
+            }
+        }
+    }
+
+    bulkAdded(added);
+    return true;
 }
 
-bool ReptileEngine::getLightState(uint32_t terrarium_id) const
+bool ReptileEngine::exportHerdCsv(const char* terrariums_path, const char* reptiles_path) const
 {
-    for (const auto& terra : m_state.terrariums) {
-        if (terra.id == terrarium_id) {
-            return terra.light_on;
+    CsvWriter csv;
+    if (terrariums_path) {
+        const TerrariumStore& terra = m_state.terrariums;
+        if (!csv.open(terrariums_path)) return false;
+        for (const char* column : {"id", "width", "height", "depth", "temp_hot_zone", "temp_cold_zone", "humidity",
+                                   "uv_index", "waste_level", "bacteria_count", "heater", "light", "mister"}) {
+            csv.field(std::string_view(column));
+        }
+        csv.endRow();
+        for (size_t i = 0; i < terra.size(); i++) {
+            csv.field(terra.id[i]);
+            csv.field(terra.width[i]);
+            csv.field(terra.height[i]);
+            csv.field(terra.depth[i]);
+            csv.field(terra.temp_hot_zone[i]);
+            csv.field(terra.temp_cold_zone[i]);
+            csv.field(terra.humidity[i]);
+            csv.field(terra.uv_index[i]);
+            csv.field(terra.waste_level[i]);
+            csv.field(terra.bacteria_count[i]);
+            csv.field(static_cast<uint32_t>(terra.hasEquipment(i, EQUIP_HEATER)));
+            csv.field(static_cast<uint32_t>(terra.hasEquipment(i, EQUIP_LIGHT)));
+            csv.field(static_cast<uint32_t>(terra.hasEquipment(i, EQUIP_MISTER)));
+            csv.endRow();
         }
+        if (!csv.close()) return false;
+    }
+
+    if (reptiles_path) {
+        const ReptileStore& reptiles = m_state.reptiles;
+        if (!csv.open(reptiles_path)) return false;
+        for (const char* column : {"id", "name", "species", "terrarium_id", "weight_grams", "bone_density",
+                                   "hydration", "stress_level", "stomach_content", "immune_system", "healthy",
+                                   "hungry", "shedding"}) {
+            csv.field(std::string_view(column));
+        }
+        csv.endRow();
+        for (size_t i = 0; i < reptiles.size(); i++) {
+            csv.field(reptiles.id[i]);
+            csv.field(std::string_view(reptiles.name[i]));
+            csv.field(std::string_view(reptiles.species[i]));
+            csv.field(reptiles.assigned_terrarium_id[i]);
+            csv.field(reptiles.weight_grams[i]);
+            csv.field(reptiles.bone_density[i]);
+            csv.field(reptiles.hydration[i]);
+            csv.field(reptiles.stress_level[i]);
+            csv.field(reptiles.stomach_content[i]);
+            csv.field(reptiles.immune_system[i]);
+            csv.field(static_cast<uint32_t>(reptiles.hasFlag(i, REPTILE_FLAG_HEALTHY)));
+            csv.field(static_cast<uint32_t>(reptiles.hasFlag(i, REPTILE_FLAG_HUNGRY)));
+            csv.field(static_cast<uint32_t>(reptiles.hasFlag(i, REPTILE_FLAG_SHEDDING)));
+            csv.endRow();
+        }
+        if (!csv.close()) return false;
+    }
+    return true;
+}
+
+// ====================================================================================
+// EQUIPMENT CONTROL
+// ====================================================================================
+
+void ReptileEngine::setHeater(uint32_t terrarium_id, bool on)
+{
+    size_t i = m_state.terrariums.indexOf(terrarium_id);
+    if (i != TerrariumStore::npos) {
+        m_state.terrariums.setEquipment(i, EQUIP_HEATER, on);
+        recordEquipment(terrarium_id, EQUIP_HEATER, on);
+    }
+}
+
+void ReptileEngine::setLight(uint32_t terrarium_id, bool on)
+{
+    size_t i = m_state.terrariums.indexOf(terrarium_id);
+    if (i != TerrariumStore::npos) {
+        m_state.terrariums.setEquipment(i, EQUIP_LIGHT, on);
+        recordEquipment(terrarium_id, EQUIP_LIGHT, on);
+    }
+}
+
+void ReptileEngine::setMister(uint32_t terrarium_id, bool on)
+{
+    size_t i = m_state.terrariums.indexOf(terrarium_id);
+    if (i != TerrariumStore::npos) {
+        m_state.terrariums.setEquipment(i, EQUIP_MISTER, on);
+        recordEquipment(terrarium_id, EQUIP_MISTER, on);
     }
-    return false;
+}
+
+// ====================================================================================
+// STATE GETTERS
+// ====================================================================================
+
+float ReptileEngine::getTerrariumTemp(uint32_t terrarium_id) const
+{
+    size_t i = m_state.terrariums.indexOf(terrarium_id);
+    return (i != TerrariumStore::npos) ? m_state.terrariums.temp_hot_zone[i] : 0.0f;
+}
+
+float ReptileEngine::getTerrariumHumidity(uint32_t terrarium_id) const
+{
+    size_t i = m_state.terrariums.indexOf(terrarium_id);
+    return (i != TerrariumStore::npos) ? m_state.terrariums.humidity[i] : 0.0f;
+}
+
+float ReptileEngine::getTerrariumWaste(uint32_t terrarium_id) const
+{
+    size_t i = m_state.terrariums.indexOf(terrarium_id);
+    return (i != TerrariumStore::npos) ? m_state.terrariums.waste_level[i] : 0.0f;
+}
+
+bool ReptileEngine::getHeaterState(uint32_t terrarium_id) const
+{
+    size_t i = m_state.terrariums.indexOf(terrarium_id);
+    return (i != TerrariumStore::npos) ? m_state.terrariums.hasEquipment(i, EQUIP_HEATER) : false;
+}
+
+bool ReptileEngine::getLightState(uint32_t terrarium_id) const
+{
+    size_t i = m_state.terrariums.indexOf(terrarium_id);
+    return (i != TerrariumStore::npos) ? m_state.terrariums.hasEquipment(i, EQUIP_LIGHT) : false;
 }
 
 bool ReptileEngine::getMisterState(uint32_t terrarium_id) const
 {
-    for (const auto& terra : m_state.terrariums) {
-        if (terra.id == terrarium_id) {
-            return terra.mister_on;
-        }
+    size_t i = m_state.terrariums.indexOf(terrarium_id);
+    return (i != TerrariumStore::npos) ? m_state.terrariums.hasEquipment(i, EQUIP_MISTER) : false;
+}
+
+int ReptileEngine::getTerrariumOccupantCount(uint32_t terrarium_id) const
+{
+    uint32_t t = m_state.terrariums.index.find(terrarium_id);
+    return (t != SlotMap::INVALID) ? static_cast<int>(m_state.occupancy.count(t)) : 0;
+}
+
+int ReptileEngine::getTerrariumOccupants(uint32_t terrarium_id, uint32_t* out_ids, int max_ids) const
+{
+    uint32_t t = m_state.terrariums.index.find(terrarium_id);
+    if (t == SlotMap::INVALID || !out_ids) return 0;
+
+    const uint32_t* members = m_state.occupancy.members(t);
+    int count = static_cast<int>(m_state.occupancy.count(t));
+    if (count > max_ids) count = max_ids;
+    for (int j = 0; j < count; j++) {
+        out_ids[j] = m_state.reptiles.id[members[j]];
     }
-    return false;
+    return count;
 }
 
 float ReptileEngine::getReptileStress(uint32_t reptile_id) const
 {
-    for (const auto& reptile : m_state.reptiles) {
-        if (reptile.id == reptile_id) {
-            return reptile.stress_level;
-        }
-    }
-    return 0.0f;
+    size_t i = m_state.reptiles.indexOf(reptile_id);
+    return (i != ReptileStore::npos) ? m_state.reptiles.stress_level[i] : 0.0f;
 }
 
 float ReptileEngine::getReptileWeight(uint32_t reptile_id) const
 {
-    for (const auto& reptile : m_state.reptiles) {
-        if (reptile.id == reptile_id) {
-            return reptile.weight_grams;
-        }
-    }
-    return 0.0f;
+    size_t i = m_state.reptiles.indexOf(reptile_id);
+    return (i != ReptileStore::npos) ? m_state.reptiles.weight_grams[i] : 0.0f;
 }
 
 bool ReptileEngine::isReptileHungry(uint32_t reptile_id) const
 {
-    for (const auto& reptile : m_state.reptiles) {
-        if (reptile.id == reptile_id) {
-            return reptile.is_hungry;
+    size_t i = m_state.reptiles.indexOf(reptile_id);
+    return (i != ReptileStore::npos) ? m_state.reptiles.hasFlag(i, REPTILE_FLAG_HUNGRY) : false;
+}
+
+bool ReptileEngine::isReptileHealthy(uint32_t reptile_id) const
+{
+    size_t i = m_state.reptiles.indexOf(reptile_id);
+    return (i != ReptileStore::npos) ? m_state.reptiles.hasFlag(i, REPTILE_FLAG_HEALTHY) : false;
+}
+
+namespace {
+
+// Fused stages for one terrarium's occupants. A bucket with nobody awake
+// whose inputs have not moved is skipped without touching its reptiles.
+uint32_t settleTerrarium(ReptileStore& reptiles, const TerrariumStore& terra,
+                         const OccupancyIndex& occupancy, uint32_t t,
+                         ReptileEngine::BucketRest& rest, const StageContext& ctx, bool wake_all)
+{
+    const uint32_t count = occupancy.count(t);
+    const ReptileEngine::BucketInputs inputs = {
+        terra.temp_hot_zone[t], count, static_cast<uint8_t>(terra.equipment[t] & EQUIP_LIGHT)};
+
+    const bool same = !wake_all && rest.inputs == inputs;
+    if (same && rest.awake == 0) return 0;
+
+    rest.inputs = inputs;
+    rest.awake = settleBucket(reptiles, occupancy.members(t), 0, count, ctx, same);
+    return rest.awake;
+}
+
+} // namespace
+
+void ReptileEngine::updateFusedReptiles(float dt)
+{
+    ReptileStore& reptiles = m_state.reptiles;
+    const OccupancyIndex& occupancy = m_state.occupancy;
+
+    StageContext ctx = {&m_state.terrariums, &occupancy, dt, false, false};
+    seasonalContext(m_state, ctx.brumation_season, ctx.should_be_dark);
+    const bool wake_all = beginSettle(ctx);
+
+    // Terrarium by terrarium, so each enclosure's columns stay hot while its
+    // occupants run; reptiles are independent, so visiting order is free
+    uint32_t awake = 0;
+    const uint32_t terrarium_count = static_cast<uint32_t>(m_state.terrariums.size());
+    for (uint32_t t = 0; t < terrarium_count; t++) {
+        awake += settleTerrarium(reptiles, m_state.terrariums, occupancy, t, m_rest[t], ctx, wake_all);
+    }
+
+    // Unassigned reptiles read nothing but the context
+    BucketRest& homeless = m_rest.back();
+    if (wake_all || homeless.awake > 0) {
+        homeless.awake = settleBucket(reptiles, occupancy.members(OccupancyIndex::UNASSIGNED), 0,
+                                      occupancy.count(OccupancyIndex::UNASSIGNED), ctx, !wake_all);
+    }
+    awake += homeless.awake;
+
+    m_sleep_stats = {awake, static_cast<uint32_t>(reptiles.size()) - awake};
+}
+
+// ====================================================================================
+// PARALLEL TICK
+// ====================================================================================
+
+namespace {
+
+// Per-tick inputs for ReptileEngine::runChunk
+struct ParallelJob {
+    GameState* state;
+    const std::vector<ReptileEngine::TickChunk>* chunks;
+    std::vector<ReptileEngine::ChunkTotals>* totals;
+    std::vector<ReptileEngine::BucketRest>* rest;   // Each chunk owns its terrariums' entries
+    StageContext ctx;
+    bool daytime;
+    bool wake_all;
+};
+
+} // namespace
+
+void ReptileEngine::planChunks()
+{
+    const OccupancyIndex& occupancy = m_state.occupancy;
+    const uint32_t terrarium_count = static_cast<uint32_t>(m_state.terrariums.size());
+
+    // Cut after enough terrariums + occupants. Boundaries depend only on the
+    // state, never on the number of workers.
+    m_chunks.clear();
+    uint32_t begin = 0;
+    uint32_t work = 0;
+    for (uint32_t t = 0; t < terrarium_count; t++) {
+        work += 1 + occupancy.count(t);
+        if (work >= PARALLEL_CHUNK_WORK) {
+            m_chunks.push_back({begin, t + 1, 0, 0});
+            begin = t + 1;
+            work = 0;
         }
     }
-    return false;
+    if (begin < terrarium_count) {
+        m_chunks.push_back({begin, terrarium_count, 0, 0});
+    }
+
+    // Unassigned reptiles touch no terrarium; split them separately
+    const uint32_t homeless = occupancy.count(OccupancyIndex::UNASSIGNED);
+    for (uint32_t h = 0; h < homeless; h += PARALLEL_CHUNK_WORK) {
+        const uint32_t end = (homeless - h > PARALLEL_CHUNK_WORK) ? h + PARALLEL_CHUNK_WORK : homeless;
+        m_chunks.push_back({0, 0, h, end});
+    }
+
+    m_chunk_totals.resize(m_chunks.size());
 }
 
-bool ReptileEngine::isReptileHealthy(uint32_t reptile_id) const
+void ReptileEngine::runChunk(void* job, uint32_t c)
 {
-    for (const auto& reptile : m_state.reptiles) {
-        if (reptile.id == reptile_id) {
-            return reptile.is_healthy;
+    ParallelJob& p = *static_cast<ParallelJob*>(job);
+    const TickChunk& chunk = (*p.chunks)[c];
+    TerrariumStore& terra = p.state->terrariums;
+    ReptileStore& reptiles = p.state->reptiles;
+    const OccupancyIndex& occupancy = p.state->occupancy;
+    const StageContext& ctx = p.ctx;
+
+    ChunkTotals totals = {0, 0, 0};
+
+    // Physics for the chunk's terrariums, then their occupants, then
+    // sanitary; a reptile only reads its own terrarium, so this matches the
+    // serial order
+    physicsKernel(terra, chunk.terra_begin, chunk.terra_end, ctx.dt,
+                  p.daytime, p.state->external_temperature);
+
+    for (uint32_t t = chunk.terra_begin; t < chunk.terra_end; t++) {
+        totals.awake += settleTerrarium(reptiles, terra, occupancy, t, (*p.rest)[t], ctx, p.wake_all);
+        totals.reptiles += occupancy.count(t);
+    }
+    totals.terrariums += chunk.terra_end - chunk.terra_begin;
+
+    sanitaryKernel(terra, chunk.terra_begin, chunk.terra_end, ctx.dt);
+
+    // The unassigned bucket's entry is only read here; it is updated after
+    // the run from the homeless chunks' totals
+    if (chunk.homeless_end > chunk.homeless_begin && (p.wake_all || p.rest->back().awake > 0)) {
+        totals.awake += settleBucket(reptiles, occupancy.members(OccupancyIndex::UNASSIGNED),
+                                     chunk.homeless_begin, chunk.homeless_end, ctx, !p.wake_all);
+    }
+    totals.reptiles += chunk.homeless_end - chunk.homeless_begin;
+
+    (*p.totals)[c] = totals;
+}
+
+void ReptileEngine::updateParallel(float dt)
+{
+    ParallelJob job = {&m_state, &m_chunks, &m_chunk_totals, &m_rest,
+                       {&m_state.terrariums, &m_state.occupancy, dt, false, false},
+                       m_state.game_time_hours >= 8.0f && m_state.game_time_hours <= 20.0f,
+                       false};
+    seasonalContext(m_state, job.ctx.brumation_season, job.ctx.should_be_dark);
+    job.wake_all = beginSettle(job.ctx);
+
+    // Small herds stay on the calling task; workers start on first real need
+    if (m_chunks.size() > 1 && !m_pool_started) {
+        m_pool.start(m_worker_count);
+        m_pool_started = true;
+    }
+    if (m_pool_started) {
+        m_pool.run(static_cast<uint32_t>(m_chunks.size()), runChunk, &job);
+    } else {
+        for (uint32_t c = 0; c < m_chunks.size(); c++) {
+            runChunk(&job, c);
         }
     }
-    return false;
+
+    // Reduce per-chunk totals in chunk order, so any herd-wide sum comes out
+    // the same whatever the worker count or scheduling
+    ChunkTotals totals = {0, 0, 0};
+    uint32_t homeless_awake = 0;
+    for (size_t c = 0; c < m_chunk_totals.size(); c++) {
+        const ChunkTotals& part = m_chunk_totals[c];
+        totals.terrariums += part.terrariums;
+        totals.reptiles += part.reptiles;
+        totals.awake += part.awake;
+        if (m_chunks[c].terra_end == m_chunks[c].terra_begin) homeless_awake += part.awake;
+    }
+    assert(totals.terrariums == m_state.terrariums.size());
+    assert(totals.reptiles == m_state.reptiles.size());
+
+    m_rest.back().awake = homeless_awake;
+    m_sleep_stats = {totals.awake, totals.reptiles - totals.awake};
 }
 
 // Forward declarations for external simulation engine functions
@@ -640,6 +2040,88 @@ void reptile_engine_tick(float delta_time)
     ReptileSim::ReptileEngine::getInstance().tick(delta_time);
 }
 
+void reptile_engine_fast_forward(double game_seconds)
+{
+    ReptileSim::ReptileEngine::getInstance().fastForward(game_seconds);
+}
+
+void reptile_engine_tick_batch(uint32_t steps, float delta_time)
+{
+    ReptileSim::ReptileEngine::getInstance().tickBatch(steps, delta_time);
+}
+
+uint32_t reptile_engine_advance(float real_seconds)
+{
+    return ReptileSim::ReptileEngine::getInstance().advance(real_seconds);
+}
+
+void reptile_engine_set_time_scale(float time_scale)
+{
+    ReptileSim::ReptileEngine::getInstance().setTimeScale(time_scale);
+}
+
+float reptile_engine_get_time_scale(void)
+{
+    return ReptileSim::ReptileEngine::getInstance().getTimeScale();
+}
+
+bool reptile_engine_set_engine_period(reptile_engine_id_t engine, uint32_t period, uint32_t phase)
+{
+    return ReptileSim::ReptileEngine::getInstance().setEnginePeriod(
+        static_cast<ReptileSim::SimEngine>(engine), period, phase);
+}
+
+uint32_t reptile_engine_get_engine_period(reptile_engine_id_t engine)
+{
+    return ReptileSim::ReptileEngine::getInstance().getEnginePeriod(static_cast<ReptileSim::SimEngine>(engine));
+}
+
+uint64_t reptile_engine_get_engine_runs(reptile_engine_id_t engine)
+{
+    return ReptileSim::ReptileEngine::getInstance().getEngineRuns(static_cast<ReptileSim::SimEngine>(engine));
+}
+
+int reptile_engine_get_profile(reptile_profile_entry_t *out, int max_entries)
+{
+    using ReptileSim::ProfileSlot;
+    if (!ReptileSim::EngineProfiler::ENABLED || !out) return 0;
+
+    const ReptileSim::ReptileEngine& engine = ReptileSim::ReptileEngine::getInstance();
+    int count = 0;
+    for (size_t k = 0; k < static_cast<size_t>(ProfileSlot::Count) && count < max_entries; k++) {
+        const ProfileSlot slot = static_cast<ProfileSlot>(k);
+        const ReptileSim::ProfileStats& s = engine.getProfile(slot);
+        reptile_profile_entry_t& e = out[count++];
+        e.name = ReptileSim::profileSlotName(slot);
+        e.calls = s.calls;
+        e.total_ns = s.total_ns;
+        e.last_ns = s.last_ns;
+        e.min_ns = s.calls ? s.min_ns : 0;
+        e.max_ns = s.max_ns;
+        e.mean_ns = s.meanNs();
+        memcpy(e.histogram, s.histogram, sizeof(e.histogram));
+    }
+    return count;
+}
+
+void reptile_engine_reset_profile(void)
+{
+    ReptileSim::ReptileEngine::getInstance().resetProfile();
+}
+
+void reptile_engine_set_worker_count(int workers)
+{
+    ReptileSim::ReptileEngine::getInstance().setWorkerCount(workers);
+}
+
+void reptile_engine_set_tick_mode(reptile_tick_mode_t mode)
+{
+    ReptileSim::TickMode tick_mode = ReptileSim::TickMode::Fused;
+    if (mode == REPTILE_TICK_SEQUENTIAL) tick_mode = ReptileSim::TickMode::Sequential;
+    if (mode == REPTILE_TICK_PARALLEL) tick_mode = ReptileSim::TickMode::Parallel;
+    ReptileSim::ReptileEngine::getInstance().setTickMode(tick_mode);
+}
+
 uint32_t reptile_engine_get_day(void)
 {
     return ReptileSim::ReptileEngine::getInstance().getState().game_day;
@@ -650,6 +2132,11 @@ float reptile_engine_get_time_hours(void)
     return ReptileSim::ReptileEngine::getInstance().getState().game_time_hours;
 }
 
+uint64_t reptile_engine_get_game_clock_ms(void)
+{
+    return ReptileSim::ReptileEngine::getInstance().getState().game_clock_ms;
+}
+
 int reptile_engine_get_reptile_count(void)
 {
     return static_cast<int>(ReptileSim::ReptileEngine::getInstance().getState().reptiles.size());
@@ -660,6 +2147,41 @@ int reptile_engine_get_terrarium_count(void)
     return static_cast<int>(ReptileSim::ReptileEngine::getInstance().getState().terrariums.size());
 }
 
+uint32_t reptile_engine_get_awake_count(void)
+{
+    return ReptileSim::ReptileEngine::getInstance().getSleepStats().awake;
+}
+
+uint32_t reptile_engine_get_asleep_count(void)
+{
+    return ReptileSim::ReptileEngine::getInstance().getSleepStats().asleep;
+}
+
+bool reptile_engine_assign_reptile(uint32_t reptile_id, uint32_t terrarium_id)
+{
+    return ReptileSim::ReptileEngine::getInstance().assignReptile(reptile_id, terrarium_id);
+}
+
+int reptile_engine_get_terrarium_occupant_count(uint32_t terrarium_id)
+{
+    return ReptileSim::ReptileEngine::getInstance().getTerrariumOccupantCount(terrarium_id);
+}
+
+int reptile_engine_get_terrarium_occupants(uint32_t terrarium_id, uint32_t* out_ids, int max_ids)
+{
+    return ReptileSim::ReptileEngine::getInstance().getTerrariumOccupants(terrarium_id, out_ids, max_ids);
+}
+
+bool reptile_engine_remove_reptile(uint32_t reptile_id)
+{
+    return ReptileSim::ReptileEngine::getInstance().removeReptile(reptile_id);
+}
+
+bool reptile_engine_remove_terrarium(uint32_t terrarium_id)
+{
+    return ReptileSim::ReptileEngine::getInstance().removeTerrarium(terrarium_id);
+}
+
 // Equipment control
 void reptile_engine_set_heater(uint32_t terrarium_id, bool on)
 {
@@ -739,17 +2261,264 @@ bool reptile_engine_is_reptile_healthy(uint32_t reptile_id)
     return ReptileSim::ReptileEngine::getInstance().isReptileHealthy(reptile_id);
 }
 
+// Published views (any task)
+bool reptile_engine_get_terrarium_view(uint32_t terrarium_id, reptile_terrarium_view_t* out)
+{
+    ReptileSim::TerrariumView v;
+    if (!out || !ReptileSim::ReptileEngine::getInstance().getTerrariumView(terrarium_id, v)) return false;
+    out->id = v.id;
+    out->version = v.version;
+    out->temp_hot = v.temp_hot_zone;
+    out->temp_cold = v.temp_cold_zone;
+    out->humidity = v.humidity;
+    out->uv_index = v.uv_index;
+    out->waste = v.waste_level;
+    out->bacteria = v.bacteria_count;
+    out->occupant_count = static_cast<int>(v.occupants);
+    out->heater_on = (v.equipment & ReptileSim::EQUIP_HEATER) != 0;
+    out->light_on = (v.equipment & ReptileSim::EQUIP_LIGHT) != 0;
+    out->mister_on = (v.equipment & ReptileSim::EQUIP_MISTER) != 0;
+    return true;
+}
+
+bool reptile_engine_get_reptile_view(uint32_t reptile_id, reptile_reptile_view_t* out)
+{
+    ReptileSim::ReptileView v;
+    if (!out || !ReptileSim::ReptileEngine::getInstance().getReptileView(reptile_id, v)) return false;
+    out->id = v.id;
+    out->version = v.version;
+    out->terrarium_id = v.assigned_terrarium_id;
+    out->weight = v.weight_grams;
+    out->bone_density = v.bone_density;
+    out->hydration = v.hydration;
+    out->stress = v.stress_level;
+    out->stomach = v.stomach_content;
+    out->immune = v.immune_system;
+    out->healthy = (v.flags & ReptileSim::REPTILE_FLAG_HEALTHY) != 0;
+    out->hungry = (v.flags & ReptileSim::REPTILE_FLAG_HUNGRY) != 0;
+    out->shedding = (v.flags & ReptileSim::REPTILE_FLAG_SHEDDING) != 0;
+    return true;
+}
+
+void reptile_engine_get_world_view(reptile_world_view_t* out)
+{
+    if (!out) return;
+    const ReptileSim::WorldView v = ReptileSim::ReptileEngine::getInstance().getWorldView();
+    out->version = v.version;
+    out->change_version = v.change_version;
+    out->game_clock_ms = v.game_clock_ms;
+    out->day = v.game_day;
+    out->time_hours = v.game_time_hours;
+    out->external_temperature = v.external_temperature;
+    out->external_humidity = v.external_humidity;
+    out->heatwave = v.heatwave_active;
+    out->reptile_count = static_cast<int>(v.reptile_count);
+    out->terrarium_count = static_cast<int>(v.terrarium_count);
+    out->total_expenses = v.economy.total_expenses;
+}
+
+// History
+bool reptile_engine_enable_history(uint32_t terrarium_slots, uint32_t reptile_slots)
+{
+    ReptileSim::HistoryConfig config = ReptileSim::HistoryRecorder::defaultConfig();
+    config.terrarium_slots = terrarium_slots;
+    config.reptile_slots = reptile_slots;
+    return ReptileSim::ReptileEngine::getInstance().enableHistory(config);
+}
+
+uint32_t reptile_engine_get_history_bytes(void)
+{
+    return static_cast<uint32_t>(ReptileSim::ReptileEngine::getInstance().getHistoryBytes());
+}
+
+int reptile_engine_get_history(reptile_history_channel_t channel, uint32_t id, uint64_t from_ms, uint64_t to_ms,
+                               reptile_history_point_t* out, int max_points)
+{
+    if (!out || max_points <= 0) return 0;
+    static_assert(sizeof(reptile_history_point_t) == sizeof(ReptileSim::HistoryPoint), "same layout");
+    return static_cast<int>(ReptileSim::ReptileEngine::getInstance().getHistory(
+        static_cast<ReptileSim::HistoryChannel>(channel), id, from_ms, to_ms,
+        reinterpret_cast<ReptileSim::HistoryPoint*>(out), static_cast<size_t>(max_points)));
+}
+
+// Telemetry archive
+bool reptile_engine_telemetry_start(const char* dir, uint32_t period_s, uint32_t chunk_samples)
+{
+    ReptileSim::TelemetryConfig config = ReptileSim::TelemetryArchive::defaultConfig();
+    if (period_s > 0) config.period_s = period_s;
+    if (chunk_samples > 0) config.chunk_samples = chunk_samples;
+    return ReptileSim::ReptileEngine::getInstance().startTelemetry(dir, config);
+}
+
+bool reptile_engine_telemetry_stop(void)
+{
+    return ReptileSim::ReptileEngine::getInstance().stopTelemetry();
+}
+
+bool reptile_engine_telemetry_flush(void)
+{
+    return ReptileSim::ReptileEngine::getInstance().flushTelemetry();
+}
+
+bool reptile_engine_telemetry_write(void)
+{
+    return ReptileSim::ReptileEngine::getInstance().writeTelemetry();
+}
+
+int reptile_engine_telemetry_query(reptile_history_channel_t channel, uint32_t id, uint64_t from_ms, uint64_t to_ms,
+                                   reptile_telemetry_point_t* out, int max_points)
+{
+    std::vector<ReptileSim::TelemetryPoint> points;
+    if (!ReptileSim::ReptileEngine::getInstance().queryTelemetry(static_cast<ReptileSim::HistoryChannel>(channel),
+                                                                 id, from_ms, to_ms, points)) {
+        return -1;
+    }
+    int count = 0;
+    for (const ReptileSim::TelemetryPoint& p : points) {
+        if (!out || count >= max_points) break;
+        out[count].time_ms = p.time_ms;
+        out[count].value = p.value;
+        count++;
+    }
+    return count;
+}
+
+// Alerts
+bool reptile_engine_poll_alert(reptile_alert_t* out)
+{
+    if (!out) return false;
+    ReptileSim::AlertEvent e;
+    if (!ReptileSim::ReptileEngine::getInstance().pollAlert(e)) return false;
+    out->time_ms = e.game_clock_ms;
+    out->entity_id = e.entity_id;
+    out->value = e.value;
+    out->kind = static_cast<reptile_alert_kind_t>(e.kind);
+    out->severity = static_cast<reptile_alert_severity_t>(e.severity);
+    out->raised = e.raised;
+    return true;
+}
+
+uint32_t reptile_engine_get_deferred_alerts(void)
+{
+    return ReptileSim::ReptileEngine::getInstance().getDeferredAlerts();
+}
+
+// Changes
+uint64_t reptile_engine_get_change_version(void)
+{
+    return ReptileSim::ReptileEngine::getInstance().getChangeVersion();
+}
+
+int reptile_engine_changed_since(uint64_t since, reptile_change_list_t list, uint8_t groups, uint32_t* out_ids,
+                                 int max_ids)
+{
+    // Ticking task only, so one scratch set serves every call
+    static ReptileSim::ChangeSet changes;
+    const bool terrariums = (list == REPTILE_CHANGED_TERRARIUMS || list == REPTILE_REMOVED_TERRARIUMS);
+    const uint8_t all = terrariums ? static_cast<uint8_t>(ReptileSim::TERRARIUM_FIELDS_ALL)
+                                   : static_cast<uint8_t>(ReptileSim::REPTILE_FIELDS_ALL);
+    const uint8_t wanted = (groups & all) ? (groups & all) : all;
+    ReptileSim::ReptileEngine::getInstance().getChangedSince(since, changes, terrariums ? wanted : 0,
+                                                             terrariums ? 0 : wanted);
+    if (!changes.complete) return -1;
+
+    const std::vector<uint32_t>* ids = &changes.terrariums;
+    switch (list) {
+        case REPTILE_CHANGED_REPTILES: ids = &changes.reptiles; break;
+        case REPTILE_REMOVED_TERRARIUMS: ids = &changes.removed_terrariums; break;
+        case REPTILE_REMOVED_REPTILES: ids = &changes.removed_reptiles; break;
+        default: break;
+    }
+    if (out_ids && max_ids > 0) {
+        const size_t n = std::min(ids->size(), static_cast<size_t>(max_ids));
+        std::copy(ids->begin(), ids->begin() + n, out_ids);
+    }
+    return static_cast<int>(ids->size());
+}
+
+// Bulk import / export
+bool reptile_engine_import_csv(const char* terrariums_path, const char* reptiles_path, reptile_import_report_t* out)
+{
+    ReptileSim::CsvImportReport report;
+    const bool ok = ReptileSim::ReptileEngine::getInstance().importHerdCsv(terrariums_path, reptiles_path, &report);
+    if (out) {
+        out->terrariums = report.terrariums;
+        out->reptiles = report.reptiles;
+        out->rejected = report.rejected;
+        out->first_error_line = report.errors.empty() ? 0 : report.errors[0].line;
+        out->first_error = report.errors.empty() ? nullptr : report.errors[0].message;
+    }
+    return ok;
+}
+
+bool reptile_engine_export_csv(const char* terrariums_path, const char* reptiles_path)
+{
+    return ReptileSim::ReptileEngine::getInstance().exportHerdCsv(terrariums_path, reptiles_path);
+}
+
 // Save/Load system
 bool reptile_engine_save_game(const char* filepath)
 {
     return ReptileSim::ReptileEngine::getInstance().saveGame(filepath);
 }
 
+void reptile_engine_set_save_compression(bool on)
+{
+    ReptileSim::ReptileEngine::getInstance().setSaveCompression(on);
+}
+
 bool reptile_engine_load_game(const char* filepath)
 {
     return ReptileSim::ReptileEngine::getInstance().loadGame(filepath);
 }
 
+bool reptile_engine_export_text(const char* filepath)
+{
+    return ReptileSim::ReptileEngine::getInstance().exportText(filepath);
+}
+
+// Journaled autosave
+bool reptile_engine_journal_start(const char* snapshot_path, const char* journal_path)
+{
+    return ReptileSim::ReptileEngine::getInstance().startJournal(snapshot_path, journal_path);
+}
+
+bool reptile_engine_journal_recover(const char* snapshot_path, const char* journal_path)
+{
+    return ReptileSim::ReptileEngine::getInstance().recoverJournal(snapshot_path, journal_path);
+}
+
+bool reptile_engine_journal_flush(void)
+{
+    return ReptileSim::ReptileEngine::getInstance().flushJournal();
+}
+
+bool reptile_engine_journal_compact(void)
+{
+    return ReptileSim::ReptileEngine::getInstance().compactJournal();
+}
+
+bool reptile_engine_save_game_background(const char* filepath, uint32_t timeout_ms)
+{
+    return ReptileSim::ReptileEngine::getInstance().saveGameBackground(filepath, timeout_ms);
+}
+
+bool reptile_engine_journal_compact_background(uint32_t timeout_ms)
+{
+    return ReptileSim::ReptileEngine::getInstance().compactJournalBackground(timeout_ms);
+}
+
+void reptile_engine_get_journal_stats(reptile_journal_stats_t* out)
+{
+    if (!out) return;
+    const ReptileSim::ChangeJournal::Stats s = ReptileSim::ReptileEngine::getInstance().getJournalStats();
+    out->generation = s.generation;
+    out->file_bytes = s.file_bytes;
+    out->ticks = s.ticks;
+    out->records = s.records;
+    out->pending_bytes = s.pending_bytes;
+}
+
 // Add/Remove entities
 uint32_t reptile_engine_add_reptile(const char* name, const char* species)
 {
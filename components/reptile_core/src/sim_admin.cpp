@@ -36,8 +36,9 @@ void updateAdmin(GameState& state, float dt)
     // Audit schedule: every 180 days
     // Check if audit is due (simplified)
     if ((state.game_day % 180) == 0 && state.game_time_hours < 1.0f) {
-        // Audit day - add one-time cost
-        state.economy.veterinary_cost += 500.0f;
+        // Audit day - $500 per tick-second of the first hour, so the total
+        // is the same whether admin runs every tick or once an hour
+        state.economy.veterinary_cost += 500.0f * dt;
     }
 
     // TODO: Add registry_id to Reptile struct
@@ -4,6 +4,7 @@
  */
 
 #include "../include/game_state.hpp"
+#include "sim_stages.hpp"
 
 namespace ReptileSim {
 
@@ -17,37 +18,15 @@ namespace ReptileSim {
  */
 void updateBehavior(GameState& state, float dt)
 {
-    for (auto& reptile : state.reptiles) {
-        // Find assigned terrarium
-        Terrarium* terra = nullptr;
-        for (auto& t : state.terrariums) {
-            if (t.id == reptile.assigned_terrarium_id) {
-                terra = &t;
-                break;
-            }
+    const StageContext ctx = {&state.terrariums, &state.occupancy, dt, false, false};
+
+    // Only housed reptiles are affected; walk each terrarium's occupants
+    for (uint32_t t = 0; t < state.terrariums.size(); t++) {
+        const uint32_t* members = state.occupancy.members(t);
+        const uint32_t count = state.occupancy.count(t);
+        for (uint32_t j = 0; j < count; j++) {
+            behaviorStage(state.reptiles, members[j], ctx);
         }
-
-        if (!terra) continue;
-
-        // Calculate enclosure volume (cm³)
-        float volume = terra->width * terra->height * terra->depth;
-
-        // Minimum space requirement (based on animal weight)
-        // Rule of thumb: 1 gram needs ~300 cm³ minimum
-        float required_volume = reptile.weight_grams * 300.0f;
-
-        // Inadequate space increases stress
-        if (volume < required_volume) {
-            float space_ratio = volume / required_volume;
-            reptile.stress_level += (1.0f - space_ratio) * 2.0f * dt;
-        } else {
-            // Adequate space reduces stress (enrichment effect)
-            reptile.stress_level -= 0.3f * dt;
-        }
-
-        // Clamp stress
-        if (reptile.stress_level < 0.0f) reptile.stress_level = 0.0f;
-        if (reptile.stress_level > 100.0f) reptile.stress_level = 100.0f;
     }
 }
 
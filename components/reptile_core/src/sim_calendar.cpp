@@ -0,0 +1,76 @@
+/**
+ * @file sim_calendar.cpp
+ * @brief Day-of-year and time-of-day tables (built on first use)
+ */
+
+#include "sim_calendar.hpp"
+#include "../include/game_state.hpp"
+#include <cmath>
+
+namespace ReptileSim {
+
+namespace {
+
+constexpr uint32_t DAYS_PER_YEAR = 365;
+constexpr uint32_t MINUTES_PER_DAY = 1440;
+
+struct CalendarTables {
+    CalendarDay days[DAYS_PER_YEAR];
+    float wave[MINUTES_PER_DAY + 1];    // + 24:00 for interpolation
+
+    CalendarTables()
+    {
+        const float PI = 3.14159265f;
+
+        for (uint32_t day_of_year = 1; day_of_year <= DAYS_PER_YEAR; day_of_year++) {
+            CalendarDay& d = days[day_of_year - 1];
+
+            // Peak in summer (day 172), minimum in winter (day 355)
+            const float season = std::sin(2.0f * PI * (day_of_year - 80) / 365.0f);
+            d.base_temperature = 15.0f + 10.0f * season;
+            d.photoperiod_hours = 12.0f + 2.5f * season;
+
+            // Lights on outside [dawn, dusk] mismatch the natural photoperiod
+            d.dusk_hours = 12.0f + d.photoperiod_hours / 2.0f;
+            d.dawn_hours = 24.0f - d.dusk_hours;
+
+            // Days 300-365 and 1-60 = winter
+            d.brumation_season = (day_of_year >= 300 || day_of_year <= 60);
+        }
+
+        for (uint32_t minute = 0; minute <= MINUTES_PER_DAY; minute++) {
+            // Same hours value GameState::setGameClock() derives
+            const float hours = static_cast<float>(static_cast<double>(minute * GAME_MS_PER_SECOND) / GAME_MS_PER_HOUR);
+            wave[minute] = std::sin(2.0f * PI * (hours - 6.0f) / 24.0f);
+        }
+    }
+};
+
+const CalendarTables& tables()
+{
+    static const CalendarTables instance;
+    return instance;
+}
+
+} // namespace
+
+const CalendarDay& calendarDay(uint32_t game_day)
+{
+    uint32_t day_of_year = (game_day - 1) % DAYS_PER_YEAR + 1;
+    return tables().days[day_of_year - 1];
+}
+
+float dailyTemperatureWave(uint64_t clock_ms)
+{
+    const uint64_t ms_of_day = clock_ms % GAME_MS_PER_DAY;
+    const uint32_t minute = static_cast<uint32_t>(ms_of_day / GAME_MS_PER_SECOND);
+    const uint32_t rest = static_cast<uint32_t>(ms_of_day % GAME_MS_PER_SECOND);
+
+    const float* wave = tables().wave;
+    if (rest == 0) return wave[minute];
+
+    const float t = static_cast<float>(rest) / GAME_MS_PER_SECOND;
+    return wave[minute] + (wave[minute + 1] - wave[minute]) * t;
+}
+
+} // namespace ReptileSim
@@ -0,0 +1,45 @@
+/**
+ * @file sim_calendar.hpp
+ * @brief Day-of-year and time-of-day tables for weather and photoperiod
+ *
+ * The seasonal curves depend only on the day of the year, and the daily
+ * temperature wave only on the time of day. Both are tabulated once (365
+ * days, 1440 game minutes) with the same float expressions the engines
+ * used to evaluate every tick, so lookups return identical values.
+ */
+
+#ifndef SIM_CALENDAR_HPP
+#define SIM_CALENDAR_HPP
+
+#include <cstdint>
+
+namespace ReptileSim {
+
+/**
+ * @brief Seasonal values of one day of the year
+ */
+struct CalendarDay {
+    float base_temperature;     // Weather: seasonal outside temperature (°C)
+    float photoperiod_hours;    // Hours of daylight
+    float dawn_hours;           // Natural night ends
+    float dusk_hours;           // Natural night starts
+    bool brumation_season;      // Winter rest expected
+};
+
+/**
+ * @brief Seasonal values for a game day (1-based, wraps every 365 days)
+ */
+const CalendarDay& calendarDay(uint32_t game_day);
+
+/**
+ * @brief Daily temperature wave in [-1, 1] (minimum at 00:00, peak at 12:00)
+ *
+ * Whole game minutes come straight from the table; anything in between is
+ * interpolated linearly between the two neighbouring minutes.
+ * @param clock_ms GameState::game_clock_ms
+ */
+float dailyTemperatureWave(uint64_t clock_ms);
+
+} // namespace ReptileSim
+
+#endif // SIM_CALENDAR_HPP
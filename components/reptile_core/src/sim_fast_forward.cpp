@@ -0,0 +1,493 @@
+/**
+ * @file sim_fast_forward.cpp
+ * @brief Fast-forward: piecewise closed-form physics, sanitary and reptiles
+ *
+ * Between events every branch in the entity engines takes the same side
+ * tick after tick, so each quantity follows a clamped linear ramp. A window
+ * is cut into segments at the ticks where any branch flips (temperature
+ * thresholds, photoperiod, equipment failures, immune/bone/stomach
+ * thresholds) and each segment is applied in one step:
+ *
+ * - Ramps are replayed in float: within one binade every x - r rounds by
+ *   the same amount, so a whole run collapses to one multiply and matches
+ *   the stepped values exactly.
+ * - Stress takes several clamped additions per tick. Each is a map
+ *   x -> clamp(x + a, lo, hi); such maps are closed under composition, so a
+ *   segment is one map raised to its length, evaluated in double.
+ * - Waste and bacteria are stepped until they saturate (a few hundred ticks
+ *   after a cleaning at most).
+ *
+ * A terrarium without heater sits on the outside temperature once it has
+ * cooled down: the outside temperature never falls faster than the 0.3/s
+ * cooling ramp, so max(temp - 0.3, outside) is the outside value from then on.
+ */
+
+#include "sim_fast_forward.hpp"
+#include "sim_stages.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ReptileSim {
+
+namespace {
+
+// Segment bits (combined with FastForwardSeason bits)
+enum SegmentBits : uint8_t {
+    SEG_THERMAL_STRESS = 1u << 0,   // Biology: temp < 28 or temp > 38
+    SEG_COLD           = 1u << 1,   // Reproduction: temp < 30
+    SEG_WARM           = 1u << 2,   // Seasonal: temp > 25
+    SEG_LIGHT          = 1u << 3,   // Light running
+};
+
+constexpr uint8_t SEASON_MASK = FF_BRUMATION | FF_DARK;
+
+inline uint8_t thermalBits(float temp)
+{
+    uint8_t bits = 0;
+    if (temp < 28.0f || temp > 38.0f) bits |= SEG_THERMAL_STRESS;
+    if (temp < 30.0f) bits |= SEG_COLD;
+    if (temp > 25.0f) bits |= SEG_WARM;
+    return bits;
+}
+
+// ====================================================================================
+// FLOAT RAMPS
+// ====================================================================================
+
+/**
+ * @brief x after `steps` rounds of x = max(x - r, floor_value) in float
+ */
+float rampDown(float x, float r, uint32_t steps, float floor_value)
+{
+    while (steps > 0) {
+        if (x <= floor_value) return floor_value;
+
+        // Whole steps that stay inside x's binade all round the same way
+        uint32_t run = 0;
+        if (x != 0.0f) {
+            int exponent;
+            std::frexp(x, &exponent);
+            const double lo = std::ldexp(1.0, exponent - 1);
+            const double ulp = std::ldexp(1.0, exponent - 24);
+            const double q = r / ulp;
+            const double m = std::fabs(static_cast<double>(x));
+
+            if (q - std::floor(q) != 0.5) {
+                const double d = std::nearbyint(q) * ulp;
+                // Step k (1-based) must round inside the binade
+                auto inside = [&](double k) {
+                    return (x > 0.0f) ? (m - (k - 1) * d - r >= lo)
+                                      : (m + (k - 1) * d + r < 2.0 * lo);
+                };
+                double k = (x > 0.0f) ? std::floor((m - r - lo) / d) + 1.0
+                                      : std::ceil((2.0 * lo - r - m) / d);
+                if (k > steps) k = steps;
+                if (floor_value > -INFINITY) {
+                    k = std::min(k, std::floor((static_cast<double>(x) - floor_value) / d));
+                }
+                while (k > 0 && (!inside(k) || static_cast<double>(x) - k * d < floor_value)) k--;
+                run = (k > 0) ? static_cast<uint32_t>(k) : 0;
+                if (run > 0) {
+                    x = static_cast<float>(static_cast<double>(x) - run * d);
+                    steps -= run;
+                    continue;
+                }
+            }
+        }
+
+        // Binade edge (or rounding tie): one plain float step
+        x = std::max(x - r, floor_value);
+        steps--;
+    }
+    return x;
+}
+
+/**
+ * @brief Number of ticks (up to limit) for which the ramp stays >= threshold
+ */
+uint32_t rampTicksAtOrAbove(float x, float r, float floor_value, float threshold, uint32_t limit)
+{
+    if (rampDown(x, r, limit, floor_value) >= threshold) return limit;
+
+    uint32_t lo = 0, hi = limit;    // ramp(lo) >= threshold > ramp(hi)
+    while (hi - lo > 1) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (rampDown(x, r, mid, floor_value) >= threshold) lo = mid; else hi = mid;
+    }
+    return lo;
+}
+
+// ====================================================================================
+// STRESS MAPS
+// ====================================================================================
+
+// x -> min(max(x + add, lo), hi)
+struct ClampAdd {
+    double add, lo, hi;
+
+    ClampAdd then(double b, double l, double h) const
+    {
+        return {add + b, std::min(std::max(lo + b, l), h), std::min(std::max(hi + b, l), h)};
+    }
+
+    // This map applied k >= 1 times
+    ClampAdd power(uint32_t k) const
+    {
+        const double extra = static_cast<double>(k - 1) * add;
+        if (add >= 0.0) return {k * add, std::min(lo + extra, hi), hi};
+        return {k * add, lo, std::max(hi + extra, lo)};
+    }
+
+    double apply(double x) const { return std::min(std::max(x + add, lo), hi); }
+};
+
+// ====================================================================================
+// TERRARIUM TIMELINE
+// ====================================================================================
+
+struct Segment {
+    uint32_t begin;     // First tick (1-based); runs to the next segment
+    uint8_t bits;       // SegmentBits | FastForwardSeason
+};
+
+/**
+ * @brief Per-window tables shared by all terrariums
+ */
+struct WindowTables {
+    std::vector<uint8_t> floor_bits;        // Terrarium on the outside temp
+    std::vector<uint32_t> floor_next;       // Next tick where floor_bits change
+    std::vector<uint32_t> season_next;      // Next tick where season bits change
+};
+
+void buildTables(const FastForwardTrack& track, WindowTables& tables)
+{
+    const uint32_t ticks = track.ticks();
+    tables.floor_bits.resize(ticks + 2);
+    tables.floor_next.resize(ticks + 2);
+    tables.season_next.resize(ticks + 2);
+
+    for (uint32_t n = 1; n <= ticks; n++) {
+        tables.floor_bits[n] = thermalBits(track.external_before[n - 1]) |
+                               (track.season[n - 1] & SEASON_MASK);
+    }
+    tables.floor_next[ticks] = ticks + 1;
+    tables.season_next[ticks] = ticks + 1;
+    for (uint32_t n = ticks - 1; n >= 1; n--) {
+        tables.floor_next[n] = (tables.floor_bits[n + 1] != tables.floor_bits[n]) ? n + 1 : tables.floor_next[n + 1];
+        const bool season_flip = ((track.season[n] ^ track.season[n - 1]) & SEASON_MASK) != 0;
+        tables.season_next[n] = season_flip ? n + 1 : tables.season_next[n + 1];
+    }
+}
+
+// First tick in (from, to] whose thermal bits differ from tick `from`, or
+// to + 1; temp_at must be monotonic over the range
+template <typename TempAt>
+uint32_t nextThermalChange(TempAt temp_at, uint32_t from, uint32_t to)
+{
+    const uint8_t bits = thermalBits(temp_at(from));
+    if (to <= from || thermalBits(temp_at(to)) == bits) return to + 1;
+
+    uint32_t lo = from, hi = to;    // bits(lo) == bits, bits(hi) != bits
+    while (hi - lo > 1) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (thermalBits(temp_at(mid)) == bits) lo = mid; else hi = mid;
+    }
+    return hi;
+}
+
+/**
+ * @brief Integrate one terrarium over the window and record its segments
+ */
+void advanceTerrarium(TerrariumStore& terra, size_t i, const FastForwardTrack& track,
+                      const WindowTables& tables, std::vector<Segment>& segments)
+{
+    const uint32_t ticks = track.ticks();
+    const float dt = track.dt;
+    const uint8_t equipment = terra.equipment[i];
+    const EquipmentFailures failures = sampleEquipmentFailures(equipment, ticks, dt);
+
+    // Last tick each device runs (a failure is applied after that tick)
+    auto runsUntil = [&](uint8_t flag, uint32_t failure) -> uint32_t {
+        if (!(equipment & flag)) return 0;
+        return (failure != 0) ? failure : ticks;
+    };
+    const uint32_t heater_until = runsUntil(EQUIP_HEATER, failures.heater);
+    const uint32_t light_until = runsUntil(EQUIP_LIGHT, failures.light);
+    const uint32_t mister_until = runsUntil(EQUIP_MISTER, failures.mister);
+
+    // Temperature: heater ramp, then cooling ramp, then outside temperature
+    const float start_temp = terra.temp_hot_zone[i];
+    const float heat_step = 0.5f * dt;
+    const float cool_step = 0.3f * dt;
+    auto heated = [&](uint32_t n) {
+        return std::min(static_cast<float>(start_temp + static_cast<double>(heat_step) * n), 35.0f);
+    };
+    const float cool_from = (heater_until > 0) ? heated(heater_until) : start_temp;
+    auto cooled = [&](uint32_t n) {
+        return rampDown(cool_from, cool_step, n - heater_until, -INFINITY);
+    };
+
+    // First tick on the outside temperature (cooled - outside only decreases)
+    uint32_t floor_tick = ticks + 1;
+    if (heater_until < ticks) {
+        auto on_floor = [&](uint32_t n) { return cooled(n) <= track.external_before[n - 1]; };
+        if (on_floor(ticks)) {
+            uint32_t lo = heater_until, hi = ticks;
+            while (hi - lo > 1) {
+                uint32_t mid = lo + (hi - lo) / 2;
+                if (on_floor(mid)) hi = mid; else lo = mid;
+            }
+            floor_tick = hi;
+        }
+    }
+    auto tempAt = [&](uint32_t n) {
+        if (n <= heater_until) return heated(n);
+        if (n < floor_tick) return cooled(n);
+        return track.external_before[n - 1];
+    };
+
+    // Cut the window wherever a branch input changes
+    segments.clear();
+    uint32_t n = 1;
+    while (n <= ticks) {
+        uint32_t next = ticks + 1;
+        uint8_t bits;
+        if (n >= floor_tick) {
+            bits = tables.floor_bits[n];
+            next = tables.floor_next[n];
+        } else {
+            bits = thermalBits(tempAt(n)) | (track.season[n - 1] & SEASON_MASK);
+            next = tables.season_next[n];
+            if (n <= heater_until) {
+                next = std::min(next, nextThermalChange(heated, n, heater_until));
+            } else {
+                next = std::min(next, nextThermalChange(cooled, n, floor_tick - 1));
+            }
+        }
+        if (n <= light_until) {
+            bits |= SEG_LIGHT;
+            next = std::min(next, light_until + 1);
+        }
+        if (n <= heater_until) next = std::min(next, heater_until + 1);
+        if (n < floor_tick) next = std::min(next, floor_tick);
+
+        if (segments.empty() || segments.back().bits != bits) {
+            segments.push_back({n, bits});
+        }
+        n = next;
+    }
+
+    // End-of-window terrarium state
+    const float temp = tempAt(ticks);
+    terra.temp_hot_zone[i] = temp;
+    terra.temp_cold_zone[i] = temp - 5.0f;
+
+    float humidity = terra.humidity[i];
+    if (mister_until > 0) {
+        humidity = std::min(static_cast<float>(humidity + static_cast<double>(1.0f * dt) * mister_until), 80.0f);
+    }
+    if (mister_until < ticks) {
+        humidity = std::max(static_cast<float>(humidity - static_cast<double>(0.5f * dt) * (ticks - mister_until)), 30.0f);
+    }
+    terra.humidity[i] = humidity;
+
+    const bool daytime = (track.season[ticks - 1] & FF_DAYTIME) != 0;
+    terra.uv_index[i] = (daytime && light_until == ticks) ? 3.0f : 0.0f;
+
+    for (uint32_t k = 0; k < ticks; k++) {
+        if (terra.waste_level[i] >= 100.0f && terra.bacteria_count[i] >= 100.0f) break;
+        sanitaryStage(terra, i, dt);
+    }
+
+    if (failures.heater != 0) terra.setEquipment(i, EQUIP_HEATER, false);
+    if (failures.light != 0) terra.setEquipment(i, EQUIP_LIGHT, false);
+    if (failures.mister != 0) terra.setEquipment(i, EQUIP_MISTER, false);
+}
+
+// ====================================================================================
+// REPTILES
+// ====================================================================================
+
+/**
+ * @brief Per-terrarium constants of the reptile stages
+ */
+struct Housing {
+    bool housed;
+    float volume;
+    int occupants;
+    bool crowded;           // Social: overcrowding branch
+    float crowding_add;     // Social: crowding stress per tick
+};
+
+Housing housingFor(const TerrariumStore& terra, const OccupancyIndex& occupancy, uint32_t t, float dt)
+{
+    Housing h = {false, 0.0f, 0, false, 0.0f};
+    if (t == OccupancyIndex::UNASSIGNED) return h;
+
+    h.housed = true;
+    h.volume = terra.volume[t];
+    h.occupants = static_cast<int>(occupancy.count(t));
+    if (h.occupants > 1) {
+        float volume_per_animal = h.volume / h.occupants;
+        if (volume_per_animal < 200000.0f) {
+            h.crowded = true;
+            h.crowding_add = (1.0f - (volume_per_animal / 200000.0f)) * 1.5f * dt;
+        }
+    }
+    return h;
+}
+
+// Stomach after `ticks` ticks of digestion and food competition, in float
+float drainStomach(float stomach, uint32_t ticks, bool competing, float dt)
+{
+    if (!competing) {
+        return std::max(static_cast<float>(stomach - static_cast<double>(0.5f * dt) * ticks), 0.0f);
+    }
+    for (uint32_t k = 0; k < ticks && stomach > 0.0f; k++) {
+        stomach = std::max(stomach - 0.5f * dt, 0.0f);
+        stomach = std::max(stomach - 0.3f * dt, 0.0f);
+    }
+    return stomach;
+}
+
+/**
+ * @brief Integrate one reptile over its terrarium's segments
+ */
+void advanceReptile(ReptileStore& r, size_t i, const Housing& housing,
+                    const std::vector<Segment>& segments, uint32_t ticks, float dt)
+{
+    const float immune_step = 0.001f * dt;
+    const float bone_step = 0.1f * dt;
+
+    // Behavior: enclosure size vs body weight (constant while fast-forwarding)
+    float behavior_add = -0.3f * dt;
+    if (housing.housed) {
+        float required_volume = r.weight_grams[i] * 300.0f;
+        if (housing.volume < required_volume) {
+            behavior_add = (1.0f - housing.volume / required_volume) * 2.0f * dt;
+        }
+    }
+
+    float immune = r.immune_system[i];
+    float stomach = r.stomach_content[i];
+    float bone = r.bone_density[i];
+    double stress = r.stress_level[i];
+
+    size_t s = 0;
+    uint32_t n = 1;
+    while (n <= ticks) {
+        uint32_t segment_end = ticks + 1;
+        uint8_t bits = 0;
+        if (housing.housed) {
+            while (s + 1 < segments.size() && segments[s + 1].begin <= n) s++;
+            bits = segments[s].bits;
+            if (s + 1 < segments.size()) segment_end = segments[s + 1].begin;
+        }
+
+        // Branch inputs as the stages see them on tick n
+        const float immune_now = std::max(immune - immune_step, 0.0f);
+        const bool submissive = immune_now < 80.0f;
+        const bool weak = immune_now < 70.0f;
+        const bool competing = housing.crowded && weak;
+        const float digested = (stomach > 0.0f) ? std::max(stomach - 0.5f * dt, 0.0f) : stomach;
+        const bool starving = digested < 20.0f;
+        const float bone_now = starving ? std::max(bone - bone_step, 0.0f) : bone;
+        const bool low_calcium = bone_now < 80.0f;
+
+        // Ticks until one of them flips
+        uint32_t run = segment_end - n;
+        if (!submissive) run = std::min(run, rampTicksAtOrAbove(immune, immune_step, 0.0f, 80.0f, run));
+        if (!weak && housing.crowded) run = std::min(run, rampTicksAtOrAbove(immune, immune_step, 0.0f, 70.0f, run));
+        if (!starving) {
+            uint32_t fed = 0;
+            float s_after = stomach;
+            if (!competing) {
+                // Digestion by exactly 0.5 per tick
+                double exact = std::floor((stomach - 20.0) / (0.5f * dt));
+                fed = (exact >= run) ? run : static_cast<uint32_t>(exact);
+            } else {
+                while (fed < run) {
+                    s_after = std::max(s_after - 0.5f * dt, 0.0f);
+                    if (s_after < 20.0f) break;
+                    s_after = std::max(s_after - 0.3f * dt, 0.0f);
+                    fed++;
+                }
+            }
+            run = std::min(run, fed);
+        }
+        if (starving && !low_calcium) run = std::min(run, rampTicksAtOrAbove(bone, bone_step, 0.0f, 80.0f, run));
+        if (run == 0) run = 1;
+
+        // Stress: one clamped addition per stage, in tick order
+        ClampAdd tick_map;
+        if (housing.housed) {
+            tick_map = {(bits & SEG_THERMAL_STRESS) ? 1.0f * dt : -0.5f * dt, 0.0, 100.0};
+            tick_map = tick_map.then(behavior_add, 0.0, 100.0);
+            float repro_add = 0.0f;
+            if (low_calcium) repro_add += 0.1f * dt;
+            if (bits & SEG_COLD) repro_add += 0.05f * dt;
+            tick_map = tick_map.then(repro_add, -INFINITY, 100.0);
+            float social_add = 0.0f;
+            if (housing.crowded) social_add += housing.crowding_add;
+            if (housing.occupants > 1 && submissive) social_add += 0.4f * dt;
+            tick_map = tick_map.then(social_add, 0.0, 100.0);
+            float seasonal_add = 0.0f;
+            if ((bits & FF_BRUMATION) && (bits & SEG_WARM)) seasonal_add += 0.5f * dt;
+            if ((bits & FF_DARK) && (bits & SEG_LIGHT)) seasonal_add += 0.2f * dt;
+            tick_map = tick_map.then(seasonal_add, 0.0, 100.0);
+        } else {
+            // No terrarium: biology only, then the social clamp
+            tick_map = ClampAdd{5.0f * dt, -INFINITY, 100.0}.then(0.0, 0.0, 100.0);
+        }
+        stress = tick_map.power(run).apply(stress);
+
+        immune = rampDown(immune, immune_step, run, 0.0f);
+        stomach = drainStomach(stomach, run, competing, dt);
+        if (starving) bone = rampDown(bone, bone_step, run, 0.0f);
+        n += run;
+    }
+
+    r.immune_system[i] = immune;
+    r.stomach_content[i] = stomach;
+    r.bone_density[i] = bone;
+    r.stress_level[i] = static_cast<float>(stress);
+}
+
+} // namespace
+
+// ====================================================================================
+// ENTRY POINT
+// ====================================================================================
+
+void fastForwardEntities(GameState& state, const FastForwardTrack& track)
+{
+    const uint32_t ticks = track.ticks();
+    if (ticks == 0) return;
+
+    WindowTables tables;
+    buildTables(track, tables);
+
+    TerrariumStore& terra = state.terrariums;
+    ReptileStore& reptiles = state.reptiles;
+    const OccupancyIndex& occupancy = state.occupancy;
+    std::vector<Segment> segments;
+
+    // Occupants read the segments before the terrarium moves on
+    for (uint32_t t = 0; t < terra.size(); t++) {
+        const Housing housing = housingFor(terra, occupancy, t, track.dt);
+        advanceTerrarium(terra, t, track, tables, segments);
+
+        const uint32_t* members = occupancy.members(t);
+        for (uint32_t j = 0; j < occupancy.count(t); j++) {
+            advanceReptile(reptiles, members[j], housing, segments, ticks, track.dt);
+        }
+    }
+
+    const Housing homeless = housingFor(terra, occupancy, OccupancyIndex::UNASSIGNED, track.dt);
+    const uint32_t* members = occupancy.members(OccupancyIndex::UNASSIGNED);
+    for (uint32_t j = 0; j < occupancy.count(OccupancyIndex::UNASSIGNED); j++) {
+        advanceReptile(reptiles, members[j], homeless, segments, ticks, track.dt);
+    }
+}
+
+} // namespace ReptileSim
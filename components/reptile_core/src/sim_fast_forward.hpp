@@ -0,0 +1,70 @@
+/**
+ * @file sim_fast_forward.hpp
+ * @brief Closed-form integration of the entity engines over many ticks
+ */
+
+#ifndef SIM_FAST_FORWARD_HPP
+#define SIM_FAST_FORWARD_HPP
+
+#include "../include/game_state.hpp"
+#include <vector>
+
+namespace ReptileSim {
+
+// Per-tick global inputs (FastForwardTrack::season bits)
+enum FastForwardSeason : uint8_t {
+    FF_BRUMATION = 1u << 4,     // seasonalContext(): brumation season
+    FF_DARK      = 1u << 5,     // seasonalContext(): outside photoperiod
+    FF_DAYTIME   = 1u << 6,     // Physics: UV lights may run
+};
+
+/**
+ * @brief Global inputs of a window of ticks, recorded while stepping the
+ * global engines (entry n - 1 belongs to tick n)
+ */
+struct FastForwardTrack {
+    float dt;
+    std::vector<float> external_before;     // external_temperature seen by physics
+    std::vector<uint8_t> season;            // FastForwardSeason bits
+
+    uint32_t ticks() const { return static_cast<uint32_t>(season.size()); }
+};
+
+/**
+ * @brief Advance every terrarium and reptile by track.ticks() ticks
+ *
+ * Covers physics, sanitary, technical failures and all per-reptile stages.
+ * Time, economy and weather are left to the caller.
+ */
+void fastForwardEntities(GameState& state, const FastForwardTrack& track);
+
+/**
+ * @brief Tick (1-based) at which each running device fails, 0 if it survives
+ */
+struct EquipmentFailures {
+    uint32_t heater;
+    uint32_t light;
+    uint32_t mister;
+};
+
+/**
+ * @brief Draw the failures updateTechnical() would cause over `ticks` ticks
+ *
+ * Same per-tick probabilities and random stream, one draw per device.
+ */
+EquipmentFailures sampleEquipmentFailures(uint8_t equipment, uint32_t ticks, float dt);
+
+/**
+ * @brief State of the failure random stream (saved so replays draw the same)
+ */
+uint32_t technicalRandomState();
+void setTechnicalRandomState(uint32_t state);
+
+/**
+ * @brief Global part of updateTechnical() (aging equipment costs)
+ */
+void updateTechnicalCosts(GameState& state, float dt);
+
+} // namespace ReptileSim
+
+#endif // SIM_FAST_FORWARD_HPP
@@ -4,6 +4,7 @@
  */
 
 #include "../include/game_state.hpp"
+#include "sim_stages.hpp"
 
 namespace ReptileSim {
 
@@ -26,14 +27,14 @@ void updateGenetics(GameState& state, float dt)
     // 2. Calculate inbreeding coefficient (F = Σ(0.5^n))
     // 3. Apply inbreeding depression to immune system and bone density
 
-    for (auto& reptile : state.reptiles) {
-        // Simulate slow genetic drift/mutation accumulation
-        // In real system, this would be tied to inbreeding coefficient
+    // Simulate slow genetic drift/mutation accumulation
+    // In real system, this would be tied to inbreeding coefficient
+    // Very slow degradation (barely noticeable), see geneticsStage()
+    const StageContext ctx = {&state.terrariums, &state.occupancy, dt, false, false};
+    const size_t count = state.reptiles.size();
 
-        // Very slow degradation (barely noticeable)
-        reptile.immune_system -= 0.001f * dt;
-
-        if (reptile.immune_system < 0.0f) reptile.immune_system = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        geneticsStage(state.reptiles, i, ctx);
     }
 
     // TODO: Implement full pedigree tracking system
@@ -0,0 +1,385 @@
+/**
+ * @file sim_kernels.cpp
+ * @brief Vectorized column kernels (SSE2 / AVX2 with scalar fallback)
+ */
+
+#include "sim_kernels.hpp"
+#include "sim_stages.hpp"
+#include <atomic>
+#include <cstring>
+
+#if !defined(REPTILE_SIM_NO_SIMD) && defined(__GNUC__) && defined(__x86_64__)
+#define SIM_KERNELS_X86 1
+#include <immintrin.h>
+#else
+#define SIM_KERNELS_X86 0
+#endif
+
+namespace ReptileSim {
+
+// ====================================================================================
+// SCALAR (reference stages)
+// ====================================================================================
+
+static void physicsScalar(TerrariumStore& terra, size_t begin, size_t end, float dt,
+                          bool daytime, float external_temperature)
+{
+    for (size_t i = begin; i < end; i++) {
+        physicsStage(terra, i, dt, daytime, external_temperature);
+    }
+}
+
+static void sanitaryScalar(TerrariumStore& terra, size_t begin, size_t end, float dt)
+{
+    for (size_t i = begin; i < end; i++) {
+        sanitaryStage(terra, i, dt);
+    }
+}
+
+static void nutritionScalar(ReptileStore& reptiles, size_t begin, size_t end, float dt)
+{
+    const StageContext ctx = {nullptr, nullptr, dt, false, false};
+    for (size_t i = begin; i < end; i++) {
+        nutritionStage(reptiles, i, ctx);
+    }
+}
+
+#if SIM_KERNELS_X86
+
+// ====================================================================================
+// SSE2 (4 lanes, x86-64 baseline)
+// ====================================================================================
+
+static inline __m128 blend4(__m128 mask, __m128 if_set, __m128 if_clear)
+{
+    return _mm_or_ps(_mm_and_ps(mask, if_set), _mm_andnot_ps(mask, if_clear));
+}
+
+// Widen 4 equipment bytes and test one bit per lane
+static inline __m128 equipMask4(__m128i equipment, uint8_t flag)
+{
+    const __m128i bit = _mm_set1_epi32(flag);
+    return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(equipment, bit), bit));
+}
+
+static void physicsSSE2(TerrariumStore& terra, size_t begin, size_t end, float dt,
+                        bool daytime, float external_temperature)
+{
+    float* temp_hot = terra.temp_hot_zone.data();
+    float* temp_cold = terra.temp_cold_zone.data();
+    float* humidity = terra.humidity.data();
+    float* uv = terra.uv_index.data();
+    const uint8_t* equipment = terra.equipment.data();
+
+    const __m128 heat_step = _mm_set1_ps(0.5f * dt);
+    const __m128 cool_step = _mm_set1_ps(0.3f * dt);
+    const __m128 temp_max = _mm_set1_ps(35.0f);
+    const __m128 outside = _mm_set1_ps(external_temperature);
+    const __m128 cold_offset = _mm_set1_ps(5.0f);
+    const __m128 mist_step = _mm_set1_ps(1.0f * dt);
+    const __m128 dry_step = _mm_set1_ps(0.5f * dt);
+    const __m128 humidity_max = _mm_set1_ps(80.0f);
+    const __m128 humidity_min = _mm_set1_ps(30.0f);
+    const __m128 day_uv = _mm_set1_ps(daytime ? 3.0f : 0.0f);
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        uint32_t bytes;
+        memcpy(&bytes, equipment + i, sizeof(bytes));
+        __m128i equip = _mm_cvtsi32_si128(static_cast<int>(bytes));
+        equip = _mm_unpacklo_epi16(_mm_unpacklo_epi8(equip, zero), zero);
+
+        // Temperature: ramp up to 35 with heater, else decay to outside
+        const __m128 t = _mm_loadu_ps(temp_hot + i);
+        const __m128 warm = _mm_min_ps(_mm_add_ps(t, heat_step), temp_max);
+        const __m128 cool = _mm_max_ps(_mm_sub_ps(t, cool_step), outside);
+        const __m128 temp = blend4(equipMask4(equip, EQUIP_HEATER), warm, cool);
+        _mm_storeu_ps(temp_hot + i, temp);
+        _mm_storeu_ps(temp_cold + i, _mm_sub_ps(temp, cold_offset));
+
+        // Humidity: mister ramps to 80, else dries to 30
+        const __m128 h = _mm_loadu_ps(humidity + i);
+        const __m128 wet = _mm_min_ps(_mm_add_ps(h, mist_step), humidity_max);
+        const __m128 dry = _mm_max_ps(_mm_sub_ps(h, dry_step), humidity_min);
+        _mm_storeu_ps(humidity + i, blend4(equipMask4(equip, EQUIP_MISTER), wet, dry));
+
+        // UV: 3 with light on during the day, else 0
+        _mm_storeu_ps(uv + i, _mm_and_ps(equipMask4(equip, EQUIP_LIGHT), day_uv));
+    }
+
+    physicsScalar(terra, i, end, dt, daytime, external_temperature);
+}
+
+static void sanitarySSE2(TerrariumStore& terra, size_t begin, size_t end, float dt)
+{
+    float* waste_level = terra.waste_level.data();
+    float* bacteria_count = terra.bacteria_count.data();
+
+    const __m128 waste_step = _mm_set1_ps(0.5f * dt);
+    const __m128 growth = _mm_set1_ps(0.01f);
+    const __m128 step = _mm_set1_ps(dt);
+    const __m128 limit = _mm_set1_ps(100.0f);
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        const __m128 waste = _mm_min_ps(_mm_add_ps(_mm_loadu_ps(waste_level + i), waste_step), limit);
+        _mm_storeu_ps(waste_level + i, waste);
+
+        const __m128 b = _mm_loadu_ps(bacteria_count + i);
+        const __m128 bacteria = _mm_add_ps(b, _mm_mul_ps(_mm_mul_ps(waste, growth), step));
+        _mm_storeu_ps(bacteria_count + i, _mm_min_ps(bacteria, limit));
+    }
+
+    sanitaryScalar(terra, i, end, dt);
+}
+
+static void nutritionSSE2(ReptileStore& reptiles, size_t begin, size_t end, float dt)
+{
+    float* stomach_content = reptiles.stomach_content.data();
+    float* bone_density = reptiles.bone_density.data();
+    uint8_t* flags = reptiles.flags.data();
+
+    const __m128 digest_step = _mm_set1_ps(0.5f * dt);
+    const __m128 bone_step = _mm_set1_ps(0.1f * dt);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 hungry_below = _mm_set1_ps(30.0f);
+    const __m128 starving_below = _mm_set1_ps(20.0f);
+    const __m128i hungry_bit = _mm_set1_epi8(static_cast<char>(REPTILE_FLAG_HUNGRY));
+
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        // Digestion (only while there is something to digest)
+        const __m128 s = _mm_loadu_ps(stomach_content + i);
+        const __m128 digested = _mm_max_ps(_mm_sub_ps(s, digest_step), zero);
+        const __m128 stomach = blend4(_mm_cmpgt_ps(s, zero), digested, s);
+        _mm_storeu_ps(stomach_content + i, stomach);
+
+        // Bone density decay without proper nutrition
+        const __m128 b = _mm_loadu_ps(bone_density + i);
+        const __m128 decayed = _mm_max_ps(_mm_sub_ps(b, bone_step), zero);
+        _mm_storeu_ps(bone_density + i, blend4(_mm_cmplt_ps(stomach, starving_below), decayed, b));
+
+        // Hunger flag: narrow the lane mask to 4 bytes and merge
+        __m128i hungry = _mm_castps_si128(_mm_cmplt_ps(stomach, hungry_below));
+        hungry = _mm_packs_epi32(hungry, hungry);
+        hungry = _mm_packs_epi16(hungry, hungry);
+        uint32_t bytes;
+        memcpy(&bytes, flags + i, sizeof(bytes));
+        __m128i f = _mm_cvtsi32_si128(static_cast<int>(bytes));
+        f = _mm_or_si128(_mm_andnot_si128(hungry_bit, f), _mm_and_si128(hungry, hungry_bit));
+        bytes = static_cast<uint32_t>(_mm_cvtsi128_si32(f));
+        memcpy(flags + i, &bytes, sizeof(bytes));
+    }
+
+    nutritionScalar(reptiles, i, end, dt);
+}
+
+// ====================================================================================
+// AVX2 (8 lanes, selected at runtime)
+// ====================================================================================
+
+#define SIM_AVX2 __attribute__((target("avx2")))
+
+SIM_AVX2 static inline __m256 equipMask8(__m256i equipment, uint8_t flag)
+{
+    const __m256i bit = _mm256_set1_epi32(flag);
+    return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(equipment, bit), bit));
+}
+
+SIM_AVX2 static void physicsAVX2(TerrariumStore& terra, size_t begin, size_t end, float dt,
+                                 bool daytime, float external_temperature)
+{
+    float* temp_hot = terra.temp_hot_zone.data();
+    float* temp_cold = terra.temp_cold_zone.data();
+    float* humidity = terra.humidity.data();
+    float* uv = terra.uv_index.data();
+    const uint8_t* equipment = terra.equipment.data();
+
+    const __m256 heat_step = _mm256_set1_ps(0.5f * dt);
+    const __m256 cool_step = _mm256_set1_ps(0.3f * dt);
+    const __m256 temp_max = _mm256_set1_ps(35.0f);
+    const __m256 outside = _mm256_set1_ps(external_temperature);
+    const __m256 cold_offset = _mm256_set1_ps(5.0f);
+    const __m256 mist_step = _mm256_set1_ps(1.0f * dt);
+    const __m256 dry_step = _mm256_set1_ps(0.5f * dt);
+    const __m256 humidity_max = _mm256_set1_ps(80.0f);
+    const __m256 humidity_min = _mm256_set1_ps(30.0f);
+    const __m256 day_uv = _mm256_set1_ps(daytime ? 3.0f : 0.0f);
+
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        uint64_t bytes;
+        memcpy(&bytes, equipment + i, sizeof(bytes));
+        const __m256i equip = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(bytes)));
+
+        // Temperature: ramp up to 35 with heater, else decay to outside
+        const __m256 t = _mm256_loadu_ps(temp_hot + i);
+        const __m256 warm = _mm256_min_ps(_mm256_add_ps(t, heat_step), temp_max);
+        const __m256 cool = _mm256_max_ps(_mm256_sub_ps(t, cool_step), outside);
+        const __m256 temp = _mm256_blendv_ps(cool, warm, equipMask8(equip, EQUIP_HEATER));
+        _mm256_storeu_ps(temp_hot + i, temp);
+        _mm256_storeu_ps(temp_cold + i, _mm256_sub_ps(temp, cold_offset));
+
+        // Humidity: mister ramps to 80, else dries to 30
+        const __m256 h = _mm256_loadu_ps(humidity + i);
+        const __m256 wet = _mm256_min_ps(_mm256_add_ps(h, mist_step), humidity_max);
+        const __m256 dry = _mm256_max_ps(_mm256_sub_ps(h, dry_step), humidity_min);
+        _mm256_storeu_ps(humidity + i, _mm256_blendv_ps(dry, wet, equipMask8(equip, EQUIP_MISTER)));
+
+        // UV: 3 with light on during the day, else 0
+        _mm256_storeu_ps(uv + i, _mm256_and_ps(equipMask8(equip, EQUIP_LIGHT), day_uv));
+    }
+
+    physicsSSE2(terra, i, end, dt, daytime, external_temperature);
+}
+
+SIM_AVX2 static void sanitaryAVX2(TerrariumStore& terra, size_t begin, size_t end, float dt)
+{
+    float* waste_level = terra.waste_level.data();
+    float* bacteria_count = terra.bacteria_count.data();
+
+    const __m256 waste_step = _mm256_set1_ps(0.5f * dt);
+    const __m256 growth = _mm256_set1_ps(0.01f);
+    const __m256 step = _mm256_set1_ps(dt);
+    const __m256 limit = _mm256_set1_ps(100.0f);
+
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        const __m256 waste = _mm256_min_ps(_mm256_add_ps(_mm256_loadu_ps(waste_level + i), waste_step), limit);
+        _mm256_storeu_ps(waste_level + i, waste);
+
+        const __m256 b = _mm256_loadu_ps(bacteria_count + i);
+        const __m256 bacteria = _mm256_add_ps(b, _mm256_mul_ps(_mm256_mul_ps(waste, growth), step));
+        _mm256_storeu_ps(bacteria_count + i, _mm256_min_ps(bacteria, limit));
+    }
+
+    sanitarySSE2(terra, i, end, dt);
+}
+
+SIM_AVX2 static void nutritionAVX2(ReptileStore& reptiles, size_t begin, size_t end, float dt)
+{
+    float* stomach_content = reptiles.stomach_content.data();
+    float* bone_density = reptiles.bone_density.data();
+    uint8_t* flags = reptiles.flags.data();
+
+    const __m256 digest_step = _mm256_set1_ps(0.5f * dt);
+    const __m256 bone_step = _mm256_set1_ps(0.1f * dt);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 hungry_below = _mm256_set1_ps(30.0f);
+    const __m256 starving_below = _mm256_set1_ps(20.0f);
+    const __m128i hungry_bit = _mm_set1_epi8(static_cast<char>(REPTILE_FLAG_HUNGRY));
+
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        // Digestion (only while there is something to digest)
+        const __m256 s = _mm256_loadu_ps(stomach_content + i);
+        const __m256 digested = _mm256_max_ps(_mm256_sub_ps(s, digest_step), zero);
+        const __m256 stomach = _mm256_blendv_ps(s, digested, _mm256_cmp_ps(s, zero, _CMP_GT_OQ));
+        _mm256_storeu_ps(stomach_content + i, stomach);
+
+        // Bone density decay without proper nutrition
+        const __m256 b = _mm256_loadu_ps(bone_density + i);
+        const __m256 decayed = _mm256_max_ps(_mm256_sub_ps(b, bone_step), zero);
+        const __m256 starving = _mm256_cmp_ps(stomach, starving_below, _CMP_LT_OQ);
+        _mm256_storeu_ps(bone_density + i, _mm256_blendv_ps(b, decayed, starving));
+
+        // Hunger flag: narrow the lane mask to 8 bytes and merge
+        const __m256i hungry = _mm256_castps_si256(_mm256_cmp_ps(stomach, hungry_below, _CMP_LT_OQ));
+        __m128i mask = _mm_packs_epi32(_mm256_castsi256_si128(hungry), _mm256_extracti128_si256(hungry, 1));
+        mask = _mm_packs_epi16(mask, mask);
+        uint64_t bytes;
+        memcpy(&bytes, flags + i, sizeof(bytes));
+        __m128i f = _mm_cvtsi64_si128(static_cast<long long>(bytes));
+        f = _mm_or_si128(_mm_andnot_si128(hungry_bit, f), _mm_and_si128(mask, hungry_bit));
+        bytes = static_cast<uint64_t>(_mm_cvtsi128_si64(f));
+        memcpy(flags + i, &bytes, sizeof(bytes));
+    }
+
+    nutritionSSE2(reptiles, i, end, dt);
+}
+
+#endif // SIM_KERNELS_X86
+
+// ====================================================================================
+// DISPATCH
+// ====================================================================================
+
+namespace {
+
+struct Kernels {
+    SimdLevel level;
+    void (*physics)(TerrariumStore&, size_t, size_t, float, bool, float);
+    void (*sanitary)(TerrariumStore&, size_t, size_t, float);
+    void (*nutrition)(ReptileStore&, size_t, size_t, float);
+};
+
+const Kernels SCALAR_KERNELS = {SimdLevel::Scalar, physicsScalar, sanitaryScalar, nutritionScalar};
+#if SIM_KERNELS_X86
+const Kernels SSE2_KERNELS = {SimdLevel::SSE2, physicsSSE2, sanitarySSE2, nutritionSSE2};
+const Kernels AVX2_KERNELS = {SimdLevel::AVX2, physicsAVX2, sanitaryAVX2, nutritionAVX2};
+#endif
+
+SimdLevel supportedLevel()
+{
+#if SIM_KERNELS_X86
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+const Kernels* kernelsFor(SimdLevel level)
+{
+#if SIM_KERNELS_X86
+    if (level == SimdLevel::AVX2) return &AVX2_KERNELS;
+    if (level == SimdLevel::SSE2) return &SSE2_KERNELS;
+#endif
+    (void)level;
+    return &SCALAR_KERNELS;
+}
+
+// Resolved on first use; may be first hit from a parallel tick worker
+std::atomic<const Kernels*> g_kernels{nullptr};
+
+inline const Kernels& kernels()
+{
+    const Kernels* k = g_kernels.load(std::memory_order_acquire);
+    if (!k) {
+        k = kernelsFor(supportedLevel());
+        g_kernels.store(k, std::memory_order_release);
+    }
+    return *k;
+}
+
+} // namespace
+
+SimdLevel simdLevel()
+{
+    return kernels().level;
+}
+
+void setSimdLevel(SimdLevel level)
+{
+    const SimdLevel supported = supportedLevel();
+    g_kernels.store(kernelsFor(level < supported ? level : supported), std::memory_order_release);
+}
+
+void physicsKernel(TerrariumStore& terra, size_t begin, size_t end, float dt,
+                   bool daytime, float external_temperature)
+{
+    kernels().physics(terra, begin, end, dt, daytime, external_temperature);
+}
+
+void sanitaryKernel(TerrariumStore& terra, size_t begin, size_t end, float dt)
+{
+    kernels().sanitary(terra, begin, end, dt);
+}
+
+void nutritionKernel(ReptileStore& reptiles, size_t begin, size_t end, float dt)
+{
+    kernels().nutrition(reptiles, begin, end, dt);
+}
+
+} // namespace ReptileSim
@@ -0,0 +1,44 @@
+/**
+ * @file sim_kernels.hpp
+ * @brief Vectorized column kernels for physics, sanitary and nutrition
+ *
+ * Each kernel updates entities [begin, end) of a store column-wise. On x86
+ * the widest supported instruction set (AVX2, else SSE2) is picked once at
+ * runtime; everything else runs the scalar stage functions. The vector code
+ * is branch-free (min/max clamps, mask blends) but performs the same float
+ * operations in the same order as the stages, so results are identical.
+ *
+ * Define REPTILE_SIM_NO_SIMD to build the scalar path only.
+ */
+
+#ifndef SIM_KERNELS_HPP
+#define SIM_KERNELS_HPP
+
+#include "../include/game_state.hpp"
+
+namespace ReptileSim {
+
+enum class SimdLevel : uint8_t {
+    Scalar,
+    SSE2,
+    AVX2,
+};
+
+/**
+ * @brief Instruction set used by the kernels on this machine
+ */
+SimdLevel simdLevel();
+
+/**
+ * @brief Override the runtime choice (clamped to what the CPU supports)
+ */
+void setSimdLevel(SimdLevel level);
+
+void physicsKernel(TerrariumStore& terra, size_t begin, size_t end, float dt,
+                   bool daytime, float external_temperature);
+void sanitaryKernel(TerrariumStore& terra, size_t begin, size_t end, float dt);
+void nutritionKernel(ReptileStore& reptiles, size_t begin, size_t end, float dt);
+
+} // namespace ReptileSim
+
+#endif // SIM_KERNELS_HPP
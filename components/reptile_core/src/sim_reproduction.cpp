@@ -4,6 +4,7 @@
  */
 
 #include "../include/game_state.hpp"
+#include "sim_stages.hpp"
 
 namespace ReptileSim {
 
@@ -30,37 +31,16 @@ void updateReproduction(GameState& state, float dt)
     // - incubation_temperature
 
     // For now, only simulate reproductive stress factors
-    for (auto& reptile : state.reptiles) {
-        // Find terrarium
-        Terrarium* terra = nullptr;
-        for (auto& t : state.terrariums) {
-            if (t.id == reptile.assigned_terrarium_id) {
-                terra = &t;
-                break;
-            }
-        }
-
-        if (!terra) continue;
-
-        // Dystocia risk factors:
-        // 1. Low calcium (bone density)
-        // 2. Inadequate basking temperature
-        // 3. Stress
-        // 4. Dehydration
-
-        // Simulate calcium needs for egg production
-        if (reptile.bone_density < 80.0f) {
-            // Low calcium increases stress (gravid females need extra Ca)
-            reptile.stress_level += 0.1f * dt;
-        }
-
-        // Temperature too low for reproductive health
-        if (terra->temp_hot_zone < 30.0f) {
-            reptile.stress_level += 0.05f * dt;
-        }
-
-        // Clamp stress
-        if (reptile.stress_level > 100.0f) reptile.stress_level = 100.0f;
+    // Dystocia risk factors:
+    // 1. Low calcium (bone density)
+    // 2. Inadequate basking temperature
+    // 3. Stress
+    // 4. Dehydration
+    const StageContext ctx = {&state.terrariums, &state.occupancy, dt, false, false};
+    const size_t count = state.reptiles.size();
+
+    for (size_t i = 0; i < count; i++) {
+        reproductionStage(state.reptiles, i, ctx);
     }
 
     // TODO: Add gravid state to Reptile struct
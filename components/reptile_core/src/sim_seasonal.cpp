@@ -4,10 +4,22 @@
  */
 
 #include "../include/game_state.hpp"
-#include <cmath>
+#include "sim_calendar.hpp"
+#include "sim_stages.hpp"
 
 namespace ReptileSim {
 
+void seasonalContext(const GameState& state, bool& brumation_season, bool& should_be_dark)
+{
+    // Photoperiod and brumation season for the day of year (tabulated)
+    const CalendarDay& day = calendarDay(state.game_day);
+    brumation_season = day.brumation_season;
+
+    // Photoperiod mismatch window (lights on during "night" hours)
+    should_be_dark = (state.game_time_hours < day.dawn_hours ||
+                      state.game_time_hours > day.dusk_hours);
+}
+
 /**
  * @brief Update seasonal cycles (brumation, photoperiod)
  *
@@ -18,46 +30,12 @@ namespace ReptileSim {
  */
 void updateSeasonal(GameState& state, float dt)
 {
-    // Calculate day of year (1-365)
-    uint32_t day_of_year = (state.game_day - 1) % 365 + 1;
-
-    // Calculate photoperiod (hours of daylight)
-    // Peak at day 172 (summer solstice), minimum at day 355 (winter solstice)
-    const float PI = 3.14159265f;
-    float photoperiod_hours = 12.0f + 2.5f * std::sin(2.0f * PI * (day_of_year - 80) / 365.0f);
-
-    // Brumation season (days 300-365 and 1-60 = winter)
-    bool brumation_season = (day_of_year >= 300 || day_of_year <= 60);
-
-    for (auto& reptile : state.reptiles) {
-        // Find terrarium
-        Terrarium* terra = nullptr;
-        for (auto& t : state.terrariums) {
-            if (t.id == reptile.assigned_terrarium_id) {
-                terra = &t;
-                break;
-            }
-        }
-
-        if (!terra) continue;
-
-        // If brumation season and temperature is kept high, increase stress
-        if (brumation_season && terra->temp_hot_zone > 25.0f) {
-            reptile.stress_level += 0.5f * dt;
-        }
-
-        // Photoperiod mismatch (lights on during "night" hours)
-        float natural_night_start = 12.0f + photoperiod_hours / 2.0f;
-        bool should_be_dark = (state.game_time_hours < (24.0f - natural_night_start) ||
-                               state.game_time_hours > natural_night_start);
-
-        if (terra->light_on && should_be_dark) {
-            reptile.stress_level += 0.2f * dt;
-        }
+    StageContext ctx = {&state.terrariums, &state.occupancy, dt, false, false};
+    seasonalContext(state, ctx.brumation_season, ctx.should_be_dark);
 
-        // Clamp stress
-        if (reptile.stress_level < 0.0f) reptile.stress_level = 0.0f;
-        if (reptile.stress_level > 100.0f) reptile.stress_level = 100.0f;
+    const size_t count = state.reptiles.size();
+    for (size_t i = 0; i < count; i++) {
+        seasonalStage(state.reptiles, i, ctx);
     }
 }
 
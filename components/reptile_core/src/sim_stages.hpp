@@ -0,0 +1,352 @@
+/**
+ * @file sim_stages.hpp
+ * @brief Per-reptile engine stages shared by the sequential and fused ticks
+ *
+ * Each stage updates a single reptile (or terrarium) in place. The
+ * sequential engines loop a single stage over the herd; the fused and
+ * parallel pipelines run every stage on one entity before moving to the
+ * next. All call the same code, so the float operations (and results) are
+ * identical.
+ */
+
+#ifndef SIM_STAGES_HPP
+#define SIM_STAGES_HPP
+
+#include "../include/game_state.hpp"
+#include <cstring>
+
+namespace ReptileSim {
+
+/**
+ * @brief Per-tick inputs shared by all reptiles
+ */
+struct StageContext {
+    const TerrariumStore* terra;
+    const OccupancyIndex* occupancy;    // Social: occupants per terrarium
+    float dt;
+    bool brumation_season;      // Seasonal: winter rest expected
+    bool should_be_dark;        // Seasonal: outside natural photoperiod
+};
+
+/**
+ * @brief Seasonal inputs for the current day/time (evaluated once per tick)
+ */
+void seasonalContext(const GameState& state, bool& brumation_season, bool& should_be_dark);
+
+// ====================================================================================
+// TERRARIUM STAGES
+// ====================================================================================
+
+// Physics: heater, mister and day/night UV
+inline void physicsStage(TerrariumStore& terra, size_t i, float dt,
+                         bool daytime, float external_temperature)
+{
+    const uint8_t equipment = terra.equipment[i];
+
+    // Temperature simulation (simplified)
+    float temp = terra.temp_hot_zone[i];
+    if (equipment & EQUIP_HEATER) {
+        temp += 0.5f * dt;
+        if (temp > 35.0f) temp = 35.0f;
+    } else {
+        temp -= 0.3f * dt;
+        if (temp < external_temperature) {
+            temp = external_temperature;
+        }
+    }
+    terra.temp_hot_zone[i] = temp;
+    terra.temp_cold_zone[i] = temp - 5.0f;
+
+    // Humidity
+    float humidity = terra.humidity[i];
+    if (equipment & EQUIP_MISTER) {
+        humidity += 1.0f * dt;
+        if (humidity > 80.0f) humidity = 80.0f;
+    } else {
+        humidity -= 0.5f * dt;
+        if (humidity < 30.0f) humidity = 30.0f;
+    }
+    terra.humidity[i] = humidity;
+
+    // UV (day/night cycle)
+    if (daytime && (equipment & EQUIP_LIGHT)) {
+        terra.uv_index[i] = 3.0f; // Daytime UV
+    } else {
+        terra.uv_index[i] = 0.0f; // Night
+    }
+}
+
+// Sanitary: waste and bacteria growth
+inline void sanitaryStage(TerrariumStore& terra, size_t i, float dt)
+{
+    // Waste accumulation
+    float waste = terra.waste_level[i] + 0.5f * dt;
+    if (waste > 100.0f) waste = 100.0f;
+    terra.waste_level[i] = waste;
+
+    // Bacteria growth
+    float bacteria = terra.bacteria_count[i] + (waste * 0.01f) * dt;
+    if (bacteria > 100.0f) bacteria = 100.0f;
+    terra.bacteria_count[i] = bacteria;
+}
+
+// ====================================================================================
+// REPTILE STAGES
+// ====================================================================================
+
+inline void clampStress(float& stress)
+{
+    if (stress < 0.0f) stress = 0.0f;
+    if (stress > 100.0f) stress = 100.0f;
+}
+
+// Biology: thermal stress and health status
+inline void biologyStage(ReptileStore& r, size_t i, const StageContext& ctx)
+{
+    const uint32_t t = r.terrarium_index[i];
+    const float dt = ctx.dt;
+
+    float stress = r.stress_level[i];
+    if (t == SlotMap::INVALID) {
+        // No terrarium = extreme stress
+        stress += 5.0f * dt;
+        if (stress > 100.0f) stress = 100.0f;
+        r.stress_level[i] = stress;
+        return;
+    }
+
+    // Temperature stress
+    float temp = ctx.terra->temp_hot_zone[t];
+    if (temp < 28.0f || temp > 38.0f) {
+        stress += 1.0f * dt;
+    } else {
+        stress -= 0.5f * dt;
+    }
+
+    clampStress(stress);
+    r.stress_level[i] = stress;
+
+    // Health status
+    r.setFlag(i, REPTILE_FLAG_HEALTHY,
+              stress < 50.0f &&
+              r.immune_system[i] > 60.0f &&
+              r.bone_density[i] > 60.0f);
+}
+
+// Nutrition: digestion, hunger, bone density
+inline void nutritionStage(ReptileStore& r, size_t i, const StageContext& ctx)
+{
+    const float dt = ctx.dt;
+
+    // Digestion
+    float stomach = r.stomach_content[i];
+    if (stomach > 0.0f) {
+        stomach -= 0.5f * dt;
+        if (stomach < 0.0f) stomach = 0.0f;
+        r.stomach_content[i] = stomach;
+    }
+
+    // Hunger
+    r.setFlag(i, REPTILE_FLAG_HUNGRY, stomach < 30.0f);
+
+    // Bone density decay without proper nutrition
+    if (stomach < 20.0f) {
+        float bone = r.bone_density[i] - 0.1f * dt;
+        if (bone < 0.0f) bone = 0.0f;
+        r.bone_density[i] = bone;
+    }
+}
+
+// Behavior: enclosure size vs body weight
+inline void behaviorStage(ReptileStore& r, size_t i, const StageContext& ctx)
+{
+    const uint32_t t = r.terrarium_index[i];
+    if (t == SlotMap::INVALID) return;
+    const float dt = ctx.dt;
+
+    // Enclosure volume (cm³)
+    float volume = ctx.terra->volume[t];
+
+    // Minimum space requirement (based on animal weight)
+    // Rule of thumb: 1 gram needs ~300 cm³ minimum
+    float required_volume = r.weight_grams[i] * 300.0f;
+
+    // Inadequate space increases stress
+    float stress = r.stress_level[i];
+    if (volume < required_volume) {
+        float space_ratio = volume / required_volume;
+        stress += (1.0f - space_ratio) * 2.0f * dt;
+    } else {
+        // Adequate space reduces stress (enrichment effect)
+        stress -= 0.3f * dt;
+    }
+
+    clampStress(stress);
+    r.stress_level[i] = stress;
+}
+
+// Genetics: slow immune drift
+inline void geneticsStage(ReptileStore& r, size_t i, const StageContext& ctx)
+{
+    float immune = r.immune_system[i] - 0.001f * ctx.dt;
+    if (immune < 0.0f) immune = 0.0f;
+    r.immune_system[i] = immune;
+}
+
+// Reproduction: dystocia risk factors
+inline void reproductionStage(ReptileStore& r, size_t i, const StageContext& ctx)
+{
+    const uint32_t t = r.terrarium_index[i];
+    if (t == SlotMap::INVALID) return;
+    const float dt = ctx.dt;
+
+    // Low calcium increases stress (gravid females need extra Ca)
+    float stress = r.stress_level[i];
+    if (r.bone_density[i] < 80.0f) {
+        stress += 0.1f * dt;
+    }
+
+    // Temperature too low for reproductive health
+    if (ctx.terra->temp_hot_zone[t] < 30.0f) {
+        stress += 0.05f * dt;
+    }
+
+    if (stress > 100.0f) stress = 100.0f;
+    r.stress_level[i] = stress;
+}
+
+// Social: crowding and hierarchy for one occupant of a shared terrarium
+inline void socialOccupantStage(ReptileStore& r, size_t i, float volume, int occupants, float dt)
+{
+    // Calculate volume per animal
+    float volume_per_animal = volume / occupants;
+
+    // Minimum space per animal: 200,000 cm³
+    if (volume_per_animal < 200000.0f) {
+        // Overcrowding causes social stress
+        float crowding_factor = 1.0f - (volume_per_animal / 200000.0f);
+        r.stress_level[i] += crowding_factor * 1.5f * dt;
+
+        // Competition for food (weaker animals get less)
+        if (r.immune_system[i] < 70.0f) {
+            r.stomach_content[i] -= 0.3f * dt;
+            if (r.stomach_content[i] < 0.0f) r.stomach_content[i] = 0.0f;
+        }
+    }
+
+    // Hierarchy stress (submissive animals always stressed)
+    if (r.immune_system[i] < 80.0f) {
+        r.stress_level[i] += 0.4f * dt;
+    }
+}
+
+// Social: full stage for one reptile (occupancy already counted)
+inline void socialStage(ReptileStore& r, size_t i, const StageContext& ctx)
+{
+    const uint32_t t = r.terrarium_index[i];
+    if (t != SlotMap::INVALID) {
+        const int occupants = static_cast<int>(ctx.occupancy->count(t));
+        if (occupants > 1) {
+            socialOccupantStage(r, i, ctx.terra->volume[t], occupants, ctx.dt);
+        }
+    }
+    clampStress(r.stress_level[i]);
+}
+
+// Seasonal: brumation and photoperiod
+inline void seasonalStage(ReptileStore& r, size_t i, const StageContext& ctx)
+{
+    const uint32_t t = r.terrarium_index[i];
+    if (t == SlotMap::INVALID) return;
+    const float dt = ctx.dt;
+
+    // If brumation season and temperature is kept high, increase stress
+    float stress = r.stress_level[i];
+    if (ctx.brumation_season && ctx.terra->temp_hot_zone[t] > 25.0f) {
+        stress += 0.5f * dt;
+    }
+
+    // Photoperiod mismatch (lights on during "night" hours)
+    if (ctx.should_be_dark && ctx.terra->hasEquipment(t, EQUIP_LIGHT)) {
+        stress += 0.2f * dt;
+    }
+
+    clampStress(stress);
+    r.stress_level[i] = stress;
+}
+
+/**
+ * @brief All per-reptile stages for one reptile, in sequential engine order
+ */
+inline void fusedReptileStages(ReptileStore& r, size_t i, const StageContext& ctx)
+{
+    biologyStage(r, i, ctx);
+    nutritionStage(r, i, ctx);
+    behaviorStage(r, i, ctx);
+    geneticsStage(r, i, ctx);
+    reproductionStage(r, i, ctx);
+    socialStage(r, i, ctx);
+    seasonalStage(r, i, ctx);
+}
+
+// ====================================================================================
+// SLEEP / WAKE
+// ====================================================================================
+
+inline bool sameBits(float a, float b)
+{
+    uint32_t x, y;
+    std::memcpy(&x, &a, sizeof(x));
+    std::memcpy(&y, &b, sizeof(y));
+    return x == y;
+}
+
+/**
+ * @brief Fused stages for one reptile, flagging it asleep if nothing moved
+ *
+ * The stages are a pure function of the reptile's own columns, its bucket
+ * inputs and the StageContext. If one pass leaves the columns unchanged,
+ * every further pass with the same inputs does too.
+ * @return true if the reptile is still awake
+ */
+inline bool settleReptile(ReptileStore& r, size_t i, const StageContext& ctx)
+{
+    const float stress = r.stress_level[i];
+    const float stomach = r.stomach_content[i];
+    const float immune = r.immune_system[i];
+    const float bone = r.bone_density[i];
+    const uint8_t flags = r.flags[i] & ~REPTILE_FLAG_ASLEEP;
+
+    fusedReptileStages(r, i, ctx);
+
+    const bool settled = sameBits(stress, r.stress_level[i]) &&
+                         sameBits(stomach, r.stomach_content[i]) &&
+                         sameBits(immune, r.immune_system[i]) &&
+                         sameBits(bone, r.bone_density[i]) &&
+                         flags == (r.flags[i] & ~REPTILE_FLAG_ASLEEP);
+    r.setFlag(i, REPTILE_FLAG_ASLEEP, settled);
+    return !settled;
+}
+
+/**
+ * @brief Fused stages over reptiles [begin, end) of a bucket
+ *
+ * @param inputs_same Bucket inputs and StageContext equal last tick's, so
+ *                    sleepers can be skipped
+ * @return Reptiles left awake
+ */
+inline uint32_t settleBucket(ReptileStore& r, const uint32_t* members, uint32_t begin, uint32_t end,
+                             const StageContext& ctx, bool inputs_same)
+{
+    uint32_t awake = 0;
+    for (uint32_t j = begin; j < end; j++) {
+        const uint32_t i = members[j];
+        if (inputs_same && r.hasFlag(i, REPTILE_FLAG_ASLEEP)) continue;
+        if (settleReptile(r, i, ctx)) awake++;
+    }
+    return awake;
+}
+
+} // namespace ReptileSim
+
+#endif // SIM_STAGES_HPP
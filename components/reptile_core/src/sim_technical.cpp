@@ -4,6 +4,8 @@
  */
 
 #include "../include/game_state.hpp"
+#include "sim_fast_forward.hpp"
+#include <cmath>
 #include <cstdlib>
 
 namespace ReptileSim {
@@ -17,6 +19,42 @@ static float simple_random()
     return (float)(simple_rand_state % 10000) / 10000.0f;
 }
 
+uint32_t technicalRandomState()
+{
+    return simple_rand_state;
+}
+
+void setTechnicalRandomState(uint32_t state)
+{
+    simple_rand_state = state;
+}
+
+// Uniform in (0, 1) from the same stream, with full resolution
+static double simple_random_unit()
+{
+    simple_rand_state = simple_rand_state * 1103515245 + 12345;
+    return ((simple_rand_state >> 8) + 0.5) / 16777216.0;
+}
+
+// Chance that simple_random() < threshold. simple_random() only returns
+// multiples of 1e-4, so any positive threshold below that still fails one
+// draw in 10000.
+static double drawProbability(float threshold)
+{
+    if (threshold <= 0.0f) return 0.0;
+    double steps = std::ceil(static_cast<double>(threshold) * 10000.0);
+    return (steps >= 10000.0) ? 1.0 : steps / 10000.0;
+}
+
+// First failing tick of a per-tick Bernoulli(p) draw, 0 if beyond `ticks`
+static uint32_t sampleFailureTick(double p, uint32_t ticks)
+{
+    if (p <= 0.0) return 0;
+    if (p >= 1.0) return 1;
+    double tick = std::floor(std::log(simple_random_unit()) / std::log1p(-p)) + 1.0;
+    return (tick <= ticks) ? static_cast<uint32_t>(tick) : 0;
+}
+
 /**
  * @brief Update technical aspects (equipment MTBF, failures)
  *
@@ -27,41 +65,77 @@ static float simple_random()
  */
 void updateTechnical(GameState& state, float dt)
 {
-    for (auto& terra : state.terrariums) {
+    TerrariumStore& terra = state.terrariums;
+    const size_t count = terra.size();
+
+    for (size_t i = 0; i < count; i++) {
         // Equipment failure probability (very low, but increases over time)
         // Assume MTBF = 8760 hours (1 year) for heaters
         // Failure rate per second = 1 / (MTBF * 3600)
         float heater_failure_rate = 1.0f / (8760.0f * 3600.0f);
 
         // Random heater failure
-        if (terra.heater_on && simple_random() < (heater_failure_rate * dt)) {
-            terra.heater_on = false;
+        if (terra.hasEquipment(i, EQUIP_HEATER) && simple_random() < (heater_failure_rate * dt)) {
+            terra.setEquipment(i, EQUIP_HEATER, false);
             // In a real system, this would trigger an alert
         }
 
         // Light failure (slightly more frequent, MTBF = 5000 hours)
         float light_failure_rate = 1.0f / (5000.0f * 3600.0f);
-        if (terra.light_on && simple_random() < (light_failure_rate * dt)) {
-            terra.light_on = false;
+        if (terra.hasEquipment(i, EQUIP_LIGHT) && simple_random() < (light_failure_rate * dt)) {
+            terra.setEquipment(i, EQUIP_LIGHT, false);
         }
 
         // Mister failure (MTBF = 3000 hours)
         float mister_failure_rate = 1.0f / (3000.0f * 3600.0f);
-        if (terra.mister_on && simple_random() < (mister_failure_rate * dt)) {
-            terra.mister_on = false;
+        if (terra.hasEquipment(i, EQUIP_MISTER) && simple_random() < (mister_failure_rate * dt)) {
+            terra.setEquipment(i, EQUIP_MISTER, false);
         }
 
         // Power outage simulation (very rare: 0.01% chance per game day)
         if (simple_random() < (0.0001f * dt / 86400.0f)) {
             // All equipment fails simultaneously
-            terra.heater_on = false;
-            terra.light_on = false;
-            terra.mister_on = false;
+            terra.setEquipment(i, EQUIP_HEATER, false);
+            terra.setEquipment(i, EQUIP_LIGHT, false);
+            terra.setEquipment(i, EQUIP_MISTER, false);
         }
     }
 
+    updateTechnicalCosts(state, dt);
+}
+
+void updateTechnicalCosts(GameState& state, float dt)
+{
     // Increase electricity cost slightly for aging equipment
     state.economy.electricity_cost += 0.001f * dt;
 }
 
+EquipmentFailures sampleEquipmentFailures(uint8_t equipment, uint32_t ticks, float dt)
+{
+    // Rates as in updateTechnical()
+    const float heater_failure_rate = 1.0f / (8760.0f * 3600.0f);
+    const float light_failure_rate = 1.0f / (5000.0f * 3600.0f);
+    const float mister_failure_rate = 1.0f / (3000.0f * 3600.0f);
+
+    EquipmentFailures failures = {0, 0, 0};
+    if (equipment & EQUIP_HEATER) {
+        failures.heater = sampleFailureTick(drawProbability(heater_failure_rate * dt), ticks);
+    }
+    if (equipment & EQUIP_LIGHT) {
+        failures.light = sampleFailureTick(drawProbability(light_failure_rate * dt), ticks);
+    }
+    if (equipment & EQUIP_MISTER) {
+        failures.mister = sampleFailureTick(drawProbability(mister_failure_rate * dt), ticks);
+    }
+
+    // Power outage takes down whatever is still running
+    uint32_t outage = sampleFailureTick(drawProbability(0.0001f * dt / 86400.0f), ticks);
+    if (outage != 0) {
+        if ((equipment & EQUIP_HEATER) && (failures.heater == 0 || outage < failures.heater)) failures.heater = outage;
+        if ((equipment & EQUIP_LIGHT) && (failures.light == 0 || outage < failures.light)) failures.light = outage;
+        if ((equipment & EQUIP_MISTER) && (failures.mister == 0 || outage < failures.mister)) failures.mister = outage;
+    }
+    return failures;
+}
+
 } // namespace ReptileSim
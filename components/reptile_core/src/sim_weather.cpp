@@ -4,7 +4,7 @@
  */
 
 #include "../include/game_state.hpp"
-#include <cmath>
+#include "sim_calendar.hpp"
 
 namespace ReptileSim {
 
@@ -27,16 +27,11 @@ namespace ReptileSim {
 void updateWeather(GameState& state, float dt)
 {
     // Without network integration, simulate seasonal weather patterns
-    // Day of year (1-365)
-    uint32_t day_of_year = (state.game_day - 1) % 365 + 1;
+    // Seasonal temperature variation (tabulated per day of year)
+    float base_temp = calendarDay(state.game_day).base_temperature;
 
-    // Seasonal temperature variation
-    // Peak in summer (day 172), minimum in winter (day 355)
-    const float PI = 3.14159265f;
-    float base_temp = 15.0f + 10.0f * std::sin(2.0f * PI * (day_of_year - 80) / 365.0f);
-
-    // Daily variation
-    float hour_offset = std::sin(2.0f * PI * (state.game_time_hours - 6.0f) / 24.0f);
+    // Daily variation (tabulated per game minute)
+    float hour_offset = dailyTemperatureWave(state.game_clock_ms);
     state.external_temperature = base_temp + 5.0f * hour_offset;
 
     // Humidity variation (inverse of temperature)
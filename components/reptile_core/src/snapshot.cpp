@@ -0,0 +1,609 @@
+/**
+ * @file snapshot.cpp
+ * @brief Versioned binary save file (column snapshot)
+ */
+
+#include "snapshot.hpp"
+#include "compression.hpp"
+#include "crc32.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#if !defined(ESP_PLATFORM) && defined(__unix__)
+#define SNAPSHOT_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define SNAPSHOT_MMAP 0
+#endif
+
+// Host saves encode sections on several threads; on device the second core
+// belongs to the tick
+#if !defined(ESP_PLATFORM)
+#define SNAPSHOT_THREADS 1
+#include <atomic>
+#include <thread>
+#else
+#define SNAPSHOT_THREADS 0
+#endif
+
+// Columns are written and read as raw arrays in host byte order
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "snapshot columns are stored little-endian; add byte swapping for this target"
+#endif
+
+namespace ReptileSim {
+
+namespace {
+
+// SNAP_GAME payload
+struct GameSection {
+    uint64_t game_clock_ms;
+    float external_temperature;
+    float external_humidity;
+    uint32_t heatwave_active;
+    Economy economy;
+    uint32_t reserved;
+};
+static_assert(sizeof(GameSection) == 40, "on-disk layout");
+
+// Sanity cap on the section table (v1 writes up to 27 sections)
+constexpr uint32_t MAX_SECTIONS = 1024;
+
+// Smaller sections are stored raw: the gain would not cover the overhead
+constexpr uint64_t MIN_COMPRESS_BYTES = 256;
+
+// Sanity cap on a decoded section relative to the file (LZ tops out near 255:1)
+constexpr uint64_t MAX_EXPANSION = 256;
+
+// Host: encode on several threads once a save has this many bytes
+constexpr uint64_t PARALLEL_ENCODE_BYTES = 1u << 20;
+
+uint64_t alignUp(uint64_t offset)
+{
+    return (offset + SNAPSHOT_ALIGN - 1) & ~static_cast<uint64_t>(SNAPSHOT_ALIGN - 1);
+}
+
+/**
+ * @brief Every stored column, in file order
+ *
+ * Shared by the writer and the reader so the two cannot drift apart.
+ * Works on const and non-const stores.
+ */
+template <typename Reptiles, typename Terrariums, typename Visitor>
+void visitColumns(Reptiles& r, Terrariums& t, Visitor&& visit)
+{
+    visit(SNAP_REPTILE_ID, r.id);
+    visit(SNAP_REPTILE_WEIGHT, r.weight_grams);
+    visit(SNAP_REPTILE_BONE_DENSITY, r.bone_density);
+    visit(SNAP_REPTILE_HYDRATION, r.hydration);
+    visit(SNAP_REPTILE_STRESS, r.stress_level);
+    visit(SNAP_REPTILE_STOMACH, r.stomach_content);
+    visit(SNAP_REPTILE_IMMUNE, r.immune_system);
+    visit(SNAP_REPTILE_TERRARIUM, r.assigned_terrarium_id);
+    visit(SNAP_REPTILE_FLAGS, r.flags);
+    visit(SNAP_REPTILE_NAME, r.name);
+    visit(SNAP_REPTILE_SPECIES, r.species);
+
+    visit(SNAP_TERRARIUM_ID, t.id);
+    visit(SNAP_TERRARIUM_TEMP_HOT, t.temp_hot_zone);
+    visit(SNAP_TERRARIUM_TEMP_COLD, t.temp_cold_zone);
+    visit(SNAP_TERRARIUM_HUMIDITY, t.humidity);
+    visit(SNAP_TERRARIUM_UV, t.uv_index);
+    visit(SNAP_TERRARIUM_WASTE, t.waste_level);
+    visit(SNAP_TERRARIUM_BACTERIA, t.bacteria_count);
+    visit(SNAP_TERRARIUM_VOLUME, t.volume);
+    visit(SNAP_TERRARIUM_EQUIPMENT, t.equipment);
+    visit(SNAP_TERRARIUM_WIDTH, t.width);
+    visit(SNAP_TERRARIUM_HEIGHT, t.height);
+    visit(SNAP_TERRARIUM_DEPTH, t.depth);
+}
+
+// ====================================================================================
+// WRITER
+// ====================================================================================
+
+struct PendingSection {
+    SnapshotSection entry;
+    const void* data;
+    std::vector<uint8_t> owned;     // Encoded payload (strings, game, compressed)
+    BlockFilter filter;             // Applied before LZ when compressing
+    uint32_t width;                 // Value width for the filter
+};
+
+/**
+ * @brief Collects sections; fixed-width columns are written in place
+ *
+ * Lengths and CRCs are filled in by encodeSections().
+ */
+struct SectionCollector {
+    std::vector<PendingSection> sections;
+
+    void add(uint32_t id, const void* data, size_t length, BlockFilter filter = FILTER_NONE, uint32_t width = 1)
+    {
+        PendingSection p = {};
+        p.entry.id = id;
+        p.entry.length = length;
+        p.entry.raw_length = length;
+        p.data = data;
+        p.filter = filter;
+        p.width = width;
+        sections.push_back(std::move(p));
+    }
+
+    void addOwned(uint32_t id, std::vector<uint8_t>&& bytes)
+    {
+        add(id, nullptr, bytes.size());
+        sections.back().owned = std::move(bytes);
+        sections.back().data = sections.back().owned.data();
+    }
+
+    template <typename T>
+    void operator()(uint32_t id, const std::vector<T>& column)
+    {
+        // Ids ascend and most floats change slowly from one entity to the
+        // next, so 32-bit columns compress best as deltas
+        const BlockFilter filter = (sizeof(T) == 4) ? FILTER_DELTA_SHUFFLE : FILTER_SHUFFLE;
+        add(id, column.data(), column.size() * sizeof(T), filter, sizeof(T));
+    }
+
+    void operator()(uint32_t id, const std::vector<uint8_t>& column)
+    {
+        if (id != SNAP_REPTILE_FLAGS) {
+            add(id, column.data(), column.size(), FILTER_SHUFFLE, 1);
+            return;
+        }
+        // ASLEEP depends on the tick mode and is cleared on load; leave it
+        // out so every mode saves the same bytes
+        std::vector<uint8_t> flags(column);
+        for (uint8_t& f : flags) {
+            f = static_cast<uint8_t>(f & ~REPTILE_FLAG_ASLEEP);
+        }
+        addOwned(id, std::move(flags));
+        sections.back().filter = FILTER_SHUFFLE;
+    }
+
+    void operator()(uint32_t id, const std::vector<std::string>& column)
+    {
+        // n + 1 end offsets (the first is 0), then the characters
+        const size_t n = column.size();
+        std::vector<uint32_t> ends(n + 1);
+        size_t chars = 0;
+        for (size_t i = 0; i < n; i++) {
+            chars += column[i].size();
+            ends[i + 1] = static_cast<uint32_t>(chars);
+        }
+        std::vector<uint8_t> bytes((n + 1) * sizeof(uint32_t) + chars);
+        memcpy(bytes.data(), ends.data(), (n + 1) * sizeof(uint32_t));
+        uint8_t* out = bytes.data() + (n + 1) * sizeof(uint32_t);
+        for (const std::string& s : column) {
+            memcpy(out, s.data(), s.size());
+            out += s.size();
+        }
+        addOwned(id, std::move(bytes));
+    }
+};
+
+// Compress (if asked and worthwhile) and checksum the stored bytes
+void encodeSection(PendingSection& p, bool compress)
+{
+    std::vector<uint8_t> encoded;
+    uint32_t encoding = 0;
+    if (compress && p.entry.raw_length >= MIN_COMPRESS_BYTES &&
+        encodeBlock(p.data, static_cast<size_t>(p.entry.raw_length), p.filter, p.width, encoded, encoding)) {
+        p.owned = std::move(encoded);
+        p.data = p.owned.data();
+        p.entry.encoding = encoding;
+        p.entry.length = p.owned.size();
+    }
+    p.entry.crc = crc32(p.data, static_cast<size_t>(p.entry.length));
+}
+
+void encodeSections(std::vector<PendingSection>& sections, bool compress)
+{
+#if SNAPSHOT_THREADS
+    uint64_t total = 0;
+    for (const PendingSection& p : sections) total += p.entry.raw_length;
+    const size_t threads = std::min<size_t>(std::thread::hardware_concurrency(), sections.size());
+    if (total >= PARALLEL_ENCODE_BYTES && threads > 1) {
+        // Sections are independent; each thread takes the next one
+        std::atomic<size_t> next{0};
+        auto work = [&] {
+            for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < sections.size();) {
+                encodeSection(sections[i], compress);
+            }
+        };
+        std::vector<std::thread> helpers;
+        for (size_t k = 1; k < threads; k++) helpers.emplace_back(work);
+        work();
+        for (std::thread& t : helpers) t.join();
+        return;
+    }
+#endif
+    for (PendingSection& p : sections) encodeSection(p, compress);
+}
+
+bool writePadding(FILE* f, uint64_t& pos, uint64_t to)
+{
+    static const uint8_t zeros[SNAPSHOT_ALIGN] = {};
+    const size_t n = static_cast<size_t>(to - pos);
+    pos = to;
+    return n == 0 || fwrite(zeros, 1, n, f) == n;
+}
+
+// ====================================================================================
+// READER
+// ====================================================================================
+
+/**
+ * @brief Read-only view of a snapshot file
+ *
+ * mmap on Linux (columns are memcpy'd straight out of the page cache);
+ * elsewhere, one fread per section into the destination.
+ */
+class SnapshotFile {
+public:
+    SnapshotFile() = default;
+    SnapshotFile(const SnapshotFile&) = delete;
+    SnapshotFile& operator=(const SnapshotFile&) = delete;
+
+    ~SnapshotFile()
+    {
+#if SNAPSHOT_MMAP
+        if (m_map) munmap(const_cast<uint8_t*>(m_map), m_size);
+#else
+        if (m_file) fclose(m_file);
+#endif
+    }
+
+    bool open(const char* path)
+    {
+#if SNAPSHOT_MMAP
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            close(fd);
+            return false;
+        }
+        m_size = static_cast<size_t>(st.st_size);
+        void* map = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (map == MAP_FAILED) return false;
+        madvise(map, m_size, MADV_SEQUENTIAL);
+        m_map = static_cast<const uint8_t*>(map);
+        return true;
+#else
+        m_file = fopen(path, "rb");
+        if (!m_file) return false;
+        if (fseek(m_file, 0, SEEK_END) != 0) return false;
+        const long size = ftell(m_file);
+        if (size <= 0) return false;
+        m_size = static_cast<uint64_t>(size);
+        return true;
+#endif
+    }
+
+    uint64_t size() const { return m_size; }
+
+    /**
+     * @brief Point at `length` bytes: into the map, or read into scratch
+     */
+    bool view(uint64_t offset, uint64_t length, std::vector<uint8_t>& scratch, const uint8_t*& out)
+    {
+        if (offset > m_size || length > m_size - offset) return false;
+#if SNAPSHOT_MMAP
+        (void)scratch;
+        out = m_map + offset;
+        return true;
+#else
+        scratch.resize(static_cast<size_t>(length));
+        out = scratch.data();
+        return read(offset, scratch.data(), length);
+#endif
+    }
+
+    bool read(uint64_t offset, void* dst, uint64_t length)
+    {
+        if (offset > m_size || length > m_size - offset) return false;
+        if (length == 0) return true;
+#if SNAPSHOT_MMAP
+        memcpy(dst, m_map + offset, static_cast<size_t>(length));
+        return true;
+#else
+        if (fseek(m_file, static_cast<long>(offset), SEEK_SET) != 0) return false;
+        return fread(dst, 1, static_cast<size_t>(length), m_file) == length;
+#endif
+    }
+
+private:
+#if SNAPSHOT_MMAP
+    const uint8_t* m_map = nullptr;
+    size_t m_size = 0;
+#else
+    FILE* m_file = nullptr;
+    uint64_t m_size = 0;
+#endif
+};
+
+/**
+ * @brief Loads each visited column from its section
+ */
+struct SectionLoader {
+    SnapshotFile& file;
+    const std::vector<SnapshotSection>& table;
+    size_t reptiles;
+    size_t terrariums;
+    bool ok;
+    std::vector<uint8_t> scratch;   // Compressed bytes without mmap
+    std::vector<uint8_t> planes;    // Decoding buffer, reused by every section
+
+    const SnapshotSection* find(uint32_t id) const
+    {
+        for (const SnapshotSection& s : table) {
+            if (s.id == id) return &s;
+        }
+        return nullptr;
+    }
+
+    size_t countFor(uint32_t id) const
+    {
+        return (id < SNAP_TERRARIUM_ID) ? reptiles : terrariums;
+    }
+
+    // Decoded size of a section, 0 if it is missing or implausible
+    uint64_t rawLength(const SnapshotSection* s) const
+    {
+        if (!s || s->raw_length > file.size() * MAX_EXPANSION) return 0;
+        return s->raw_length;
+    }
+
+    // Read a section's decoded bytes into dst (exactly `length` bytes) and
+    // check it; the CRC covers the stored bytes
+    bool load(uint32_t id, void* dst, uint64_t length)
+    {
+        const SnapshotSection* s = find(id);
+        if (!s || s->raw_length != length) return false;
+        if (s->encoding == BLOCK_RAW) {
+            if (s->length != length) return false;
+            if (!file.read(s->offset, dst, length)) return false;
+            return crc32(dst, static_cast<size_t>(length)) == s->crc;
+        }
+
+        const uint8_t* stored;
+        if (!file.view(s->offset, s->length, scratch, stored)) return false;
+        if (crc32(stored, static_cast<size_t>(s->length)) != s->crc) return false;
+        return decodeBlock(stored, static_cast<size_t>(s->length), s->encoding, dst, static_cast<size_t>(length),
+                           planes);
+    }
+
+    template <typename T>
+    void operator()(uint32_t id, std::vector<T>& column)
+    {
+        if (!ok) return;
+        const size_t n = countFor(id);
+        column.resize(n);
+        ok = load(id, column.data(), n * sizeof(T));
+    }
+
+    void operator()(uint32_t id, std::vector<std::string>& column)
+    {
+        if (!ok) return;
+        const size_t n = countFor(id);
+        const uint64_t length = rawLength(find(id));
+        const uint64_t table_bytes = (n + 1) * sizeof(uint32_t);
+        if (length < table_bytes) {
+            ok = false;
+            return;
+        }
+
+        std::vector<uint8_t> bytes(static_cast<size_t>(length));
+        if (!load(id, bytes.data(), length)) {
+            ok = false;
+            return;
+        }
+
+        std::vector<uint32_t> ends(n + 1);
+        memcpy(ends.data(), bytes.data(), static_cast<size_t>(table_bytes));
+        const char* chars = reinterpret_cast<const char*>(bytes.data() + table_bytes);
+        const uint64_t char_bytes = length - table_bytes;
+
+        column.clear();
+        column.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            if (ends[i] > ends[i + 1] || ends[i + 1] > char_bytes) {
+                ok = false;
+                return;
+            }
+            column.emplace_back(chars + ends[i], ends[i + 1] - ends[i]);
+        }
+    }
+};
+
+// Map every id of a store, then restore its freed slots if the file has
+// them (older files do not: their freed slots restart at generation 0);
+// false on a duplicate or invalid id
+bool mapIds(SectionLoader& loader, uint32_t free_section, SlotMap& index, const std::vector<uint32_t>& ids)
+{
+    index.clear();
+    for (size_t i = 0; i < ids.size(); i++) {
+        if (!index.insert(ids[i], static_cast<uint32_t>(i))) return false;
+    }
+
+    const SnapshotSection* s = loader.find(free_section);
+    if (!s) return true;
+    const uint64_t length = loader.rawLength(s);
+    if (length % sizeof(uint32_t) != 0) return false;
+    std::vector<uint32_t> free_ids(static_cast<size_t>(length / sizeof(uint32_t)));
+    return loader.load(free_section, free_ids.data(), length) && index.restoreFree(free_ids);
+}
+
+std::vector<uint8_t> freeIdBytes(const SlotMap& index)
+{
+    std::vector<uint32_t> ids;
+    index.freeIds(ids);
+    std::vector<uint8_t> bytes(ids.size() * sizeof(uint32_t));
+    if (!ids.empty()) memcpy(bytes.data(), ids.data(), bytes.size());
+    return bytes;
+}
+
+} // namespace
+
+bool isSnapshotFile(const char* path)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    const bool match = fread(magic, 1, sizeof(magic), f) == sizeof(magic) &&
+                       memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0;
+    fclose(f);
+    return match;
+}
+
+void copySnapshotState(const GameState& from, GameState& to)
+{
+    to.setGameClock(from.game_clock_ms);
+    to.external_temperature = from.external_temperature;
+    to.external_humidity = from.external_humidity;
+    to.heatwave_active = from.heatwave_active;
+    to.economy = from.economy;
+    to.reptiles.index = from.reptiles.index;
+    to.terrariums.index = from.terrariums.index;
+
+    // Pair each column of `from` with the same section of `to`
+    visitColumns(from.reptiles, from.terrariums, [&](uint32_t id, const auto& src) {
+        visitColumns(to.reptiles, to.terrariums, [&](uint32_t to_id, auto& dst) {
+            if constexpr (std::is_same<std::decay_t<decltype(src)>, std::decay_t<decltype(dst)>>::value) {
+                if (to_id == id) dst = src;
+            }
+        });
+    });
+}
+
+bool writeSnapshot(const GameState& state, const char* path, const std::vector<uint8_t>& engine, bool compress)
+{
+    SectionCollector sections;
+
+    GameSection game = {};
+    game.game_clock_ms = state.game_clock_ms;
+    game.external_temperature = state.external_temperature;
+    game.external_humidity = state.external_humidity;
+    game.heatwave_active = state.heatwave_active ? 1 : 0;
+    game.economy = state.economy;
+    std::vector<uint8_t> game_bytes(sizeof(game));
+    memcpy(game_bytes.data(), &game, sizeof(game));
+    sections.addOwned(SNAP_GAME, std::move(game_bytes));
+    if (!engine.empty()) {
+        sections.add(SNAP_ENGINE, engine.data(), engine.size());
+    }
+    sections.addOwned(SNAP_REPTILE_FREE_IDS, freeIdBytes(state.reptiles.index));
+    sections.addOwned(SNAP_TERRARIUM_FREE_IDS, freeIdBytes(state.terrariums.index));
+
+    visitColumns(state.reptiles, state.terrariums, sections);
+    encodeSections(sections.sections, compress);
+
+    // Lay out: header, table, then each section on a 64-byte boundary
+    std::vector<SnapshotSection> table;
+    uint64_t offset = alignUp(sizeof(SnapshotHeader) + sections.sections.size() * sizeof(SnapshotSection));
+    for (PendingSection& p : sections.sections) {
+        p.entry.offset = offset;
+        offset = alignUp(offset + p.entry.length);
+        table.push_back(p.entry);
+    }
+
+    SnapshotHeader header = {};
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.section_size = sizeof(SnapshotSection);
+    header.section_count = static_cast<uint32_t>(table.size());
+    header.reptile_count = static_cast<uint32_t>(state.reptiles.size());
+    header.terrarium_count = static_cast<uint32_t>(state.terrariums.size());
+    header.table_crc = crc32(table.data(), table.size() * sizeof(SnapshotSection));
+    header.header_crc = crc32(&header, offsetof(SnapshotHeader, header_crc));
+
+    // Write next to the target and rename, so a failed save never
+    // destroys the previous one
+    const std::string tmp = std::string(path) + ".tmp";
+    FILE* f = fopen(tmp.c_str(), "wb");
+    if (!f) return false;
+
+    uint64_t pos = sizeof(header) + table.size() * sizeof(SnapshotSection);
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1 &&
+              fwrite(table.data(), sizeof(SnapshotSection), table.size(), f) == table.size();
+    for (const PendingSection& p : sections.sections) {
+        if (!ok) break;
+        ok = writePadding(f, pos, p.entry.offset) &&
+             (p.entry.length == 0 || fwrite(p.data, 1, p.entry.length, f) == p.entry.length);
+        pos += p.entry.length;
+    }
+    ok = (fclose(f) == 0) && ok;
+
+    if (ok) {
+#ifdef ESP_PLATFORM
+        // SPIFFS rename does not replace an existing file. Power lost
+        // before the rename leaves only the .tmp, which loading falls back to
+        remove(path);
+#endif
+        ok = rename(tmp.c_str(), path) == 0;
+    }
+    if (!ok) remove(tmp.c_str());
+    return ok;
+}
+
+bool readSnapshot(const char* path, GameState& out, std::vector<uint8_t>* engine)
+{
+    SnapshotFile file;
+    if (!file.open(path)) return false;
+
+    SnapshotHeader header;
+    if (!file.read(0, &header, sizeof(header))) return false;
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) return false;
+    if (header.header_crc != crc32(&header, offsetof(SnapshotHeader, header_crc))) return false;
+    if (header.version == 0 || header.version > SNAPSHOT_VERSION) return false;
+    if (header.section_size != sizeof(SnapshotSection) || header.section_count > MAX_SECTIONS) return false;
+
+    std::vector<SnapshotSection> table(header.section_count);
+    if (!file.read(sizeof(header), table.data(), table.size() * sizeof(SnapshotSection))) return false;
+    if (header.table_crc != crc32(table.data(), table.size() * sizeof(SnapshotSection))) return false;
+
+    SectionLoader loader = {file, table, header.reptile_count, header.terrarium_count, true, {}, {}};
+
+    GameSection game;
+    if (!loader.load(SNAP_GAME, &game, sizeof(game))) return false;
+    out.setGameClock(game.game_clock_ms);
+    out.external_temperature = game.external_temperature;
+    out.external_humidity = game.external_humidity;
+    out.heatwave_active = (game.heatwave_active != 0);
+    out.economy = game.economy;
+
+    if (engine) {
+        // Optional: older files and plain writers have none
+        engine->clear();
+        const SnapshotSection* s = loader.find(SNAP_ENGINE);
+        if (s) {
+            const uint64_t length = loader.rawLength(s);
+            engine->resize(static_cast<size_t>(length));
+            if (!loader.load(SNAP_ENGINE, engine->data(), length)) return false;
+        }
+    }
+
+    visitColumns(out.reptiles, out.terrariums, loader);
+    if (!loader.ok) return false;
+
+    if (!mapIds(loader, SNAP_REPTILE_FREE_IDS, out.reptiles.index, out.reptiles.id)) return false;
+    if (!mapIds(loader, SNAP_TERRARIUM_FREE_IDS, out.terrariums.index, out.terrariums.id)) return false;
+    out.reptiles.terrarium_index.assign(out.reptiles.size(), SlotMap::INVALID);
+    for (uint8_t& f : out.reptiles.flags) {
+        f = static_cast<uint8_t>(f & ~REPTILE_FLAG_ASLEEP);
+    }
+    return true;
+}
+
+} // namespace ReptileSim
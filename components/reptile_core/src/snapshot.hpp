@@ -0,0 +1,135 @@
+/**
+ * @file snapshot.hpp
+ * @brief Versioned binary save file (column snapshot)
+ *
+ * Layout, all little-endian:
+ *
+ *   SnapshotHeader                 magic, version, counts, CRCs
+ *   SnapshotSection[count]         one entry per section
+ *   sections, each 64-byte aligned
+ *
+ * There is one section for the global state (SNAP_GAME), an optional one
+ * the engine fills with its own state (SNAP_ENGINE), one per store with
+ * the ids its freed slots will issue next (so removed ids are not handed
+ * out again after a load), and one per store column, stored as a raw array of n fixed-width values. Saving writes each
+ * column with a single fwrite. Loading copies each column into its vector
+ * in one step: memcpy out of an mmap on Linux, one large fread on device.
+ * Strings (names, species) are stored as n + 1 uint32 end offsets followed
+ * by the characters.
+ *
+ * A section may be compressed (see compression.hpp): its encoding word is
+ * then nonzero, `length` is the stored size and `raw_length` the decoded
+ * one. Compressed columns are decoded into their vectors instead of
+ * copied; everything else about the layout is unchanged, so raw and
+ * compressed sections can be mixed in one file.
+ *
+ * Every section has its own length and CRC-32 (of the stored bytes). The
+ * section table and the header have their own CRC-32 as well. Readers skip section ids they do not
+ * know, so later versions can add columns without breaking older builds.
+ * A version bump is only needed when an existing section changes meaning.
+ */
+
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include "../include/game_state.hpp"
+
+namespace ReptileSim {
+
+constexpr char SNAPSHOT_MAGIC[8] = {'R', 'S', 'I', 'M', 'S', 'N', 'A', 'P'};
+constexpr uint16_t SNAPSHOT_VERSION = 1;
+constexpr uint32_t SNAPSHOT_ALIGN = 64;
+
+// Section ids (on-disk values, never renumber)
+enum SnapshotSectionId : uint32_t {
+    SNAP_GAME                   = 0x0001,   // Clock, weather, economy
+    SNAP_ENGINE                 = 0x0002,   // Engine-private (scheduler, journal), opaque here
+    SNAP_REPTILE_FREE_IDS       = 0x0003,   // SlotMap::freeIds() of the reptile index
+    SNAP_TERRARIUM_FREE_IDS     = 0x0004,   // SlotMap::freeIds() of the terrarium index
+
+    SNAP_REPTILE_ID             = 0x0100,
+    SNAP_REPTILE_WEIGHT         = 0x0101,
+    SNAP_REPTILE_BONE_DENSITY   = 0x0102,
+    SNAP_REPTILE_HYDRATION      = 0x0103,
+    SNAP_REPTILE_STRESS         = 0x0104,
+    SNAP_REPTILE_STOMACH        = 0x0105,
+    SNAP_REPTILE_IMMUNE         = 0x0106,
+    SNAP_REPTILE_TERRARIUM      = 0x0107,   // assigned_terrarium_id
+    SNAP_REPTILE_FLAGS          = 0x0108,
+    SNAP_REPTILE_NAME           = 0x0109,
+    SNAP_REPTILE_SPECIES        = 0x010A,
+
+    SNAP_TERRARIUM_ID           = 0x0200,
+    SNAP_TERRARIUM_TEMP_HOT     = 0x0201,
+    SNAP_TERRARIUM_TEMP_COLD    = 0x0202,
+    SNAP_TERRARIUM_HUMIDITY     = 0x0203,
+    SNAP_TERRARIUM_UV           = 0x0204,
+    SNAP_TERRARIUM_WASTE        = 0x0205,
+    SNAP_TERRARIUM_BACTERIA     = 0x0206,
+    SNAP_TERRARIUM_VOLUME       = 0x0207,
+    SNAP_TERRARIUM_EQUIPMENT    = 0x0208,
+    SNAP_TERRARIUM_WIDTH        = 0x0209,
+    SNAP_TERRARIUM_HEIGHT       = 0x020A,
+    SNAP_TERRARIUM_DEPTH        = 0x020B,
+};
+
+struct SnapshotHeader {
+    char magic[8];              // SNAPSHOT_MAGIC
+    uint16_t version;           // SNAPSHOT_VERSION
+    uint16_t section_size;      // sizeof(SnapshotSection)
+    uint32_t section_count;
+    uint32_t reptile_count;
+    uint32_t terrarium_count;
+    uint32_t table_crc;         // CRC-32 of the section table
+    uint32_t header_crc;        // CRC-32 of the bytes above
+};
+static_assert(sizeof(SnapshotHeader) == 32, "on-disk layout");
+
+struct SnapshotSection {
+    uint32_t id;                // SnapshotSectionId
+    uint32_t encoding;          // 0 = raw, else a compression.hpp encoding
+    uint64_t offset;            // From the start of the file
+    uint64_t length;            // Stored bytes
+    uint64_t raw_length;        // Bytes after decoding (= length when raw)
+    uint32_t crc;               // CRC-32 of the stored bytes
+    uint32_t reserved;
+};
+static_assert(sizeof(SnapshotSection) == 40, "on-disk layout");
+
+/**
+ * @brief Whether the file starts with SNAPSHOT_MAGIC
+ */
+bool isSnapshotFile(const char* path);
+
+/**
+ * @brief Write the state to path (via path.tmp, renamed when complete)
+ *
+ * A non-empty `engine` is stored as the SNAP_ENGINE section. With
+ * `compress`, sections that shrink are stored delta/shuffle + LZ encoded
+ * (on host, several sections at a time); the rest stay raw.
+ */
+bool writeSnapshot(const GameState& state, const char* path, const std::vector<uint8_t>& engine = {},
+                   bool compress = false);
+
+/**
+ * @brief Copy what writeSnapshot() stores (columns, id maps, clock, weather, economy)
+ *
+ * Column vectors keep their capacity, so refreshing a long-lived copy
+ * allocates nothing once it has grown to the herd size.
+ */
+void copySnapshotState(const GameState& from, GameState& to);
+
+/**
+ * @brief Read a snapshot into a default-constructed state
+ *
+ * Fills the stores (ids mapped, freed slots restored, ASLEEP cleared),
+ * clock, weather and economy. terrarium_index and the occupancy index are left for the
+ * caller to rebuild. On failure `out` is partially filled and must be
+ * discarded. `engine` (if given) receives the SNAP_ENGINE section, empty
+ * when the file has none.
+ */
+bool readSnapshot(const char* path, GameState& out, std::vector<uint8_t>* engine = nullptr);
+
+} // namespace ReptileSim
+
+#endif // SNAPSHOT_HPP
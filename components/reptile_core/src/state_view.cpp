@@ -0,0 +1,167 @@
+/**
+ * @file state_view.cpp
+ * @brief Per-tick read-only view of the state for other tasks (seqlock)
+ */
+
+#include "../include/state_view.hpp"
+#include "../include/slot_map.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace ReptileSim {
+
+// Smallest view array; saves a few regrowths while the first herd is added
+static constexpr uint32_t MIN_VIEW_SLOTS = 64;
+
+// Slots a view array must cover: one past the highest live id slot
+static uint32_t slotsFor(const std::vector<uint32_t>& ids)
+{
+    uint32_t slots = 0;
+    for (const uint32_t id : ids) {
+        slots = std::max(slots, SlotMap::slotOf(id) + 1);
+    }
+    return slots;
+}
+
+// ====================================================================================
+// WRITER
+// ====================================================================================
+
+void StateViews::publish(const GameState& state, const ChangeTracker& changes)
+{
+    // Latch: readers use copy (seq & 1), always the one not being written.
+    // The data stores are plain, so the fences order them against the counter.
+    const uint32_t seq = m_seq.load(std::memory_order_relaxed);
+    const uint64_t version = seq / 2 + 1;
+
+    m_seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    fill(m_copies[0], state, changes, version);
+
+    m_seq.store(seq + 2, std::memory_order_release);
+    fill(m_copies[1], state, changes, version);
+}
+
+template <typename View>
+StateViews::Block<View>* StateViews::blockFor(std::atomic<const Block<View>*>& current, uint32_t& filled,
+                                              uint32_t slots, std::vector<std::unique_ptr<Block<View>>>& blocks)
+{
+    Block<View>* block = const_cast<Block<View>*>(current.load(std::memory_order_relaxed));
+    if (block && slots <= block->capacity) {
+        // Clear what the last publish filled; the rest of the array is still zero
+        memset(block->views.get(), 0, sizeof(View) * filled);
+        filled = slots;
+        return block;
+    }
+
+    // Readers may be copying from the old array: switch, never free it
+    const uint32_t capacity = std::max({slots, MIN_VIEW_SLOTS, block ? block->capacity * 2 : 0u});
+    std::unique_ptr<Block<View>> grown(new Block<View>{capacity, std::unique_ptr<View[]>(new View[capacity]())});
+    block = grown.get();
+    blocks.push_back(std::move(grown));
+    current.store(block, std::memory_order_release);
+    filled = slots;
+    return block;
+}
+
+void StateViews::fill(Copy& copy, const GameState& state, const ChangeTracker& changes, uint64_t version)
+{
+    const ReptileStore& reptiles = state.reptiles;
+    const TerrariumStore& terrariums = state.terrariums;
+
+    WorldView& world = copy.world;
+    world.version = version;
+    world.change_version = changes.version();
+    world.game_clock_ms = state.game_clock_ms;
+    world.game_day = state.game_day;
+    world.game_time_hours = state.game_time_hours;
+    world.external_temperature = state.external_temperature;
+    world.external_humidity = state.external_humidity;
+    world.reptile_count = static_cast<uint32_t>(reptiles.size());
+    world.terrarium_count = static_cast<uint32_t>(terrariums.size());
+    world.economy = state.economy;
+    world.heatwave_active = state.heatwave_active;
+
+    Block<TerrariumView>* t_block =
+        blockFor(copy.terrariums, copy.terrarium_slots, slotsFor(terrariums.id), m_terrarium_blocks);
+    for (size_t t = 0; t < terrariums.size(); t++) {
+        TerrariumView& v = t_block->views[SlotMap::slotOf(terrariums.id[t])];
+        v.id = terrariums.id[t];
+        v.version = changes.terrariumVersion(v.id);
+        v.temp_hot_zone = terrariums.temp_hot_zone[t];
+        v.temp_cold_zone = terrariums.temp_cold_zone[t];
+        v.humidity = terrariums.humidity[t];
+        v.uv_index = terrariums.uv_index[t];
+        v.waste_level = terrariums.waste_level[t];
+        v.bacteria_count = terrariums.bacteria_count[t];
+        v.occupants = state.occupancy.count(static_cast<uint32_t>(t));
+        v.equipment = terrariums.equipment[t];
+    }
+
+    Block<ReptileView>* r_block = blockFor(copy.reptiles, copy.reptile_slots, slotsFor(reptiles.id), m_reptile_blocks);
+    for (size_t i = 0; i < reptiles.size(); i++) {
+        ReptileView& v = r_block->views[SlotMap::slotOf(reptiles.id[i])];
+        v.id = reptiles.id[i];
+        v.version = changes.reptileVersion(v.id);
+        v.assigned_terrarium_id = reptiles.assigned_terrarium_id[i];
+        v.weight_grams = reptiles.weight_grams[i];
+        v.bone_density = reptiles.bone_density[i];
+        v.hydration = reptiles.hydration[i];
+        v.stress_level = reptiles.stress_level[i];
+        v.stomach_content = reptiles.stomach_content[i];
+        v.immune_system = reptiles.immune_system[i];
+        v.flags = reptiles.flags[i];
+    }
+}
+
+// ====================================================================================
+// READERS
+// ====================================================================================
+
+template <typename View>
+bool StateViews::read(uint32_t id, View& out, std::atomic<const Block<View>*> Copy::*member) const
+{
+    markWanted();
+    const uint32_t slot = SlotMap::slotOf(id);
+    for (;;) {
+        const uint32_t seq = m_seq.load(std::memory_order_acquire);
+        const Block<View>* block = (m_copies[seq & 1].*member).load(std::memory_order_acquire);
+
+        // A block's capacity never changes, so the index is safe even if
+        // this copy is rewritten meanwhile; the retry discards what was read
+        const bool present = block && slot < block->capacity;
+        if (present) {
+            memcpy(&out, &block->views[slot], sizeof(out));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_seq.load(std::memory_order_relaxed) == seq) {
+            return present && id != 0 && out.id == id;
+        }
+    }
+}
+
+bool StateViews::terrarium(uint32_t id, TerrariumView& out) const
+{
+    return read(id, out, &Copy::terrariums);
+}
+
+bool StateViews::reptile(uint32_t id, ReptileView& out) const
+{
+    return read(id, out, &Copy::reptiles);
+}
+
+WorldView StateViews::world() const
+{
+    markWanted();
+    WorldView out;
+    for (;;) {
+        const uint32_t seq = m_seq.load(std::memory_order_acquire);
+        memcpy(&out, &m_copies[seq & 1].world, sizeof(out));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_seq.load(std::memory_order_relaxed) == seq) {
+            return out;
+        }
+    }
+}
+
+} // namespace ReptileSim
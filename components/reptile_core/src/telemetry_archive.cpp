@@ -0,0 +1,527 @@
+/**
+ * @file telemetry_archive.cpp
+ * @brief Append-only columnar telemetry archive with a sparse time index
+ */
+
+#include "../include/telemetry_archive.hpp"
+#include "compression.hpp"
+#include "crc32.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ReptileSim {
+
+namespace {
+
+// On-disk layout (little-endian, never reorder)
+//
+// <metric>.idx  IndexHeader, then one IndexEntry per chunk in time order
+// <metric>.dat  chunks, each starting on a TELEMETRY_BLOCK_BYTES boundary:
+//               ChunkHeader, ChunkColumn[entities] sorted by id, the
+//               timestamp stream, one value stream per entity, padding
+constexpr char INDEX_MAGIC[4] = {'R', 'T', 'S', 'I'};
+constexpr char CHUNK_MAGIC[4] = {'R', 'T', 'S', 'C'};
+constexpr uint32_t ARCHIVE_VERSION = 1;
+
+struct IndexHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t channel;           // HistoryChannel
+    uint32_t entry_size;
+    uint32_t reserved[4];
+};
+
+struct IndexEntry {
+    uint64_t first_ms;
+    uint64_t last_ms;
+    uint64_t offset;            // Of the chunk in the data file
+    uint32_t length;            // Without padding
+    uint32_t crc;               // Of the fields above
+};
+
+struct ChunkHeader {
+    char magic[4];
+    uint32_t channel;
+    uint32_t entities;
+    uint32_t samples;
+    uint32_t time_bytes;        // Timestamp stream, right after the columns
+    uint32_t time_crc;
+    uint64_t first_ms;
+};
+
+struct ChunkColumn {
+    uint32_t id;
+    uint32_t offset;            // From the chunk start
+    uint32_t length;
+    uint32_t crc;
+};
+
+static_assert(sizeof(IndexHeader) == 32 && sizeof(IndexEntry) == 32, "on-disk layout");
+static_assert(sizeof(ChunkHeader) == 32 && sizeof(ChunkColumn) == 16, "on-disk layout");
+
+// 8.3 file names, one pair per HistoryChannel
+const char* const METRIC_NAMES[] = {"ttemp", "thumid", "twaste", "tbact", "rstress", "rweight"};
+static_assert(sizeof(METRIC_NAMES) / sizeof(METRIC_NAMES[0]) == static_cast<size_t>(HistoryChannel::Count),
+              "one file name per channel");
+
+uint32_t entryCrc(const IndexEntry& e)
+{
+    return crc32(&e, offsetof(IndexEntry, crc));
+}
+
+long fileSize(FILE* f)
+{
+    if (fseek(f, 0, SEEK_END) != 0) return -1;
+    return ftell(f);
+}
+
+bool readAt(FILE* f, uint64_t offset, void* out, size_t length)
+{
+    return fseek(f, static_cast<long>(offset), SEEK_SET) == 0 && fread(out, 1, length, f) == length;
+}
+
+bool readEntry(FILE* f, size_t k, IndexEntry& e)
+{
+    return readAt(f, sizeof(IndexHeader) + k * sizeof(IndexEntry), &e, sizeof(e)) && e.crc == entryCrc(e);
+}
+
+// Append, flush to the device and close
+bool appendDurable(const std::string& path, const void* data, size_t length)
+{
+    FILE* f = fopen(path.c_str(), "ab");
+    if (!f) return false;
+    bool ok = fwrite(data, 1, length, f) == length;
+    ok = ok && fflush(f) == 0 && fsync(fileno(f)) == 0;
+    return (fclose(f) == 0) && ok;
+}
+
+} // namespace
+
+TelemetryConfig TelemetryArchive::defaultConfig()
+{
+    TelemetryConfig config;
+    config.terrarium_slots = 64;
+    config.reptile_slots = 256;
+    config.period_s = 60;
+    config.chunk_samples = 240;
+    return config;
+}
+
+std::string TelemetryArchive::path(HistoryChannel channel, const char* extension) const
+{
+    return m_dir + "/" + METRIC_NAMES[static_cast<size_t>(channel)] + extension;
+}
+
+// ====================================================================================
+// OPEN / CLOSE
+// ====================================================================================
+
+bool TelemetryArchive::open(const char* dir, const TelemetryConfig& config)
+{
+    close();
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    if (!dir || config.terrarium_slots == 0 || config.reptile_slots == 0 || config.period_s == 0 ||
+        config.chunk_samples == 0) {
+        return false;
+    }
+    if (mkdir(dir, 0775) != 0 && errno != EEXIST) return false;
+
+    m_dir = dir;
+    m_config = config;
+    m_any = false;
+    m_last_ms = 0;
+    m_samples = 0;
+    m_failed = false;
+    m_stats = {};
+    for (size_t c = 0; c < static_cast<size_t>(HistoryChannel::Count); c++) {
+        if (!recover(static_cast<HistoryChannel>(c))) {
+            m_dir.clear();
+            return false;
+        }
+    }
+    m_period = m_last_ms / (static_cast<uint64_t>(config.period_s) * GAME_MS_PER_SECOND);
+
+    for (Chunk* chunk : {&m_active, &m_sealed}) {
+        chunk->terrariums = {static_cast<uint32_t>(HISTORY_TERRARIUM_CHANNELS), config.terrarium_slots, {}, {}};
+        chunk->reptiles = {static_cast<uint32_t>(HISTORY_REPTILE_CHANNELS), config.reptile_slots, {}, {}};
+        for (Buffer* buffer : {&chunk->terrariums, &chunk->reptiles}) {
+            buffer->values.resize(static_cast<size_t>(buffer->channels) * buffer->slots * config.chunk_samples);
+            buffer->owner.resize(buffer->slots);
+        }
+        chunk->times.reserve(config.chunk_samples);
+        resetChunk(*chunk);
+    }
+    return true;
+}
+
+bool TelemetryArchive::close()
+{
+    if (!isOpen()) return false;
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    bool ok = writeChunk(m_sealed);
+    ok = writeChunk(m_active) && ok && !m_failed;
+    m_dir.clear();
+    m_active = {};
+    m_sealed = {};
+    return ok;
+}
+
+bool TelemetryArchive::recover(HistoryChannel channel)
+{
+    const std::string index_path = path(channel, ".idx");
+    long data_bytes = 0;
+    if (FILE* data = fopen(path(channel, ".dat").c_str(), "rb")) {
+        data_bytes = fileSize(data);
+        fclose(data);
+    }
+
+    FILE* f = fopen(index_path.c_str(), "rb");
+    if (!f) {
+        IndexHeader header = {};
+        memcpy(header.magic, INDEX_MAGIC, sizeof(header.magic));
+        header.version = ARCHIVE_VERSION;
+        header.channel = static_cast<uint32_t>(channel);
+        header.entry_size = sizeof(IndexEntry);
+        return appendDurable(index_path, &header, sizeof(header));
+    }
+
+    IndexHeader header;
+    const long size = fileSize(f);
+    if (size < static_cast<long>(sizeof(header)) || !readAt(f, 0, &header, sizeof(header)) ||
+        memcmp(header.magic, INDEX_MAGIC, sizeof(header.magic)) != 0 || header.version != ARCHIVE_VERSION ||
+        header.entry_size != sizeof(IndexEntry)) {
+        fclose(f);
+        return false;   // Not ours: leave it alone
+    }
+
+    // Entries are appended after their chunk, so only the tail can be torn
+    const size_t entries = static_cast<size_t>(size - sizeof(header)) / sizeof(IndexEntry);
+    size_t valid = entries;
+    IndexEntry e;
+    while (valid > 0) {
+        if (readEntry(f, valid - 1, e) && e.offset + e.length <= static_cast<uint64_t>(data_bytes)) break;
+        valid--;
+    }
+    if (valid > 0) {
+        m_last_ms = m_any ? std::max(m_last_ms, e.last_ms) : e.last_ms;
+        m_any = true;
+    }
+
+    bool ok = true;
+    const long valid_bytes = static_cast<long>(sizeof(header) + valid * sizeof(IndexEntry));
+    if (valid_bytes != size) {
+        // Rewrite without the torn tail (rare: after a crash mid-append)
+        std::vector<uint8_t> keep(static_cast<size_t>(valid_bytes));
+        ok = readAt(f, 0, keep.data(), keep.size());
+        fclose(f);
+        const std::string tmp = index_path + ".tmp";
+        remove(tmp.c_str());
+        ok = ok && appendDurable(tmp, keep.data(), keep.size());
+        if (ok) {
+            remove(index_path.c_str());     // FAT rename does not replace
+            ok = rename(tmp.c_str(), index_path.c_str()) == 0;
+        }
+        return ok;
+    }
+    fclose(f);
+    return ok;
+}
+
+// ====================================================================================
+// RECORDING
+// ====================================================================================
+
+void TelemetryArchive::resetChunk(Chunk& chunk)
+{
+    for (Buffer* buffer : {&chunk.terrariums, &chunk.reptiles}) {
+        std::fill(buffer->values.begin(), buffer->values.end(), std::numeric_limits<float>::quiet_NaN());
+        std::fill(buffer->owner.begin(), buffer->owner.end(), 0u);
+    }
+    chunk.times.clear();
+}
+
+void TelemetryArchive::seal()
+{
+    if (m_active.times.empty()) return;
+
+    // The writer is normally a whole chunk ahead, so the lock is free
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    writeChunk(m_sealed);
+    std::swap(m_active, m_sealed);
+}
+
+void TelemetryArchive::record(const GameState& state)
+{
+    if (!isOpen()) return;
+
+    const uint64_t now = state.game_clock_ms;
+    const uint64_t period = now / (static_cast<uint64_t>(m_config.period_s) * GAME_MS_PER_SECOND);
+    if (m_any && (now <= m_last_ms || period == m_period)) return;
+
+    const TerrariumStore& terra = state.terrariums;
+    const ReptileStore& reptiles = state.reptiles;
+    const float* const terrarium_columns[HISTORY_TERRARIUM_CHANNELS] = {
+        terra.temp_hot_zone.data(), terra.humidity.data(), terra.waste_level.data(), terra.bacteria_count.data()};
+    const float* const reptile_columns[HISTORY_REPTILE_CHANNELS] = {
+        reptiles.stress_level.data(), reptiles.weight_grams.data()};
+    struct Source {
+        Buffer* buffer;
+        const std::vector<uint32_t>* ids;
+        const float* const* columns;
+    };
+    const Source sources[] = {{&m_active.terrariums, &terra.id, terrarium_columns},
+                              {&m_active.reptiles, &reptiles.id, reptile_columns}};
+
+    // A slot reused within the chunk would mix two entities in one column
+    bool reused = false;
+    for (const Source& src : sources) {
+        for (const uint32_t id : *src.ids) {
+            const uint32_t slot = SlotMap::slotOf(id);
+            if (slot < src.buffer->slots && src.buffer->owner[slot] != 0 && src.buffer->owner[slot] != id) {
+                reused = true;
+            }
+        }
+    }
+    if (reused) seal();
+
+    const size_t k = m_active.times.size();
+    const size_t samples = m_config.chunk_samples;
+    m_active.times.push_back(now);
+    for (const Source& src : sources) {
+        Buffer& buffer = *src.buffer;
+        const std::vector<uint32_t>& ids = *src.ids;
+        for (size_t i = 0; i < ids.size(); i++) {
+            const uint32_t slot = SlotMap::slotOf(ids[i]);
+            if (slot >= buffer.slots) continue;
+            buffer.owner[slot] = ids[i];
+            for (uint32_t c = 0; c < buffer.channels; c++) {
+                buffer.values[(static_cast<size_t>(c) * buffer.slots + slot) * samples + k] = src.columns[c][i];
+            }
+        }
+    }
+
+    m_last_ms = now;
+    m_period = period;
+    m_any = true;
+    m_samples++;
+    if (m_active.times.size() == samples) seal();
+}
+
+bool TelemetryArchive::writeSealed()
+{
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    return isOpen() && writeChunk(m_sealed);
+}
+
+bool TelemetryArchive::flush()
+{
+    if (!isOpen()) return false;
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    bool ok = writeChunk(m_sealed);
+    ok = writeChunk(m_active) && ok;
+    return ok && !m_failed;
+}
+
+TelemetryStats TelemetryArchive::stats() const
+{
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    TelemetryStats stats = m_stats;
+    stats.samples = m_samples;
+    return stats;
+}
+
+bool TelemetryArchive::writeChunk(Chunk& chunk)
+{
+    if (chunk.times.empty()) return true;
+
+    std::vector<uint8_t> bytes;
+    bool ok = true;
+    for (size_t c = 0; c < static_cast<size_t>(HistoryChannel::Count); c++) {
+        const bool is_terrarium = c < HISTORY_TERRARIUM_CHANNELS;
+        ok = writeMetric(static_cast<HistoryChannel>(c), chunk, is_terrarium ? c : c - HISTORY_TERRARIUM_CHANNELS,
+                         bytes) && ok;
+    }
+    if (!ok) m_failed = true;
+    resetChunk(chunk);
+    return ok;
+}
+
+bool TelemetryArchive::writeMetric(HistoryChannel channel, const Chunk& chunk, size_t channel_index,
+                                   std::vector<uint8_t>& bytes)
+{
+    const bool is_terrarium = static_cast<size_t>(channel) < HISTORY_TERRARIUM_CHANNELS;
+    const Buffer& buffer = is_terrarium ? chunk.terrariums : chunk.reptiles;
+    const std::vector<uint64_t>& times = chunk.times;
+    const size_t samples = times.size();
+    std::vector<ChunkColumn> columns;
+    for (uint32_t slot = 0; slot < buffer.slots; slot++) {
+        if (buffer.owner[slot] != 0) columns.push_back({buffer.owner[slot], slot, 0, 0});
+    }
+    if (columns.empty()) return true;
+    std::sort(columns.begin(), columns.end(), [](const ChunkColumn& a, const ChunkColumn& b) { return a.id < b.id; });
+
+    const size_t head = sizeof(ChunkHeader) + columns.size() * sizeof(ChunkColumn);
+    bytes.assign(head, 0);
+    encodeTimestamps(times.data(), samples, bytes);
+
+    ChunkHeader header = {};
+    memcpy(header.magic, CHUNK_MAGIC, sizeof(header.magic));
+    header.channel = static_cast<uint32_t>(channel);
+    header.entities = static_cast<uint32_t>(columns.size());
+    header.samples = static_cast<uint32_t>(samples);
+    header.time_bytes = static_cast<uint32_t>(bytes.size() - head);
+    header.time_crc = crc32(bytes.data() + head, header.time_bytes);
+    header.first_ms = times.front();
+
+    const size_t stride = m_config.chunk_samples;
+    for (ChunkColumn& col : columns) {
+        const uint32_t slot = col.offset;
+        col.offset = static_cast<uint32_t>(bytes.size());
+        encodeXorFloats(&buffer.values[(channel_index * buffer.slots + slot) * stride], samples, bytes);
+        col.length = static_cast<uint32_t>(bytes.size() - col.offset);
+        col.crc = crc32(bytes.data() + col.offset, col.length);
+    }
+    memcpy(bytes.data(), &header, sizeof(header));
+    memcpy(bytes.data() + sizeof(header), columns.data(), columns.size() * sizeof(ChunkColumn));
+
+    // Chunk data first, its index entry after: a torn write never indexes
+    // a partial chunk. A torn chunk before this one leaves the file
+    // unaligned, so pad up to the next boundary first.
+    const std::string data_path = path(channel, ".dat");
+    long data_bytes = 0;
+    if (FILE* f = fopen(data_path.c_str(), "rb")) {
+        data_bytes = fileSize(f);
+        fclose(f);
+    }
+    if (data_bytes < 0) return false;
+    const size_t lead = (TELEMETRY_BLOCK_BYTES - static_cast<size_t>(data_bytes) % TELEMETRY_BLOCK_BYTES) %
+                        TELEMETRY_BLOCK_BYTES;
+    const size_t length = bytes.size();
+    bytes.insert(bytes.begin(), lead, 0);
+    bytes.resize((bytes.size() + TELEMETRY_BLOCK_BYTES - 1) / TELEMETRY_BLOCK_BYTES * TELEMETRY_BLOCK_BYTES, 0);
+    if (!appendDurable(data_path, bytes.data(), bytes.size())) return false;
+
+    IndexEntry entry = {};
+    entry.first_ms = times.front();
+    entry.last_ms = times.back();
+    entry.offset = static_cast<uint64_t>(data_bytes) + lead;
+    entry.length = static_cast<uint32_t>(length);
+    entry.crc = entryCrc(entry);
+    if (!appendDurable(path(channel, ".idx"), &entry, sizeof(entry))) return false;
+
+    m_stats.chunks++;
+    m_stats.bytes_written += bytes.size() + sizeof(entry);
+    m_stats.raw_bytes += samples * (sizeof(uint64_t) + columns.size() * sizeof(float));
+    return true;
+}
+
+// ====================================================================================
+// QUERY
+// ====================================================================================
+
+bool TelemetryArchive::query(HistoryChannel channel, uint32_t id, uint64_t from_ms, uint64_t to_ms,
+                             std::vector<TelemetryPoint>& out) const
+{
+    if (!isOpen() || channel >= HistoryChannel::Count) return false;
+    const bool is_terrarium = static_cast<size_t>(channel) < HISTORY_TERRARIUM_CHANNELS;
+    const size_t channel_index = is_terrarium ? static_cast<size_t>(channel)
+                                              : static_cast<size_t>(channel) - HISTORY_TERRARIUM_CHANNELS;
+
+    std::lock_guard<std::mutex> lock(m_write_mutex);
+    FILE* index = fopen(path(channel, ".idx").c_str(), "rb");
+    if (!index) return false;
+    const long size = fileSize(index);
+    const size_t entries = (size > static_cast<long>(sizeof(IndexHeader)))
+                               ? static_cast<size_t>(size - sizeof(IndexHeader)) / sizeof(IndexEntry)
+                               : 0;
+
+    // First chunk ending at or after from_ms
+    bool ok = true;
+    IndexEntry e;
+    size_t lo = 0;
+    size_t hi = entries;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        ok = readEntry(index, mid, e);
+        if (!ok) break;
+        if (e.last_ms < from_ms) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    FILE* data = nullptr;
+    std::vector<ChunkColumn> columns;
+    std::vector<uint8_t> bytes;
+    std::vector<uint64_t> times;
+    std::vector<float> values;
+    for (size_t k = lo; ok && k < entries; k++) {
+        ok = readEntry(index, k, e);
+        if (!ok || e.first_ms > to_ms) break;
+        if (!data) data = fopen(path(channel, ".dat").c_str(), "rb");
+
+        ChunkHeader header;
+        ok = data && e.length >= sizeof(header) && readAt(data, e.offset, &header, sizeof(header)) &&
+             memcmp(header.magic, CHUNK_MAGIC, sizeof(header.magic)) == 0 &&
+             sizeof(header) + static_cast<uint64_t>(header.entities) * sizeof(ChunkColumn) <= e.length;
+        if (!ok) break;
+
+        columns.resize(header.entities);
+        ok = readAt(data, e.offset + sizeof(header), columns.data(), columns.size() * sizeof(ChunkColumn));
+        const auto col = std::lower_bound(columns.begin(), columns.end(), id,
+                                          [](const ChunkColumn& c, uint32_t v) { return c.id < v; });
+        if (!ok || col == columns.end() || col->id != id) continue;
+
+        const uint64_t time_at = sizeof(header) + columns.size() * sizeof(ChunkColumn);
+        ok = time_at + header.time_bytes <= e.length && static_cast<uint64_t>(col->offset) + col->length <= e.length;
+        if (!ok) break;
+        bytes.resize(header.time_bytes);
+        times.resize(header.samples);
+        ok = readAt(data, e.offset + time_at, bytes.data(), bytes.size()) &&
+             crc32(bytes.data(), bytes.size()) == header.time_crc &&
+             decodeTimestamps(bytes.data(), bytes.size(), times.data(), times.size());
+        if (!ok) break;
+        bytes.resize(col->length);
+        values.resize(header.samples);
+        ok = readAt(data, e.offset + col->offset, bytes.data(), bytes.size()) &&
+             crc32(bytes.data(), bytes.size()) == col->crc &&
+             decodeXorFloats(bytes.data(), bytes.size(), values.data(), values.size());
+        if (!ok) break;
+
+        for (size_t s = 0; s < times.size(); s++) {
+            if (times[s] >= from_ms && times[s] <= to_ms && !std::isnan(values[s])) {
+                out.push_back({times[s], values[s]});
+            }
+        }
+    }
+    if (data) fclose(data);
+    fclose(index);
+
+    // Sealed samples are older than the ones still filling
+    queryBuffered(m_sealed, is_terrarium, channel_index, id, from_ms, to_ms, out);
+    queryBuffered(m_active, is_terrarium, channel_index, id, from_ms, to_ms, out);
+    return ok;
+}
+
+void TelemetryArchive::queryBuffered(const Chunk& chunk, bool is_terrarium, size_t channel_index, uint32_t id,
+                                     uint64_t from_ms, uint64_t to_ms, std::vector<TelemetryPoint>& out) const
+{
+    const Buffer& buffer = is_terrarium ? chunk.terrariums : chunk.reptiles;
+    const uint32_t slot = SlotMap::slotOf(id);
+    if (id == 0 || slot >= buffer.slots || buffer.owner[slot] != id) return;
+    const float* values = &buffer.values[(channel_index * buffer.slots + slot) * m_config.chunk_samples];
+    for (size_t k = 0; k < chunk.times.size(); k++) {
+        const uint64_t t = chunk.times[k];
+        if (t >= from_ms && t <= to_ms && !std::isnan(values[k])) out.push_back({t, values[k]});
+    }
+}
+
+} // namespace ReptileSim
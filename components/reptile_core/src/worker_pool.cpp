@@ -0,0 +1,266 @@
+/**
+ * @file worker_pool.cpp
+ * @brief Worker pool: std::thread on host, pinned FreeRTOS tasks on device
+ */
+
+#include "../include/worker_pool.hpp"
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#else
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace ReptileSim {
+
+// ====================================================================================
+// PLATFORM PRIMITIVES
+// ====================================================================================
+
+#ifdef ESP_PLATFORM
+
+static constexpr uint32_t WORKER_STACK_SIZE = 4096;
+
+struct WorkerPool::Worker {
+    WorkerPool* pool;
+    unsigned self;
+    TaskHandle_t task;
+};
+
+struct WorkerPool::Signals {
+    SemaphoreHandle_t done;     // Given once per worker per run()
+    volatile bool quit;
+};
+
+#else
+
+struct WorkerPool::Worker {
+    std::thread thread;
+};
+
+struct WorkerPool::Signals {
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    uint64_t generation = 0;    // Bumped once per run()
+    unsigned busy = 0;          // Workers still in the current run()
+    bool quit = false;
+};
+
+#endif
+
+// ====================================================================================
+// LIFECYCLE
+// ====================================================================================
+
+WorkerPool::WorkerPool() = default;
+
+WorkerPool::~WorkerPool()
+{
+    stop();
+}
+
+unsigned WorkerPool::defaultWorkers()
+{
+#ifdef ESP_PLATFORM
+    return portNUM_PROCESSORS - 1;
+#else
+    unsigned cores = std::thread::hardware_concurrency();
+    return (cores > 1) ? cores - 1 : 0;
+#endif
+}
+
+void WorkerPool::start(unsigned workers)
+{
+    stop();
+
+    m_ranges.reset(new Range[workers + 1]);
+    for (unsigned k = 0; k <= workers; k++) {
+        m_ranges[k].next.store(0, std::memory_order_relaxed);
+        m_ranges[k].end = 0;
+    }
+    if (workers == 0) return;
+
+    m_signals.reset(new Signals());
+
+#ifdef ESP_PLATFORM
+    m_signals->done = xSemaphoreCreateCounting(workers, 0);
+    m_signals->quit = false;
+    if (!m_signals->done) {
+        m_signals.reset();
+        return;
+    }
+
+    // Spread workers over the cores other than the caller's
+    const BaseType_t caller_core = xPortGetCoreID();
+    const UBaseType_t priority = uxTaskPriorityGet(nullptr);
+
+    // A task that cannot be created (out of heap) ends the pool there: the
+    // chunks are dealt over the workers that did start, or run inline
+    for (unsigned k = 0; k < workers; k++) {
+        Worker* w = new Worker{this, k + 1, nullptr};
+        const BaseType_t core = (caller_core + 1 + k) % portNUM_PROCESSORS;
+        if (xTaskCreatePinnedToCore(workerEntry, "sim_worker", WORKER_STACK_SIZE, w,
+                                    priority, &w->task, core) != pdPASS) {
+            delete w;
+            break;
+        }
+        m_workers.emplace_back(w);
+    }
+    if (m_workers.empty()) {
+        vSemaphoreDelete(m_signals->done);
+        m_signals.reset();
+    }
+#else
+    for (unsigned k = 0; k < workers; k++) {
+        Worker* w = new Worker();
+        m_workers.emplace_back(w);
+        w->thread = std::thread(&WorkerPool::workerMain, this, k + 1);
+    }
+#endif
+}
+
+void WorkerPool::stop()
+{
+    if (m_workers.empty()) return;
+
+#ifdef ESP_PLATFORM
+    m_signals->quit = true;
+    for (auto& w : m_workers) {
+        xTaskNotifyGive(w->task);
+    }
+    for (size_t k = 0; k < m_workers.size(); k++) {
+        xSemaphoreTake(m_signals->done, portMAX_DELAY);
+    }
+    vSemaphoreDelete(m_signals->done);
+#else
+    {
+        std::lock_guard<std::mutex> lock(m_signals->mutex);
+        m_signals->quit = true;
+    }
+    m_signals->wake.notify_all();
+    for (auto& w : m_workers) {
+        w->thread.join();
+    }
+#endif
+
+    m_workers.clear();
+    m_signals.reset();
+}
+
+// ====================================================================================
+// EXECUTION
+// ====================================================================================
+
+void WorkerPool::run(uint32_t chunk_count, ChunkFn fn, void* job)
+{
+    if (chunk_count == 0) return;
+
+    if (!m_ranges) start(0);
+
+    // Deal contiguous ranges so neighbouring chunks usually share a thread
+    const unsigned participants = workerCount() + 1;
+    for (unsigned k = 0; k < participants; k++) {
+        const uint32_t begin = static_cast<uint32_t>(uint64_t(chunk_count) * k / participants);
+        const uint32_t end = static_cast<uint32_t>(uint64_t(chunk_count) * (k + 1) / participants);
+        m_ranges[k].next.store(begin, std::memory_order_relaxed);
+        m_ranges[k].end = end;
+    }
+    m_fn = fn;
+    m_job = job;
+
+    if (participants == 1) {
+        participate(0);
+        return;
+    }
+
+#ifdef ESP_PLATFORM
+    for (auto& w : m_workers) {
+        xTaskNotifyGive(w->task);
+    }
+    participate(0);
+    for (size_t k = 0; k < m_workers.size(); k++) {
+        xSemaphoreTake(m_signals->done, portMAX_DELAY);
+    }
+#else
+    {
+        std::lock_guard<std::mutex> lock(m_signals->mutex);
+        m_signals->busy = workerCount();
+        m_signals->generation++;
+    }
+    m_signals->wake.notify_all();
+
+    participate(0);
+
+    std::unique_lock<std::mutex> lock(m_signals->mutex);
+    m_signals->done.wait(lock, [this] { return m_signals->busy == 0; });
+#endif
+}
+
+void WorkerPool::participate(unsigned self)
+{
+    const unsigned participants = workerCount() + 1;
+
+    // Own range first, then steal from the others in turn
+    for (unsigned k = 0; k < participants; k++) {
+        Range& range = m_ranges[(self + k) % participants];
+        for (;;) {
+            const uint32_t chunk = range.next.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= range.end) break;
+            m_fn(m_job, chunk);
+        }
+    }
+}
+
+#ifdef ESP_PLATFORM
+
+void WorkerPool::workerEntry(void* arg)
+{
+    Worker* w = static_cast<Worker*>(arg);
+    w->pool->workerMain(w->self);
+    vTaskDelete(nullptr);
+}
+
+void WorkerPool::workerMain(unsigned self)
+{
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (m_signals->quit) break;
+
+        participate(self);
+        xSemaphoreGive(m_signals->done);
+    }
+    xSemaphoreGive(m_signals->done);
+}
+
+#else
+
+void WorkerPool::workerMain(unsigned self)
+{
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_signals->mutex);
+            m_signals->wake.wait(lock, [&] {
+                return m_signals->quit || m_signals->generation != seen;
+            });
+            if (m_signals->quit) return;
+            seen = m_signals->generation;
+        }
+
+        participate(self);
+
+        std::lock_guard<std::mutex> lock(m_signals->mutex);
+        if (--m_signals->busy == 0) {
+            m_signals->done.notify_one();
+        }
+    }
+}
+
+#endif
+
+} // namespace ReptileSim
@@ -0,0 +1,647 @@
+/**
+ * @file reptile_bench.cpp
+ * @brief Host benchmark of reptile_core over generated facilities
+ *
+ * For each facility size (10 reptiles / 1 terrarium up to 1,000,000 /
+ * 100,000) a breeding facility is generated from a fixed seed and timed:
+ * - tick throughput in each TickMode, with the per-engine profile
+ * - fastForward() over one game day
+ * - saveGame() / loadGame(), plain and compressed, and the exportText()
+ *   round trip
+ * - exportHerdCsv() and importHerdCsv() into an emptied facility (last,
+ *   since the import allocates new ids)
+ * - the UI getters, by random id
+ *
+ * Results go to stdout (or --out) as JSON, one object per facility.
+ *
+ * Usage: reptile_bench [--max-reptiles N] [--scale R:T]... [--min-time S]
+ *                      [--seed N] [--workers N] [--tmp DIR] [--out FILE]
+ */
+
+#include "reptile_engine.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace ReptileSim;
+
+namespace {
+
+// ====================================================================================
+// FACILITY GENERATOR
+// ====================================================================================
+
+/**
+ * @brief A species kept in the facility and how it is housed
+ */
+struct SpeciesProfile {
+    const char* species;
+    float share;                // Fraction of the animals
+    float group;                // Mean animals per enclosure
+    float width, height, depth; // Enclosure, cm
+    float weight_min, weight_max;
+    float temp_hot;             // Basking zone target, °C
+    float humidity;             // %
+    bool mister;
+};
+
+// A typical mixed breeding stock: geckos in small groups, most snakes and
+// agamids kept alone
+const SpeciesProfile SPECIES[] = {
+    {"Eublepharis macularius", 0.25f, 3.0f,  60.0f, 45.0f,  45.0f,   45.0f,   90.0f, 32.0f, 40.0f, false},
+    {"Pogona vitticeps",       0.22f, 1.2f, 120.0f, 60.0f,  60.0f,  300.0f,  550.0f, 40.0f, 35.0f, false},
+    {"Python regius",          0.20f, 1.0f, 120.0f, 60.0f,  50.0f, 1000.0f, 2000.0f, 32.0f, 60.0f, true},
+    {"Correlophus ciliatus",   0.12f, 2.0f,  45.0f, 60.0f,  45.0f,   35.0f,   55.0f, 26.0f, 70.0f, true},
+    {"Pantherophis guttatus",  0.12f, 1.0f,  90.0f, 45.0f,  45.0f,  300.0f,  700.0f, 30.0f, 50.0f, false},
+    {"Chamaeleo calyptratus",  0.04f, 1.0f,  60.0f, 120.0f, 60.0f,   90.0f,  180.0f, 32.0f, 60.0f, true},
+    {"Uromastyx ornata",       0.03f, 1.5f, 120.0f, 60.0f,  60.0f,  150.0f,  300.0f, 45.0f, 25.0f, false},
+    {"Heloderma suspectum",    0.02f, 1.0f, 150.0f, 60.0f,  75.0f,  350.0f,  700.0f, 32.0f, 35.0f, false},
+};
+
+// Share of animals not in an enclosure (quarantine, incoming, sold)
+constexpr float UNASSIGNED_SHARE = 0.03f;
+
+/**
+ * @brief splitmix64, so a seed gives the same facility everywhere
+ */
+class Rng {
+public:
+    explicit Rng(uint64_t seed) : m_state(seed) {}
+
+    uint64_t next()
+    {
+        uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    float unit() { return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f); }
+    float range(float lo, float hi) { return lo + (hi - lo) * unit(); }
+    uint32_t below(uint32_t n) { return static_cast<uint32_t>((next() >> 32) * n >> 32); }
+
+    // Index into a cumulative weight table
+    size_t pick(const std::vector<float>& cumulative)
+    {
+        const float x = unit() * cumulative.back();
+        size_t lo = 0, hi = cumulative.size() - 1;
+        while (lo < hi) {
+            const size_t mid = (lo + hi) / 2;
+            if (cumulative[mid] <= x) lo = mid + 1; else hi = mid;
+        }
+        return lo;
+    }
+
+private:
+    uint64_t m_state;
+};
+
+struct Facility {
+    std::vector<uint32_t> reptile_ids;
+    std::vector<uint32_t> terrarium_ids;
+    uint32_t unassigned;
+    uint32_t empty_terrariums;
+    uint32_t max_occupancy;
+};
+
+void clearFacility(ReptileEngine& engine)
+{
+    const GameState& state = engine.getState();
+    const std::vector<uint32_t> reptiles = state.reptiles.id;
+    const std::vector<uint32_t> terrariums = state.terrariums.id;
+    for (uint32_t id : reptiles) engine.removeReptile(id);
+    for (uint32_t id : terrariums) engine.removeTerrarium(id);
+}
+
+/**
+ * @brief Build a facility of `reptiles` animals in `terrariums` enclosures
+ *
+ * Each enclosure is given a species by animal share; every enclosure gets
+ * one animal while they last, then the rest go to enclosures weighted by
+ * the species' group size, so R/T sets the crowding and the species mix
+ * sets its spread. Vitals and enclosure climate start spread around the
+ * species' values.
+ */
+Facility generateFacility(ReptileEngine& engine, uint32_t reptiles, uint32_t terrariums, uint64_t seed)
+{
+    Rng rng(seed);
+    Facility fac = {};
+    clearFacility(engine);
+
+    std::vector<float> share_cdf, group_cdf;
+    float acc = 0.0f;
+    for (const SpeciesProfile& sp : SPECIES) {
+        acc += sp.share;
+        share_cdf.push_back(acc);
+    }
+
+    // Enclosures
+    std::vector<uint8_t> terra_species(terrariums);
+    acc = 0.0f;
+    for (uint32_t t = 0; t < terrariums; t++) {
+        const SpeciesProfile& sp = SPECIES[terra_species[t] = static_cast<uint8_t>(rng.pick(share_cdf))];
+        const float jitter = rng.range(0.9f, 1.1f);
+        fac.terrarium_ids.push_back(engine.addTerrarium(sp.width * jitter, sp.height * jitter, sp.depth * jitter));
+        acc += sp.group;
+        group_cdf.push_back(acc);
+    }
+
+    // Animals: unassigned first, then one per enclosure, then by group size
+    const uint32_t unassigned = static_cast<uint32_t>(reptiles * UNASSIGNED_SHARE);
+    std::vector<uint32_t> occupancy(terrariums, 0);
+    char name[16];
+    for (uint32_t i = 0; i < reptiles; i++) {
+        uint32_t terra = UINT32_MAX;
+        size_t species;
+        if (i >= unassigned && terrariums > 0) {
+            const uint32_t housed = i - unassigned;
+            terra = (housed < terrariums) ? housed : static_cast<uint32_t>(rng.pick(group_cdf));
+            species = terra_species[terra];
+        } else {
+            species = rng.pick(share_cdf);
+        }
+
+        snprintf(name, sizeof(name), "R%07u", i);
+        const uint32_t id = engine.addReptile(name, SPECIES[species].species);
+        fac.reptile_ids.push_back(id);
+        if (terra != UINT32_MAX) {
+            engine.assignReptile(id, fac.terrarium_ids[terra]);
+            occupancy[terra]++;
+        } else {
+            fac.unassigned++;
+        }
+    }
+    for (uint32_t n : occupancy) {
+        if (n == 0) fac.empty_terrariums++;
+        if (n > fac.max_occupancy) fac.max_occupancy = n;
+    }
+
+    // The engine has no setters for vitals or climate; seed the columns
+    // directly (everything is woken by the adds above anyway)
+    GameState& state = const_cast<GameState&>(engine.getState());
+    ReptileStore& r = state.reptiles;
+    for (size_t i = 0; i < r.size(); i++) {
+        const SpeciesProfile* sp = &SPECIES[0];
+        for (const SpeciesProfile& candidate : SPECIES) {
+            if (r.species[i] == candidate.species) sp = &candidate;
+        }
+        r.weight_grams[i] = rng.range(sp->weight_min, sp->weight_max);
+        r.bone_density[i] = rng.range(75.0f, 100.0f);
+        r.hydration[i] = rng.range(70.0f, 100.0f);
+        r.stress_level[i] = rng.range(0.0f, 30.0f);
+        r.stomach_content[i] = rng.range(0.0f, 100.0f);
+        r.immune_system[i] = rng.range(60.0f, 100.0f);
+    }
+    TerrariumStore& terra = state.terrariums;
+    for (size_t t = 0; t < terra.size(); t++) {
+        const SpeciesProfile& sp = SPECIES[terra_species[t]];
+        terra.temp_hot_zone[t] = sp.temp_hot + rng.range(-3.0f, 2.0f);
+        terra.temp_cold_zone[t] = sp.temp_hot - 8.0f + rng.range(-2.0f, 2.0f);
+        terra.humidity[t] = sp.humidity + rng.range(-10.0f, 10.0f);
+        terra.waste_level[t] = rng.range(0.0f, 40.0f);
+        terra.bacteria_count[t] = rng.range(0.0f, 20.0f);
+        uint8_t equipment = 0;
+        if (rng.unit() < 0.95f) equipment |= EQUIP_HEATER;
+        if (rng.unit() < 0.90f) equipment |= EQUIP_LIGHT;
+        if (sp.mister && rng.unit() < 0.80f) equipment |= EQUIP_MISTER;
+        terra.equipment[t] = equipment;
+    }
+    return fac;
+}
+
+// ====================================================================================
+// TIMING
+// ====================================================================================
+
+double nowSeconds()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Call fn(batch) with a growing batch until min_time has passed
+ * @return Seconds per unit of batch
+ */
+template <typename Fn>
+double timePerCall(double min_time, uint64_t& calls, Fn fn)
+{
+    uint64_t batch = 1;
+    calls = 0;
+    const double start = nowSeconds();
+    double elapsed = 0.0;
+    do {
+        fn(batch);
+        calls += batch;
+        elapsed = nowSeconds() - start;
+        if (batch < (1u << 20)) batch *= 2;
+    } while (elapsed < min_time);
+    return elapsed / static_cast<double>(calls);
+}
+
+volatile float g_sink;
+
+// ====================================================================================
+// JSON OUTPUT
+// ====================================================================================
+
+/**
+ * @brief Minimal streaming JSON writer (objects, arrays, numbers, strings)
+ */
+class Json {
+public:
+    explicit Json(FILE* f) : m_f(f) {}
+
+    void beginObject(const char* key = nullptr) { open(key, '{'); }
+    void endObject() { close('}'); }
+    void beginArray(const char* key = nullptr) { open(key, '['); }
+    void endArray() { close(']'); }
+
+    void value(const char* key, double v) { item(key); fprintf(m_f, "%.6g", v); }
+    void value(const char* key, uint64_t v) { item(key); fprintf(m_f, "%llu", static_cast<unsigned long long>(v)); }
+    void value(const char* key, uint32_t v) { value(key, static_cast<uint64_t>(v)); }
+    void value(const char* key, const char* v) { item(key); fprintf(m_f, "\"%s\"", v); }
+    void flag(const char* key, bool v) { item(key); fputs(v ? "true" : "false", m_f); }
+
+    void finish() { fputc('\n', m_f); }
+
+private:
+    FILE* m_f;
+    std::vector<bool> m_first;
+
+    void item(const char* key)
+    {
+        if (!m_first.empty()) {
+            if (!m_first.back()) fputc(',', m_f);
+            m_first.back() = false;
+            fprintf(m_f, "\n%*s", static_cast<int>(m_first.size()) * 2, "");
+        }
+        if (key) fprintf(m_f, "\"%s\": ", key);
+    }
+    void open(const char* key, char c)
+    {
+        item(key);
+        fputc(c, m_f);
+        m_first.push_back(true);
+    }
+    void close(char c)
+    {
+        const bool empty = m_first.back();
+        m_first.pop_back();
+        if (!empty) fprintf(m_f, "\n%*s", static_cast<int>(m_first.size()) * 2, "");
+        fputc(c, m_f);
+    }
+};
+
+// ====================================================================================
+// BENCHMARKS
+// ====================================================================================
+
+struct Options {
+    std::vector<std::pair<uint32_t, uint32_t>> scales;
+    uint32_t max_reptiles = 1000000;
+    double min_time = 0.5;
+    uint64_t seed = 1;
+    int workers = -1;
+    std::string tmp_dir = "/tmp";
+    const char* out = nullptr;
+};
+
+// Upper bound of the histogram bucket holding the q-quantile
+uint64_t profileQuantileNs(const ProfileStats& s, double q)
+{
+    const uint64_t target = static_cast<uint64_t>(q * static_cast<double>(s.calls));
+    uint64_t seen = 0;
+    for (size_t k = 0; k < PROFILE_HISTOGRAM_BUCKETS; k++) {
+        seen += s.histogram[k];
+        if (seen > target) return (2ull << k) - 1;
+    }
+    return s.max_ns;
+}
+
+void writeProfile(Json& json, const ReptileEngine& engine)
+{
+    json.beginObject("profile");
+    for (size_t k = 0; k < static_cast<size_t>(ProfileSlot::Count); k++) {
+        const ProfileSlot slot = static_cast<ProfileSlot>(k);
+        const ProfileStats& s = engine.getProfile(slot);
+        if (s.calls == 0) continue;
+        json.beginObject(profileSlotName(slot));
+        json.value("calls", s.calls);
+        json.value("mean_ns", s.meanNs());
+        json.value("min_ns", s.min_ns);
+        json.value("max_ns", s.max_ns);
+        json.value("p50_ns", profileQuantileNs(s, 0.50));
+        json.value("p99_ns", profileQuantileNs(s, 0.99));
+        json.endObject();
+    }
+    json.endObject();
+}
+
+void benchTicks(Json& json, ReptileEngine& engine, const Options& opt, double& fused_tick_seconds)
+{
+    static const struct { TickMode mode; const char* name; } MODES[] = {
+        {TickMode::Sequential, "sequential"},
+        {TickMode::Fused, "fused"},
+        {TickMode::Parallel, "parallel"},
+    };
+    const GameState& state = engine.getState();
+    const double entities = static_cast<double>(state.reptiles.size() + state.terrariums.size());
+
+    json.beginObject("tick");
+    for (const auto& m : MODES) {
+        engine.setTickMode(m.mode);
+        engine.tick(1.0f);  // Warm-up (parallel chunk plan, sleep state)
+        engine.resetProfile();
+
+        uint64_t ticks;
+        const double per_tick = timePerCall(opt.min_time, ticks, [&](uint64_t n) {
+            engine.tickBatch(static_cast<uint32_t>(n), 1.0f);
+        });
+        if (m.mode == TickMode::Fused) fused_tick_seconds = per_tick;
+
+        const ReptileEngine::SleepStats sleep = engine.getSleepStats();
+        json.beginObject(m.name);
+        json.value("ticks", ticks);
+        json.value("us_per_tick", per_tick * 1e6);
+        json.value("ticks_per_s", 1.0 / per_tick);
+        json.value("ns_per_entity", entities > 0 ? per_tick * 1e9 / entities : 0.0);
+        json.value("asleep", sleep.asleep);
+        writeProfile(json, engine);
+        json.endObject();
+    }
+    json.endObject();
+    engine.setTickMode(TickMode::Fused);
+}
+
+void benchFastForward(Json& json, ReptileEngine& engine, const Options& opt, double fused_tick_seconds)
+{
+    const double GAME_DAY_SECONDS = 86400.0;
+    const double ticks_per_day = GAME_DAY_SECONDS / 60.0;
+
+    uint64_t days;
+    const double per_day = timePerCall(opt.min_time, days, [&](uint64_t n) {
+        for (uint64_t d = 0; d < n; d++) engine.fastForward(GAME_DAY_SECONDS);
+    });
+
+    json.beginObject("fast_forward");
+    json.value("game_days", days);
+    json.value("ms_per_game_day", per_day * 1e3);
+    json.value("ticks_per_s", ticks_per_day / per_day);
+    json.value("speedup_vs_fused_tick", fused_tick_seconds * ticks_per_day / per_day);
+    json.endObject();
+}
+
+void benchSaveLoad(Json& json, ReptileEngine& engine, const Options& opt)
+{
+    const std::string path = opt.tmp_dir + "/reptile_bench_" + std::to_string(getpid()) + ".sav";
+    const size_t reptiles = engine.getState().reptiles.size();
+    const size_t terrariums = engine.getState().terrariums.size();
+
+    auto fileBytes = [&] {
+        long bytes = 0;
+        if (FILE* f = fopen(path.c_str(), "rb")) {
+            fseek(f, 0, SEEK_END);
+            bytes = ftell(f);
+            fclose(f);
+        }
+        return bytes;
+    };
+    auto intactAfter = [&](bool loaded) {
+        return loaded && engine.getState().reptiles.size() == reptiles &&
+               engine.getState().terrariums.size() == terrariums;
+    };
+
+    double t0 = nowSeconds();
+    const bool saved = engine.saveGame(path.c_str());
+    const double save_s = nowSeconds() - t0;
+    const long bytes = fileBytes();
+
+    t0 = nowSeconds();
+    const bool intact = intactAfter(saved && engine.loadGame(path.c_str()));
+    const double load_s = nowSeconds() - t0;
+    remove(path.c_str());
+
+    // Same snapshot with compressed sections; MB/s are of the raw size
+    engine.setSaveCompression(true);
+    t0 = nowSeconds();
+    const bool zsaved = engine.saveGame(path.c_str());
+    const double zsave_s = nowSeconds() - t0;
+    engine.setSaveCompression(false);
+    const long zbytes = fileBytes();
+
+    t0 = nowSeconds();
+    const bool zintact = intactAfter(zsaved && engine.loadGame(path.c_str()));
+    const double zload_s = nowSeconds() - t0;
+    remove(path.c_str());
+
+    // Text export (debug format) for comparison
+    t0 = nowSeconds();
+    const bool exported = engine.exportText(path.c_str());
+    const double export_s = nowSeconds() - t0;
+    t0 = nowSeconds();
+    const bool imported = exported && engine.loadGame(path.c_str());
+    const double import_s = nowSeconds() - t0;
+    remove(path.c_str());
+
+    json.beginObject("save_load");
+    json.flag("ok", intact);
+    json.value("bytes", static_cast<uint64_t>(bytes));
+    json.value("save_ms", save_s * 1e3);
+    json.value("load_ms", load_s * 1e3);
+    json.value("save_mb_per_s", save_s > 0 ? bytes / save_s / 1e6 : 0.0);
+    json.value("load_mb_per_s", load_s > 0 ? bytes / load_s / 1e6 : 0.0);
+    json.flag("compressed_ok", zintact);
+    json.value("compressed_bytes", static_cast<uint64_t>(zbytes));
+    json.value("compression_ratio", zbytes > 0 ? static_cast<double>(bytes) / zbytes : 0.0);
+    json.value("compressed_save_ms", zsave_s * 1e3);
+    json.value("compressed_load_ms", zload_s * 1e3);
+    json.value("compressed_save_mb_per_s", zsave_s > 0 ? bytes / zsave_s / 1e6 : 0.0);
+    json.value("compressed_load_mb_per_s", zload_s > 0 ? bytes / zload_s / 1e6 : 0.0);
+    json.flag("text_ok", imported);
+    json.value("text_export_ms", export_s * 1e3);
+    json.value("text_load_ms", import_s * 1e3);
+    json.endObject();
+}
+
+void benchCsv(Json& json, ReptileEngine& engine, const Options& opt)
+{
+    const std::string base = opt.tmp_dir + "/reptile_bench_" + std::to_string(getpid());
+    const std::string terr_path = base + "_terrariums.csv";
+    const std::string rept_path = base + "_reptiles.csv";
+    const size_t reptiles = engine.getState().reptiles.size();
+    const size_t terrariums = engine.getState().terrariums.size();
+
+    double t0 = nowSeconds();
+    const bool exported = engine.exportHerdCsv(terr_path.c_str(), rept_path.c_str());
+    const double export_s = nowSeconds() - t0;
+
+    long bytes = 0;
+    if (FILE* f = fopen(rept_path.c_str(), "rb")) {
+        fseek(f, 0, SEEK_END);
+        bytes = ftell(f);
+        fclose(f);
+    }
+
+    clearFacility(engine);
+    CsvImportReport report;
+    t0 = nowSeconds();
+    const bool imported = exported && engine.importHerdCsv(terr_path.c_str(), rept_path.c_str(), &report);
+    const double import_s = nowSeconds() - t0;
+    remove(terr_path.c_str());
+    remove(rept_path.c_str());
+
+    json.beginObject("csv");
+    json.flag("ok", imported && report.rejected == 0 && report.reptiles == reptiles &&
+                    report.terrariums == terrariums);
+    json.value("reptile_bytes", static_cast<uint64_t>(bytes));
+    json.value("export_ms", export_s * 1e3);
+    json.value("import_ms", import_s * 1e3);
+    json.value("import_rows_per_s", import_s > 0 ? (reptiles + terrariums) / import_s : 0.0);
+    json.endObject();
+}
+
+void benchGetters(Json& json, ReptileEngine& engine, const Facility& fac, const Options& opt, Rng& rng)
+{
+    // Random ids defeat the cache the way a scrolling UI list would
+    constexpr size_t SAMPLE = 4096;
+    std::vector<uint32_t> reptiles(SAMPLE), terrariums(SAMPLE);
+    for (size_t i = 0; i < SAMPLE; i++) {
+        reptiles[i] = fac.reptile_ids.empty() ? 0 : fac.reptile_ids[rng.below(static_cast<uint32_t>(fac.reptile_ids.size()))];
+        terrariums[i] = fac.terrarium_ids.empty() ? 0 : fac.terrarium_ids[rng.below(static_cast<uint32_t>(fac.terrarium_ids.size()))];
+    }
+
+    json.beginObject("getters_ns");
+    auto run = [&](const char* name, auto fn) {
+        uint64_t calls;
+        const double per_call = timePerCall(opt.min_time / 4, calls, [&](uint64_t n) {
+            float acc = 0.0f;
+            for (uint64_t k = 0; k < n; k++) acc += fn(k & (SAMPLE - 1));
+            g_sink = acc;
+        });
+        json.value(name, per_call * 1e9);
+    };
+    run("reptile_stress", [&](size_t k) { return engine.getReptileStress(reptiles[k]); });
+    run("reptile_weight", [&](size_t k) { return engine.getReptileWeight(reptiles[k]); });
+    run("reptile_hungry", [&](size_t k) { return engine.isReptileHungry(reptiles[k]) ? 1.0f : 0.0f; });
+    run("terrarium_temp", [&](size_t k) { return engine.getTerrariumTemp(terrariums[k]); });
+    run("terrarium_occupant_count", [&](size_t k) {
+        return static_cast<float>(engine.getTerrariumOccupantCount(terrariums[k]));
+    });
+    run("terrarium_occupants", [&](size_t k) {
+        uint32_t ids[64];
+        return static_cast<float>(engine.getTerrariumOccupants(terrariums[k], ids, 64));
+    });
+    run("c_reptile_stress", [&](size_t k) { return reptile_engine_get_reptile_stress(reptiles[k]); });
+    json.endObject();
+}
+
+void benchScale(Json& json, ReptileEngine& engine, uint32_t reptiles, uint32_t terrariums, const Options& opt)
+{
+    const double t0 = nowSeconds();
+    const Facility fac = generateFacility(engine, reptiles, terrariums, opt.seed);
+    const double generate_s = nowSeconds() - t0;
+    Rng rng(opt.seed ^ 0xBE7C4ull);
+
+    fprintf(stderr, "reptile_bench: %u reptiles / %u terrariums\n", reptiles, terrariums);
+
+    json.beginObject();
+    json.value("reptiles", reptiles);
+    json.value("terrariums", terrariums);
+    json.value("unassigned", fac.unassigned);
+    json.value("empty_terrariums", fac.empty_terrariums);
+    json.value("max_occupancy", fac.max_occupancy);
+    json.value("generate_ms", generate_s * 1e3);
+
+    double fused_tick_seconds = 0.0;
+    benchTicks(json, engine, opt, fused_tick_seconds);
+    benchFastForward(json, engine, opt, fused_tick_seconds);
+    benchGetters(json, engine, fac, opt, rng);
+    benchSaveLoad(json, engine, opt);
+    benchCsv(json, engine, opt);
+    json.endObject();
+}
+
+bool parseArgs(int argc, char** argv, Options& opt)
+{
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* val = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!val) return false;
+        if (strcmp(arg, "--max-reptiles") == 0) {
+            opt.max_reptiles = static_cast<uint32_t>(strtoul(val, nullptr, 10));
+        } else if (strcmp(arg, "--scale") == 0) {
+            unsigned r, t;
+            if (sscanf(val, "%u:%u", &r, &t) != 2) return false;
+            opt.scales.emplace_back(r, t);
+        } else if (strcmp(arg, "--min-time") == 0) {
+            opt.min_time = atof(val);
+        } else if (strcmp(arg, "--seed") == 0) {
+            opt.seed = strtoull(val, nullptr, 10);
+        } else if (strcmp(arg, "--workers") == 0) {
+            opt.workers = atoi(val);
+        } else if (strcmp(arg, "--tmp") == 0) {
+            opt.tmp_dir = val;
+        } else if (strcmp(arg, "--out") == 0) {
+            opt.out = val;
+        } else {
+            return false;
+        }
+        i++;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr,
+                "usage: %s [--max-reptiles N] [--scale REPTILES:TERRARIUMS]... [--min-time S]\n"
+                "       [--seed N] [--workers N] [--tmp DIR] [--out FILE]\n", argv[0]);
+        return 2;
+    }
+    if (opt.scales.empty()) {
+        static const std::pair<uint32_t, uint32_t> LADDER[] = {
+            {10, 1}, {100, 10}, {1000, 100}, {10000, 1000}, {100000, 10000}, {1000000, 100000},
+        };
+        for (const auto& s : LADDER) {
+            if (s.first <= opt.max_reptiles) opt.scales.push_back(s);
+        }
+    }
+
+    FILE* out = opt.out ? fopen(opt.out, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "reptile_bench: cannot write %s\n", opt.out);
+        return 1;
+    }
+
+    ReptileEngine& engine = ReptileEngine::getInstance();
+    engine.init();
+    engine.setWorkerCount(opt.workers);
+
+    Json json(out);
+    json.beginObject();
+    json.value("benchmark", "reptile_core");
+    json.value("format", 1u);
+    json.value("compiler", __VERSION__);
+    json.value("hardware_threads", static_cast<uint32_t>(sysconf(_SC_NPROCESSORS_ONLN)));
+    json.flag("profiling", EngineProfiler::ENABLED);
+    json.value("seed", opt.seed);
+    json.value("min_time_s", opt.min_time);
+    json.beginArray("facilities");
+    for (const auto& s : opt.scales) {
+        benchScale(json, engine, s.first, s.second, opt);
+    }
+    json.endArray();
+    json.endObject();
+    json.finish();
+
+    if (out != stdout) fclose(out);
+    return 0;
+}
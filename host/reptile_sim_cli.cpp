@@ -0,0 +1,511 @@
+/**
+ * @file reptile_sim_cli.cpp
+ * @brief Headless simulation runner: same engine as the device, no 1 Hz pacing
+ *
+ * Starts from the init() demo facility or a save (--load), applies a
+ * scripted action timeline (--script) and ticks as fast as the host allows,
+ * printing a JSON summary line every --summary-every of game time and
+ * writing a final save.
+ *
+ * Usage: reptile_sim_cli [--load SAVE] [--script FILE] [--duration TIME]
+ *                        [--summary-every TIME] [--save FILE]
+ *                        [--mode sequential|fused|parallel] [--workers N]
+ *                        [--fast-forward]
+ *
+ * TIME is game time: a bare number is minutes (= ticks), or combine
+ * d/h/m units ("365d", "1d12h", "90m").
+ *
+ * Script lines are "TIME ACTION ARGS...", run in time order (ties in file
+ * order); '#' starts a comment and arguments with spaces are quoted.
+ * Entities are named by a label set with "as LABEL" when added, by a raw
+ * id, or "*" for every entity where noted:
+ *
+ *   0      clear                                   # drop the current facility
+ *   0      add_terrarium 120 60 60 as viv1
+ *   0      add_reptile Rex "Pogona vitticeps" in viv1 as rex
+ *   0      assign rex viv1                         # 0 = unassign
+ *   8h     feed rex                                # or *
+ *   1d     heater viv1 off                         # heater/light/mister, or *
+ *   2d     clean *
+ *   3d     remove_reptile rex
+ *   3d     remove_terrarium viv1
+ *   7d     save week1.sav
+ *   7d     summary
+ */
+
+#include "reptile_engine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace ReptileSim;
+
+namespace {
+
+constexpr uint64_t MINUTES_PER_HOUR = 60;
+constexpr uint64_t MINUTES_PER_DAY = 24 * MINUTES_PER_HOUR;
+
+// ====================================================================================
+// SCRIPT PARSING
+// ====================================================================================
+
+/**
+ * @brief One timeline entry (tick = game minutes since the run started)
+ */
+struct Action {
+    uint64_t tick;
+    int line;
+    std::vector<std::string> args;      // args[0] is the action name
+};
+
+/**
+ * @brief Parse "365d", "1d12h", "90m" or a bare minute count
+ */
+bool parseGameTime(const std::string& text, uint64_t& minutes)
+{
+    if (text.empty()) return false;
+    minutes = 0;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        char* end;
+        const unsigned long long n = strtoull(text.c_str() + pos, &end, 10);
+        const size_t next = static_cast<size_t>(end - text.c_str());
+        if (next == pos) return false;
+        pos = next;
+
+        uint64_t unit = 1;
+        if (pos < text.size()) {
+            switch (text[pos]) {
+                case 'd': unit = MINUTES_PER_DAY; break;
+                case 'h': unit = MINUTES_PER_HOUR; break;
+                case 'm': unit = 1; break;
+                default: return false;
+            }
+            pos++;
+        } else if (minutes != 0) {
+            return false;   // "1d30" is ambiguous
+        }
+        minutes += n * unit;
+    }
+    return true;
+}
+
+/**
+ * @brief Split a line into words; "double quotes" group, # comments out
+ */
+std::vector<std::string> tokenize(const char* line)
+{
+    std::vector<std::string> words;
+    const char* p = line;
+    while (*p) {
+        while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+        if (!*p || *p == '#') break;
+
+        std::string word;
+        if (*p == '"') {
+            for (p++; *p && *p != '"'; p++) word += *p;
+            if (*p == '"') p++;
+        } else {
+            for (; *p && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n'; p++) word += *p;
+        }
+        words.push_back(word);
+    }
+    return words;
+}
+
+const char* const ACTIONS[] = {
+    "clear", "add_terrarium", "add_reptile", "assign", "remove_reptile", "remove_terrarium",
+    "feed", "clean", "heater", "light", "mister", "save", "summary",
+};
+
+bool knownAction(const std::string& verb)
+{
+    for (const char* name : ACTIONS) {
+        if (verb == name) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Read a script; any malformed line fails the whole file up front
+ */
+bool loadScript(const char* path, std::vector<Action>& actions)
+{
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "reptile_sim_cli: cannot open script %s\n", path);
+        return false;
+    }
+
+    char line[1024];
+    int line_no = 0;
+    bool ok = true;
+    while (fgets(line, sizeof(line), f)) {
+        line_no++;
+        std::vector<std::string> words = tokenize(line);
+        if (words.empty()) continue;
+
+        Action a;
+        a.line = line_no;
+        if (words.size() < 2 || !parseGameTime(words[0], a.tick)) {
+            fprintf(stderr, "%s:%d: expected TIME ACTION ...\n", path, line_no);
+            ok = false;
+            continue;
+        }
+        if (!knownAction(words[1])) {
+            fprintf(stderr, "%s:%d: unknown action %s\n", path, line_no, words[1].c_str());
+            ok = false;
+            continue;
+        }
+        a.args.assign(words.begin() + 1, words.end());
+        actions.push_back(a);
+    }
+    fclose(f);
+
+    std::stable_sort(actions.begin(), actions.end(),
+                     [](const Action& x, const Action& y) { return x.tick < y.tick; });
+    return ok;
+}
+
+// ====================================================================================
+// ACTIONS
+// ====================================================================================
+
+/**
+ * @brief Applies script actions to the engine, resolving labels to ids
+ */
+class ScriptRunner {
+public:
+    explicit ScriptRunner(ReptileEngine& engine) : m_engine(engine) {}
+
+    // Returns false on a malformed action (the run stops)
+    bool apply(const Action& a, const char* script);
+
+    // Set by "summary" actions, cleared by the caller
+    bool summary_requested = false;
+
+private:
+    ReptileEngine& m_engine;
+    std::map<std::string, uint32_t> m_labels;
+
+    bool resolve(const std::string& ref, uint32_t& id) const;
+    std::vector<uint32_t> targets(const std::string& ref, bool terrariums) const;
+    void label(const std::vector<std::string>& args, size_t from, uint32_t id);
+    static const std::string* option(const std::vector<std::string>& args, size_t from, const char* key);
+};
+
+bool ScriptRunner::resolve(const std::string& ref, uint32_t& id) const
+{
+    auto it = m_labels.find(ref);
+    if (it != m_labels.end()) {
+        id = it->second;
+        return true;
+    }
+    char* end;
+    const unsigned long n = strtoul(ref.c_str(), &end, 10);
+    if (ref.empty() || *end) return false;
+    id = static_cast<uint32_t>(n);
+    return true;
+}
+
+std::vector<uint32_t> ScriptRunner::targets(const std::string& ref, bool terrariums) const
+{
+    if (ref == "*") {
+        const GameState& state = m_engine.getState();
+        return terrariums ? state.terrariums.id : state.reptiles.id;
+    }
+    uint32_t id;
+    if (!resolve(ref, id)) return {};
+    return {id};
+}
+
+const std::string* ScriptRunner::option(const std::vector<std::string>& args, size_t from, const char* key)
+{
+    for (size_t i = from; i + 1 < args.size(); i++) {
+        if (args[i] == key) return &args[i + 1];
+    }
+    return nullptr;
+}
+
+void ScriptRunner::label(const std::vector<std::string>& args, size_t from, uint32_t id)
+{
+    if (const std::string* name = option(args, from, "as")) m_labels[*name] = id;
+}
+
+bool ScriptRunner::apply(const Action& a, const char* script)
+{
+    const std::vector<std::string>& args = a.args;
+    const std::string& verb = args[0];
+    auto fail = [&](const char* what) {
+        fprintf(stderr, "%s:%d: %s: %s\n", script, a.line, verb.c_str(), what);
+        return false;
+    };
+    auto warn = [&](const char* what) {
+        fprintf(stderr, "%s:%d: %s: %s (ignored)\n", script, a.line, verb.c_str(), what);
+        return true;
+    };
+
+    if (verb == "clear") {
+        const GameState& state = m_engine.getState();
+        const std::vector<uint32_t> reptiles = state.reptiles.id;
+        const std::vector<uint32_t> terrariums = state.terrariums.id;
+        for (uint32_t id : reptiles) m_engine.removeReptile(id);
+        for (uint32_t id : terrariums) m_engine.removeTerrarium(id);
+        m_labels.clear();
+        return true;
+    }
+    if (verb == "add_terrarium") {
+        if (args.size() < 4) return fail("expected WIDTH HEIGHT DEPTH");
+        const uint32_t id = m_engine.addTerrarium(strtof(args[1].c_str(), nullptr),
+                                                  strtof(args[2].c_str(), nullptr),
+                                                  strtof(args[3].c_str(), nullptr));
+        label(args, 4, id);
+        return true;
+    }
+    if (verb == "add_reptile") {
+        if (args.size() < 3) return fail("expected NAME SPECIES");
+        const uint32_t id = m_engine.addReptile(args[1], args[2]);
+        label(args, 3, id);
+        if (const std::string* home = option(args, 3, "in")) {
+            uint32_t terrarium;
+            if (!resolve(*home, terrarium) || !m_engine.assignReptile(id, terrarium)) {
+                return warn("unknown terrarium");
+            }
+        }
+        return true;
+    }
+    if (verb == "assign") {
+        uint32_t reptile, terrarium;
+        if (args.size() < 3 || !resolve(args[1], reptile) || !resolve(args[2], terrarium)) {
+            return fail("expected REPTILE TERRARIUM");
+        }
+        return m_engine.assignReptile(reptile, terrarium) ? true : warn("unknown id");
+    }
+    if (verb == "remove_reptile" || verb == "remove_terrarium") {
+        uint32_t id;
+        if (args.size() < 2 || !resolve(args[1], id)) return fail("expected an id or label");
+        const bool removed = (verb == "remove_reptile") ? m_engine.removeReptile(id)
+                                                        : m_engine.removeTerrarium(id);
+        return removed ? true : warn("unknown id");
+    }
+    if (verb == "feed") {
+        if (args.size() < 2) return fail("expected REPTILE or *");
+        for (uint32_t id : targets(args[1], false)) m_engine.feedAnimal(id);
+        return true;
+    }
+    if (verb == "clean") {
+        if (args.size() < 2) return fail("expected TERRARIUM or *");
+        for (uint32_t id : targets(args[1], true)) m_engine.cleanTerrarium(id);
+        return true;
+    }
+    if (verb == "heater" || verb == "light" || verb == "mister") {
+        if (args.size() < 3 || (args[2] != "on" && args[2] != "off")) {
+            return fail("expected TERRARIUM|* on|off");
+        }
+        const bool on = (args[2] == "on");
+        for (uint32_t id : targets(args[1], true)) {
+            if (verb == "heater") m_engine.setHeater(id, on);
+            else if (verb == "light") m_engine.setLight(id, on);
+            else m_engine.setMister(id, on);
+        }
+        return true;
+    }
+    if (verb == "save") {
+        if (args.size() < 2) return fail("expected FILE");
+        return m_engine.saveGame(args[1].c_str()) ? true : warn("cannot write");
+    }
+    if (verb == "summary") {
+        summary_requested = true;
+        return true;
+    }
+    return fail("unknown action");
+}
+
+// ====================================================================================
+// SUMMARIES
+// ====================================================================================
+
+double nowSeconds()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief One JSON line of herd-wide state
+ */
+void printSummary(const ReptileEngine& engine, uint64_t tick, double wall_seconds)
+{
+    const GameState& s = engine.getState();
+    const ReptileStore& r = s.reptiles;
+    const TerrariumStore& t = s.terrariums;
+
+    double stress = 0.0, weight = 0.0, immune = 0.0;
+    uint32_t hungry = 0, unhealthy = 0;
+    for (size_t i = 0; i < r.size(); i++) {
+        stress += r.stress_level[i];
+        weight += r.weight_grams[i];
+        immune += r.immune_system[i];
+        if (r.hasFlag(i, REPTILE_FLAG_HUNGRY)) hungry++;
+        if (!r.hasFlag(i, REPTILE_FLAG_HEALTHY)) unhealthy++;
+    }
+    double temp = 0.0, waste = 0.0;
+    for (size_t i = 0; i < t.size(); i++) {
+        temp += t.temp_hot_zone[i];
+        waste += t.waste_level[i];
+    }
+    const double nr = r.empty() ? 1.0 : static_cast<double>(r.size());
+    const double nt = t.empty() ? 1.0 : static_cast<double>(t.size());
+
+    printf("{\"tick\": %llu, \"day\": %u, \"hours\": %.2f, \"reptiles\": %zu, \"terrariums\": %zu, "
+           "\"avg_stress\": %.2f, \"avg_weight\": %.1f, \"avg_immune\": %.2f, \"hungry\": %u, "
+           "\"unhealthy\": %u, \"avg_hot_temp\": %.2f, \"avg_waste\": %.2f, \"external_temp\": %.2f, "
+           "\"heatwave\": %s, \"expenses\": %.2f, \"wall_s\": %.3f}\n",
+           static_cast<unsigned long long>(tick), s.game_day, s.game_time_hours, r.size(), t.size(),
+           stress / nr, weight / nr, immune / nr, hungry, unhealthy, temp / nt, waste / nt,
+           s.external_temperature, s.heatwave_active ? "true" : "false", s.economy.total_expenses,
+           wall_seconds);
+    fflush(stdout);
+}
+
+// ====================================================================================
+// MAIN LOOP
+// ====================================================================================
+
+struct Options {
+    const char* load = nullptr;
+    const char* script = nullptr;
+    const char* save = "final.sav";
+    uint64_t duration = 0;          // 0 = until the last action
+    uint64_t summary_every = MINUTES_PER_DAY;
+    TickMode mode = TickMode::Fused;
+    int workers = -1;
+    bool fast_forward = false;
+};
+
+bool parseArgs(int argc, char** argv, Options& opt)
+{
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "--fast-forward") == 0) {
+            opt.fast_forward = true;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        const char* val = argv[++i];
+        if (strcmp(arg, "--load") == 0) {
+            opt.load = val;
+        } else if (strcmp(arg, "--script") == 0) {
+            opt.script = val;
+        } else if (strcmp(arg, "--save") == 0) {
+            opt.save = val;
+        } else if (strcmp(arg, "--duration") == 0) {
+            if (!parseGameTime(val, opt.duration)) return false;
+        } else if (strcmp(arg, "--summary-every") == 0) {
+            if (!parseGameTime(val, opt.summary_every)) return false;
+        } else if (strcmp(arg, "--workers") == 0) {
+            opt.workers = atoi(val);
+        } else if (strcmp(arg, "--mode") == 0) {
+            if (strcmp(val, "sequential") == 0) opt.mode = TickMode::Sequential;
+            else if (strcmp(val, "fused") == 0) opt.mode = TickMode::Fused;
+            else if (strcmp(val, "parallel") == 0) opt.mode = TickMode::Parallel;
+            else return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Advance by `ticks` game minutes, ticked or fast-forwarded
+ */
+void run(ReptileEngine& engine, uint64_t ticks, bool fast_forward)
+{
+    if (fast_forward) {
+        if (ticks > 0) engine.fastForward(static_cast<double>(ticks) * 60.0);
+        return;
+    }
+    while (ticks > 0) {
+        const uint32_t batch = static_cast<uint32_t>(std::min<uint64_t>(ticks, UINT32_MAX));
+        engine.tickBatch(batch, 1.0f);
+        ticks -= batch;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr,
+                "usage: %s [--load SAVE] [--script FILE] [--duration TIME] [--summary-every TIME]\n"
+                "       [--save FILE] [--mode sequential|fused|parallel] [--workers N] [--fast-forward]\n"
+                "TIME: minutes, or d/h/m units (365d, 1d12h, 90m)\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<Action> actions;
+    if (opt.script && !loadScript(opt.script, actions)) return 2;
+
+    ReptileEngine& engine = ReptileEngine::getInstance();
+    engine.init();
+    engine.setTickMode(opt.mode);
+    engine.setWorkerCount(opt.workers);
+    if (opt.load && !engine.loadGame(opt.load)) {
+        fprintf(stderr, "reptile_sim_cli: cannot load %s\n", opt.load);
+        return 1;
+    }
+
+    uint64_t end = opt.duration;
+    if (end == 0 && !actions.empty()) end = actions.back().tick;
+
+    ScriptRunner runner(engine);
+    const double start = nowSeconds();
+    uint64_t tick = 0;
+    uint64_t next_summary = opt.summary_every ? opt.summary_every : UINT64_MAX;
+    size_t next_action = 0;
+
+    // The first summary shows tick 0 after its actions (clear, adds)
+    uint64_t last_summary = UINT64_MAX;
+    while (true) {
+        // Actions due now run before the summary of the same tick
+        while (next_action < actions.size() && actions[next_action].tick <= tick) {
+            if (!runner.apply(actions[next_action], opt.script)) return 2;
+            next_action++;
+        }
+        const bool at_end = (tick >= end);
+        if (tick == 0 || runner.summary_requested || tick == next_summary || (at_end && last_summary != tick)) {
+            printSummary(engine, tick, nowSeconds() - start);
+            runner.summary_requested = false;
+            last_summary = tick;
+        }
+        if (tick == next_summary) next_summary += opt.summary_every;
+        if (at_end) break;
+
+        uint64_t stop = std::min(end, next_summary);
+        if (next_action < actions.size()) stop = std::min(stop, actions[next_action].tick);
+        run(engine, stop - tick, opt.fast_forward);
+        tick = stop;
+    }
+    if (next_action < actions.size()) {
+        fprintf(stderr, "reptile_sim_cli: %zu actions after --duration skipped\n", actions.size() - next_action);
+    }
+
+    const double wall = nowSeconds() - start;
+    fprintf(stderr, "reptile_sim_cli: %llu ticks (%.1f game days) in %.3f s",
+            static_cast<unsigned long long>(tick), static_cast<double>(tick) / MINUTES_PER_DAY, wall);
+    if (wall > 0.0) fprintf(stderr, ", %.0fx real time", static_cast<double>(tick) / wall);
+    fputc('\n', stderr);
+
+    if (opt.save && *opt.save && !engine.saveGame(opt.save)) {
+        fprintf(stderr, "reptile_sim_cli: cannot write %s\n", opt.save);
+        return 1;
+    }
+    return 0;
+}
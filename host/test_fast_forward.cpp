@@ -0,0 +1,244 @@
+/**
+ * @file test_fast_forward.cpp
+ * @brief Differential test: fastForward() against the same span of ticks
+ *
+ * A facility is built and saved once; for each span the file is loaded
+ * twice, once stepped with tick(1.0f) and once skipped with fastForward().
+ * Spans cover whole game days, a week and one that ends mid-window (4321
+ * ticks). The results must agree within what fastForward() documents:
+ * - Clock and external temperature are identical.
+ * - Temperatures, humidity, immune, stomach and bone values are identical.
+ * - Stress differs by less than STRESS_TOLERANCE.
+ *
+ * Equipment failures are drawn differently by the two paths, so a
+ * terrarium that lost equipment in either run is skipped, together with
+ * the reptiles it houses.
+ *
+ * Usage: test_fast_forward [tmp dir]
+ */
+
+#include "reptile_engine.hpp"
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace ReptileSim;
+
+namespace {
+
+constexpr uint32_t REPTILES = 3000;
+constexpr uint32_t TERRARIUMS = 300;
+constexpr uint64_t SEED = 0xFA57F0D;
+constexpr float STRESS_TOLERANCE = 0.01f;    // Bound in the fastForward() doc
+
+constexpr uint64_t START_DAY = 40;            // Spans start at 13:00, off the window grid
+const uint32_t SPANS[] = {1440, 2880, 4321, 10080};
+
+/**
+ * @brief splitmix64
+ */
+class Rng {
+public:
+    explicit Rng(uint64_t seed) : m_state(seed) {}
+
+    uint64_t next()
+    {
+        uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    float unit() { return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f); }
+    float range(float lo, float hi) { return lo + (hi - lo) * unit(); }
+    uint32_t below(uint32_t n) { return n ? static_cast<uint32_t>((next() >> 32) * n >> 32) : 0; }
+
+private:
+    uint64_t m_state;
+};
+
+void buildFacility(ReptileEngine& engine, Rng& rng)
+{
+    for (uint32_t t = 1; t < TERRARIUMS; t++) {
+        engine.addTerrarium(rng.range(45.0f, 150.0f), rng.range(45.0f, 120.0f), rng.range(40.0f, 75.0f));
+    }
+    for (uint32_t i = 1; i < REPTILES; i++) {
+        engine.addReptile("Animal", (i % 3) ? "Pogona vitticeps" : "Python regius");
+    }
+
+    // The engine has no setters for vitals or climate; seed the columns
+    GameState& state = const_cast<GameState&>(engine.getState());
+    state.setGameClock(START_DAY * GAME_MS_PER_DAY + 13 * GAME_MS_PER_HOUR);
+    ReptileStore& r = state.reptiles;
+    for (size_t i = 0; i < r.size(); i++) {
+        const uint32_t t = rng.below(TERRARIUMS + TERRARIUMS / 20);
+        engine.assignReptile(r.id[i], (t < state.terrariums.size()) ? state.terrariums.id[t] : 0);
+        r.weight_grams[i] = rng.range(40.0f, 2000.0f);
+        r.bone_density[i] = rng.range(70.0f, 100.0f);
+        r.hydration[i] = rng.range(60.0f, 100.0f);
+        r.stress_level[i] = rng.range(0.0f, 90.0f);
+        r.stomach_content[i] = rng.range(0.0f, 100.0f);
+        r.immune_system[i] = rng.range(50.0f, 100.0f);
+    }
+    TerrariumStore& terra = state.terrariums;
+    for (size_t t = 0; t < terra.size(); t++) {
+        terra.temp_hot_zone[t] = rng.range(20.0f, 40.0f);
+        terra.temp_cold_zone[t] = rng.range(18.0f, 28.0f);
+        terra.humidity[t] = rng.range(20.0f, 80.0f);
+        terra.waste_level[t] = rng.range(0.0f, 60.0f);
+        terra.bacteria_count[t] = rng.range(0.0f, 30.0f);
+        uint8_t equipment = 0;
+        if (rng.unit() < 0.7f) equipment |= EQUIP_HEATER;
+        if (rng.unit() < 0.8f) equipment |= EQUIP_LIGHT;
+        if (rng.unit() < 0.3f) equipment |= EQUIP_MISTER;
+        terra.equipment[t] = equipment;
+    }
+}
+
+/**
+ * @brief The state both paths are compared on
+ */
+struct Result {
+    uint64_t game_clock_ms;
+    float external_temperature;
+    ReptileStore reptiles;
+    TerrariumStore terrariums;
+};
+
+bool runSpan(const std::string& start, uint32_t ticks, bool fast, Result& out)
+{
+    ReptileEngine& engine = ReptileEngine::getInstance();
+    if (!engine.loadGame(start.c_str())) return false;
+    if (fast) {
+        engine.fastForward(static_cast<double>(ticks) * 60.0);
+    } else {
+        for (uint32_t n = 0; n < ticks; n++) engine.tick(1.0f);
+    }
+    const GameState& state = engine.getState();
+    out.game_clock_ms = state.game_clock_ms;
+    out.external_temperature = state.external_temperature;
+    out.reptiles = state.reptiles;
+    out.terrariums = state.terrariums;
+    return true;
+}
+
+struct Column {
+    const char* name;
+    const std::vector<float>& stepped;
+    const std::vector<float>& fast;
+    float tolerance;
+};
+
+/**
+ * @brief Largest difference over the compared rows; false if over tolerance
+ */
+bool compareColumn(const Column& column, const std::vector<bool>& compared)
+{
+    float worst = 0.0f;
+    size_t over = 0;
+    for (size_t i = 0; i < compared.size(); i++) {
+        if (!compared[i]) continue;
+        const float diff = std::fabs(column.stepped[i] - column.fast[i]);
+        if (diff > worst) worst = diff;
+        if (!(diff <= column.tolerance)) over++;
+    }
+    if (over) {
+        printf("    %-16s %zu rows off, max %g (allowed %g)\n", column.name, over, worst, column.tolerance);
+    }
+    return over == 0;
+}
+
+/**
+ * @brief Compare one span; prints a line per failing column
+ */
+bool compareSpan(uint32_t ticks, const Result& stepped, const Result& fast, const Result& before)
+{
+    bool ok = true;
+    if (stepped.game_clock_ms != fast.game_clock_ms || stepped.external_temperature != fast.external_temperature) {
+        printf("    clock or weather differs\n");
+        ok = false;
+    }
+    const size_t terrariums = before.terrariums.size();
+    const size_t reptiles = before.reptiles.size();
+    if (stepped.terrariums.size() != terrariums || fast.terrariums.size() != terrariums ||
+        stepped.reptiles.size() != reptiles || fast.reptiles.size() != reptiles) {
+        printf("    row counts differ\n");
+        return false;
+    }
+
+    // Skip terrariums that lost equipment in either run, and their reptiles
+    std::vector<bool> terra_compared(terrariums);
+    std::vector<uint32_t> skipped_ids;
+    for (size_t t = 0; t < terrariums; t++) {
+        const uint8_t equipment = before.terrariums.equipment[t];
+        terra_compared[t] = stepped.terrariums.equipment[t] == equipment && fast.terrariums.equipment[t] == equipment;
+        if (!terra_compared[t]) skipped_ids.push_back(before.terrariums.id[t]);
+    }
+    std::vector<bool> reptile_compared(reptiles);
+    size_t reptiles_compared = 0;
+    for (size_t i = 0; i < reptiles; i++) {
+        const uint32_t home = before.reptiles.assigned_terrarium_id[i];
+        bool compared = true;
+        for (uint32_t id : skipped_ids) compared = compared && id != home;
+        reptile_compared[i] = compared;
+        if (compared) reptiles_compared++;
+    }
+
+    const TerrariumStore& ts = stepped.terrariums;
+    const TerrariumStore& tf = fast.terrariums;
+    const Column terra_columns[] = {
+        {"temp_hot_zone", ts.temp_hot_zone, tf.temp_hot_zone, 0.0f},
+        {"temp_cold_zone", ts.temp_cold_zone, tf.temp_cold_zone, 0.0f},
+        {"humidity", ts.humidity, tf.humidity, 0.0f},
+    };
+    for (const Column& column : terra_columns) ok = compareColumn(column, terra_compared) && ok;
+
+    const ReptileStore& rs = stepped.reptiles;
+    const ReptileStore& rf = fast.reptiles;
+    const Column reptile_columns[] = {
+        {"immune_system", rs.immune_system, rf.immune_system, 0.0f},
+        {"stomach_content", rs.stomach_content, rf.stomach_content, 0.0f},
+        {"bone_density", rs.bone_density, rf.bone_density, 0.0f},
+        {"stress_level", rs.stress_level, rf.stress_level, STRESS_TOLERANCE},
+    };
+    for (const Column& column : reptile_columns) ok = compareColumn(column, reptile_compared) && ok;
+
+    printf("%5u ticks  %s (%zu/%zu terrariums, %zu/%zu reptiles compared)\n", ticks, ok ? "within bounds" : "OUT OF BOUNDS",
+           terrariums - skipped_ids.size(), terrariums, reptiles_compared, reptiles);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::string dir = (argc > 1) ? argv[1] : ".";
+    const std::string start = dir + "/test_fast_forward_start.sav";
+
+    ReptileEngine& engine = ReptileEngine::getInstance();
+    engine.init();
+    Rng rng(SEED);
+    buildFacility(engine, rng);
+    if (!engine.saveGame(start.c_str())) {
+        printf("cannot write %s\n", start.c_str());
+        return 1;
+    }
+    Result before;
+    before.reptiles = engine.getState().reptiles;
+    before.terrariums = engine.getState().terrariums;
+
+    int failures = 0;
+    for (uint32_t ticks : SPANS) {
+        Result stepped, fast;
+        if (!runSpan(start, ticks, false, stepped) || !runSpan(start, ticks, true, fast)) {
+            printf("%5u ticks  cannot load %s\n", ticks, start.c_str());
+            failures++;
+            continue;
+        }
+        if (!compareSpan(ticks, stepped, fast, before)) failures++;
+    }
+
+    remove(start.c_str());
+    return failures ? 1 : 0;
+}
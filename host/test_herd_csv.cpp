@@ -0,0 +1,116 @@
+/**
+ * @file test_herd_csv.cpp
+ * @brief Studbook import test: a failed import adds nothing
+ *
+ * importHerdCsv() is called with a missing reptile file, a reptile file
+ * without its species column, a missing terrarium file and a terrarium
+ * file without its depth column. Each call must return false and leave the
+ * terrarium and reptile counts as they were, so retrying does not
+ * duplicate rows. The same files, once fixed, are then imported once and
+ * must add every row with its terrarium reference mapped.
+ *
+ * Usage: test_herd_csv [tmp dir]
+ */
+
+#include "reptile_engine.hpp"
+#include <cstdio>
+#include <string>
+
+using namespace ReptileSim;
+
+namespace {
+
+bool writeFile(const std::string& path, const char* text)
+{
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    const bool ok = fputs(text, f) >= 0;
+    return (fclose(f) == 0) && ok;
+}
+
+struct Counts {
+    size_t terrariums;
+    size_t reptiles;
+};
+
+Counts counts(const ReptileEngine& engine)
+{
+    return {engine.getState().terrariums.size(), engine.getState().reptiles.size()};
+}
+
+/**
+ * @brief One import that must fail; false if it succeeded or changed the counts
+ */
+bool failsCleanly(const char* name, const char* terrariums_path, const char* reptiles_path)
+{
+    ReptileEngine& engine = ReptileEngine::getInstance();
+    const Counts before = counts(engine);
+    bool clean = true;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        CsvImportReport report;
+        const bool ok = engine.importHerdCsv(terrariums_path, reptiles_path, &report);
+        const Counts after = counts(engine);
+        clean = clean && !ok && after.terrariums == before.terrariums && after.reptiles == before.reptiles &&
+                report.terrariums == 0 && report.reptiles == 0;
+    }
+    const Counts after = counts(engine);
+    printf("%-26s %s (terrariums %zu -> %zu, reptiles %zu -> %zu)\n", name, clean ? "unchanged" : "CHANGED",
+           before.terrariums, after.terrariums, before.reptiles, after.reptiles);
+    return clean;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::string dir = (argc > 1) ? argv[1] : ".";
+    const std::string terrariums = dir + "/test_herd_terrariums.csv";
+    const std::string reptiles = dir + "/test_herd_reptiles.csv";
+    const std::string no_species = dir + "/test_herd_no_species.csv";
+    const std::string no_depth = dir + "/test_herd_no_depth.csv";
+    const std::string missing = dir + "/test_herd_missing.csv";
+
+    const bool written =
+        writeFile(terrariums, "id,width,height,depth\n7,120,60,60\n9,90,45,45\n") &&
+        writeFile(reptiles, "name,species,terrarium_id,weight_grams\n"
+                            "Ziggy,Pogona vitticeps,7,410\nMango,Python regius,9,\nDrift,Eublepharis macularius,,55\n") &&
+        writeFile(no_species, "name,terrarium_id\nZiggy,7\n") &&
+        writeFile(no_depth, "id,width,height\n7,120,60\n");
+    remove(missing.c_str());
+    if (!written) {
+        printf("cannot write the CSV files in %s\n", dir.c_str());
+        return 1;
+    }
+
+    ReptileEngine& engine = ReptileEngine::getInstance();
+    engine.init();
+
+    int failures = 0;
+    if (!failsCleanly("missing reptile file", terrariums.c_str(), missing.c_str())) failures++;
+    if (!failsCleanly("reptile file w/o species", terrariums.c_str(), no_species.c_str())) failures++;
+    if (!failsCleanly("missing terrarium file", missing.c_str(), reptiles.c_str())) failures++;
+    if (!failsCleanly("terrarium file w/o depth", no_depth.c_str(), reptiles.c_str())) failures++;
+
+    // The fixed import adds each row once, assigned to the new terrariums
+    const Counts before = counts(engine);
+    CsvImportReport report;
+    const bool ok = engine.importHerdCsv(terrariums.c_str(), reptiles.c_str(), &report);
+    const Counts after = counts(engine);
+    const GameState& state = engine.getState();
+    const size_t ziggy = state.reptiles.size() - 3;
+    const size_t drift = state.reptiles.size() - 1;
+    const uint32_t ziggy_home = state.reptiles.assigned_terrarium_id[ziggy];
+    const bool imported = ok && report.rejected == 0 && after.terrariums == before.terrariums + 2 &&
+                          after.reptiles == before.reptiles + 3 && ziggy_home != 0 &&
+                          ziggy_home == state.terrariums.id[after.terrariums - 2] &&
+                          state.reptiles.assigned_terrarium_id[drift] == 0;
+    printf("%-26s %s (terrariums %zu -> %zu, reptiles %zu -> %zu)\n", "valid files", imported ? "imported" : "WRONG",
+           before.terrariums, after.terrariums, before.reptiles, after.reptiles);
+    if (!imported) failures++;
+
+    remove(terrariums.c_str());
+    remove(reptiles.c_str());
+    remove(no_species.c_str());
+    remove(no_depth.c_str());
+    return failures ? 1 : 0;
+}
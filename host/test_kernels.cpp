@@ -0,0 +1,216 @@
+/**
+ * @file test_kernels.cpp
+ * @brief Kernel equivalence test: every SIMD level matches the scalar stages
+ *
+ * physicsKernel, sanitaryKernel and nutritionKernel are run at each
+ * dispatch level the CPU supports (forced with setSimdLevel()) on random
+ * columns with values around every clamp and threshold, for ranges of 0 to
+ * 17 entities starting at aligned and unaligned offsets. The result must
+ * be bit-identical to looping the scalar stage over the same range, and
+ * the entries outside the range must be untouched.
+ *
+ * Usage: test_kernels [rounds]
+ */
+
+#include "sim_kernels.hpp"
+#include "sim_stages.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+
+using namespace ReptileSim;
+
+namespace {
+
+constexpr size_t STORE_SIZE = 32;           // Room for the largest begin + n
+constexpr size_t MAX_COUNT = 17;            // Widest vector tail + 1
+constexpr size_t BEGINS[] = {0, 1, 2, 3, 5, 8, 13};
+constexpr uint32_t DEFAULT_ROUNDS = 200;
+constexpr float DTS[] = {1.0f, 0.5f, 0.1f, 60.0f};
+
+const SimdLevel LEVELS[] = {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2};
+const char* const LEVEL_NAMES[] = {"scalar", "sse2", "avx2"};
+
+/**
+ * @brief splitmix64
+ */
+class Rng {
+public:
+    explicit Rng(uint64_t seed) : m_state(seed) {}
+
+    uint64_t next()
+    {
+        uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    float unit() { return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f); }
+    float range(float lo, float hi) { return lo + (hi - lo) * unit(); }
+    uint32_t below(uint32_t n) { return static_cast<uint32_t>((next() >> 32) * n >> 32); }
+
+    // Mostly near one of the edges (exactly on it now and then), else anywhere
+    float around(std::initializer_list<float> edges, float lo, float hi)
+    {
+        const uint32_t pick = below(static_cast<uint32_t>(edges.size()) * 2 + 1);
+        if (pick >= edges.size() * 2) return range(lo, hi);
+        const float edge = edges.begin()[pick / 2];
+        return (pick & 1) ? edge : edge + range(-1.5f, 1.5f);
+    }
+
+private:
+    uint64_t m_state;
+};
+
+void randomTerrariums(TerrariumStore& terra, Rng& rng)
+{
+    for (size_t i = 0; i < STORE_SIZE; i++) {
+        terra.id[i] = static_cast<uint32_t>(i + 1);
+        terra.temp_hot_zone[i] = rng.around({35.0f, 22.0f, 0.0f}, -10.0f, 45.0f);
+        terra.temp_cold_zone[i] = rng.range(-10.0f, 40.0f);
+        terra.humidity[i] = rng.around({30.0f, 80.0f}, 0.0f, 100.0f);
+        terra.uv_index[i] = rng.range(0.0f, 10.0f);
+        terra.waste_level[i] = rng.around({100.0f, 99.5f, 0.0f}, 0.0f, 100.0f);
+        terra.bacteria_count[i] = rng.around({100.0f, 99.9f}, 0.0f, 100.0f);
+        terra.volume[i] = rng.range(1000.0f, 500000.0f);
+        terra.equipment[i] = static_cast<uint8_t>(rng.below(256));
+    }
+}
+
+void randomReptiles(ReptileStore& reptiles, Rng& rng)
+{
+    for (size_t i = 0; i < STORE_SIZE; i++) {
+        reptiles.id[i] = static_cast<uint32_t>(i + 1);
+        reptiles.stomach_content[i] = rng.around({0.0f, 20.0f, 30.0f, 0.5f}, 0.0f, 100.0f);
+        reptiles.bone_density[i] = rng.around({0.0f, 0.1f}, 0.0f, 100.0f);
+        reptiles.weight_grams[i] = rng.range(10.0f, 3000.0f);
+        reptiles.hydration[i] = rng.range(0.0f, 100.0f);
+        reptiles.stress_level[i] = rng.range(0.0f, 100.0f);
+        reptiles.immune_system[i] = rng.range(0.0f, 100.0f);
+        reptiles.flags[i] = static_cast<uint8_t>(rng.below(256));
+    }
+}
+
+template <typename T>
+bool sameBits(const std::vector<T>& a, const std::vector<T>& b)
+{
+    return a.size() == b.size() && memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+bool sameTerrariums(const TerrariumStore& a, const TerrariumStore& b)
+{
+    return sameBits(a.temp_hot_zone, b.temp_hot_zone) && sameBits(a.temp_cold_zone, b.temp_cold_zone) &&
+           sameBits(a.humidity, b.humidity) && sameBits(a.uv_index, b.uv_index) &&
+           sameBits(a.waste_level, b.waste_level) && sameBits(a.bacteria_count, b.bacteria_count) &&
+           sameBits(a.volume, b.volume) && sameBits(a.equipment, b.equipment);
+}
+
+bool sameReptiles(const ReptileStore& a, const ReptileStore& b)
+{
+    return sameBits(a.stomach_content, b.stomach_content) && sameBits(a.bone_density, b.bone_density) &&
+           sameBits(a.weight_grams, b.weight_grams) && sameBits(a.hydration, b.hydration) &&
+           sameBits(a.stress_level, b.stress_level) && sameBits(a.immune_system, b.immune_system) &&
+           sameBits(a.flags, b.flags);
+}
+
+struct Failure {
+    const char* kernel;
+    size_t begin;
+    size_t count;
+    float dt;
+};
+
+/**
+ * @brief All three kernels over every range at the current level
+ */
+bool checkRound(Rng& rng, Failure& failure)
+{
+    TerrariumStore terra;
+    terra.id.resize(STORE_SIZE);
+    terra.temp_hot_zone.resize(STORE_SIZE);
+    terra.temp_cold_zone.resize(STORE_SIZE);
+    terra.humidity.resize(STORE_SIZE);
+    terra.uv_index.resize(STORE_SIZE);
+    terra.waste_level.resize(STORE_SIZE);
+    terra.bacteria_count.resize(STORE_SIZE);
+    terra.volume.resize(STORE_SIZE);
+    terra.equipment.resize(STORE_SIZE);
+    randomTerrariums(terra, rng);
+
+    ReptileStore reptiles;
+    reptiles.id.resize(STORE_SIZE);
+    reptiles.stomach_content.resize(STORE_SIZE);
+    reptiles.bone_density.resize(STORE_SIZE);
+    reptiles.weight_grams.resize(STORE_SIZE);
+    reptiles.hydration.resize(STORE_SIZE);
+    reptiles.stress_level.resize(STORE_SIZE);
+    reptiles.immune_system.resize(STORE_SIZE);
+    reptiles.flags.resize(STORE_SIZE);
+    randomReptiles(reptiles, rng);
+
+    const float dt = DTS[rng.below(sizeof(DTS) / sizeof(DTS[0]))];
+    const bool daytime = rng.unit() < 0.5f;
+    const float external = rng.around({35.0f, 22.0f}, -5.0f, 40.0f);
+    const StageContext ctx = {nullptr, nullptr, dt, false, false};
+
+    for (size_t begin : BEGINS) {
+        for (size_t count = 0; count <= MAX_COUNT; count++) {
+            const size_t end = begin + count;
+            failure = {nullptr, begin, count, dt};
+
+            TerrariumStore expected = terra;
+            TerrariumStore actual = terra;
+            for (size_t i = begin; i < end; i++) physicsStage(expected, i, dt, daytime, external);
+            physicsKernel(actual, begin, end, dt, daytime, external);
+            failure.kernel = "physics";
+            if (!sameTerrariums(expected, actual)) return false;
+
+            expected = terra;
+            actual = terra;
+            for (size_t i = begin; i < end; i++) sanitaryStage(expected, i, dt);
+            sanitaryKernel(actual, begin, end, dt);
+            failure.kernel = "sanitary";
+            if (!sameTerrariums(expected, actual)) return false;
+
+            ReptileStore expected_r = reptiles;
+            ReptileStore actual_r = reptiles;
+            for (size_t i = begin; i < end; i++) nutritionStage(expected_r, i, ctx);
+            nutritionKernel(actual_r, begin, end, dt);
+            failure.kernel = "nutrition";
+            if (!sameReptiles(expected_r, actual_r)) return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint32_t rounds = (argc > 1) ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : DEFAULT_ROUNDS;
+
+    int failures = 0;
+    for (size_t l = 0; l < sizeof(LEVELS) / sizeof(LEVELS[0]); l++) {
+        setSimdLevel(LEVELS[l]);
+        if (simdLevel() != LEVELS[l]) {
+            printf("%-8s not supported here, skipped\n", LEVEL_NAMES[l]);
+            continue;
+        }
+
+        Rng rng(0xC0FFEE + l);
+        uint32_t r = 0;
+        Failure failure = {};
+        while (r < rounds && checkRound(rng, failure)) r++;
+        if (r == rounds) {
+            printf("%-8s identical (%u rounds)\n", LEVEL_NAMES[l], rounds);
+            continue;
+        }
+        printf("%-8s %s DIFFERS: round %u, begin %zu, n %zu, dt %g\n", LEVEL_NAMES[l], failure.kernel, r,
+               failure.begin, failure.count, failure.dt);
+        failures++;
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file test_tick_modes.cpp
+ * @brief Differential test: every TickMode gives the same saved state
+ *
+ * A facility is built and saved once; each run loads it and runs a few
+ * thousand ticks in Sequential (the reference), Fused or Parallel with
+ * several worker counts. Between batches the same player actions are applied: feeding,
+ * cleaning, equipment, reassignment, adds and removals, so the sleep/wake
+ * paths and the parallel chunk plan are exercised along with the stages.
+ * Part of the facility is left to settle and sleep. Each run ends with
+ * saveGame(), and the files must match byte for byte.
+ *
+ * Usage: test_tick_modes [ticks] [tmp dir]
+ */
+
+#include "reptile_engine.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace ReptileSim;
+
+namespace {
+
+constexpr uint32_t REPTILES = 6000;
+constexpr uint32_t TERRARIUMS = 600;
+constexpr uint32_t DEFAULT_TICKS = 3000;
+constexpr uint64_t SEED = 0x5EED2024;
+
+struct Run {
+    const char* name;
+    TickMode mode;
+    int workers;
+};
+
+const Run RUNS[] = {
+    {"sequential", TickMode::Sequential, 0},
+    {"fused", TickMode::Fused, 0},
+    {"parallel/0", TickMode::Parallel, 0},
+    {"parallel/1", TickMode::Parallel, 1},
+    {"parallel/3", TickMode::Parallel, 3},
+    {"parallel/7", TickMode::Parallel, 7},
+};
+
+/**
+ * @brief splitmix64 (same stream on every run)
+ */
+class Rng {
+public:
+    explicit Rng(uint64_t seed) : m_state(seed) {}
+
+    uint64_t next()
+    {
+        uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    float unit() { return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f); }
+    float range(float lo, float hi) { return lo + (hi - lo) * unit(); }
+    uint32_t below(uint32_t n) { return n ? static_cast<uint32_t>((next() >> 32) * n >> 32) : 0; }
+
+private:
+    uint64_t m_state;
+};
+
+void buildFacility(ReptileEngine& engine, Rng& rng)
+{
+    for (uint32_t t = 1; t < TERRARIUMS; t++) {
+        engine.addTerrarium(rng.range(45.0f, 150.0f), rng.range(45.0f, 120.0f), rng.range(40.0f, 75.0f));
+    }
+    for (uint32_t i = 1; i < REPTILES; i++) {
+        engine.addReptile("Animal", (i % 3) ? "Pogona vitticeps" : "Python regius");
+    }
+
+    // The engine has no setters for vitals or climate; seed the columns
+    GameState& state = const_cast<GameState&>(engine.getState());
+    ReptileStore& r = state.reptiles;
+    for (size_t i = 0; i < r.size(); i++) {
+        const uint32_t t = rng.below(TERRARIUMS + TERRARIUMS / 20);
+        engine.assignReptile(r.id[i], (t < state.terrariums.size()) ? state.terrariums.id[t] : 0);
+        r.weight_grams[i] = rng.range(40.0f, 2000.0f);
+        r.bone_density[i] = rng.range(70.0f, 100.0f);
+        r.hydration[i] = rng.range(60.0f, 100.0f);
+        r.stress_level[i] = rng.range(0.0f, 40.0f);
+        r.stomach_content[i] = rng.range(0.0f, 100.0f);
+        r.immune_system[i] = rng.range(50.0f, 100.0f);
+        if (i % 4 == 3) {
+            // Clamped at zero: these settle and sleep
+            r.stomach_content[i] = 0.0f;
+            r.immune_system[i] = 0.0f;
+        }
+    }
+    TerrariumStore& terra = state.terrariums;
+    for (size_t t = 0; t < terra.size(); t++) {
+        terra.temp_hot_zone[t] = rng.range(20.0f, 40.0f);
+        terra.temp_cold_zone[t] = rng.range(18.0f, 28.0f);
+        terra.humidity[t] = rng.range(20.0f, 80.0f);
+        terra.waste_level[t] = rng.range(0.0f, 60.0f);
+        terra.bacteria_count[t] = rng.range(0.0f, 30.0f);
+        uint8_t equipment = 0;
+        if (rng.unit() < 0.7f) equipment |= EQUIP_HEATER;
+        if (rng.unit() < 0.8f) equipment |= EQUIP_LIGHT;
+        if (rng.unit() < 0.3f) equipment |= EQUIP_MISTER;
+        terra.equipment[t] = equipment;
+    }
+}
+
+// A few player actions between two batches
+void playerActions(ReptileEngine& engine, Rng& rng)
+{
+    const GameState& state = engine.getState();
+    const uint32_t reptiles = static_cast<uint32_t>(state.reptiles.size());
+    const uint32_t terrariums = static_cast<uint32_t>(state.terrariums.size());
+
+    for (uint32_t n = rng.below(4); n > 0; n--) {
+        engine.feedAnimal(state.reptiles.id[rng.below(reptiles)]);
+    }
+    if (rng.unit() < 0.3f) engine.cleanTerrarium(state.terrariums.id[rng.below(terrariums)]);
+    if (rng.unit() < 0.3f) engine.setHeater(state.terrariums.id[rng.below(terrariums)], rng.unit() < 0.5f);
+    if (rng.unit() < 0.2f) {
+        const uint32_t t = rng.below(terrariums + 1);
+        engine.assignReptile(state.reptiles.id[rng.below(reptiles)], (t < terrariums) ? state.terrariums.id[t] : 0);
+    }
+    if (rng.unit() < 0.05f) engine.removeReptile(state.reptiles.id[rng.below(reptiles)]);
+    if (rng.unit() < 0.05f) engine.addReptile("Newcomer", "Eublepharis macularius");
+    if (rng.unit() < 0.02f) engine.removeTerrarium(state.terrariums.id[rng.below(terrariums)]);
+    if (rng.unit() < 0.02f) engine.addTerrarium(90.0f, 45.0f, 45.0f);
+}
+
+bool readFile(const std::string& path, std::vector<uint8_t>& out)
+{
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    out.clear();
+    uint8_t buffer[65536];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) out.insert(out.end(), buffer, buffer + n);
+    fclose(f);
+    return true;
+}
+
+/**
+ * @brief Run one mode from the start file and return its saved snapshot
+ */
+bool runMode(const Run& run, uint32_t ticks, const std::string& start, const std::string& path,
+             std::vector<uint8_t>& snapshot)
+{
+    ReptileEngine& engine = ReptileEngine::getInstance();
+    if (!engine.loadGame(start.c_str())) return false;
+    Rng rng(SEED + 1);
+    engine.setTickMode(run.mode);
+    engine.setWorkerCount(run.workers);
+
+    for (uint32_t done = 0; done < ticks;) {
+        playerActions(engine, rng);
+        uint32_t steps = 1 + rng.below(40);
+        if (steps > ticks - done) steps = ticks - done;
+        if (steps == 1) {
+            engine.tick(1.0f);
+        } else {
+            engine.tickBatch(steps, 1.0f);
+        }
+        done += steps;
+    }
+
+    const bool saved = engine.saveGame(path.c_str()) && readFile(path, snapshot);
+    remove(path.c_str());
+    return saved;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint32_t ticks = (argc > 1) ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : DEFAULT_TICKS;
+    const std::string dir = (argc > 2) ? argv[2] : ".";
+    const std::string start = dir + "/test_tick_modes_start.sav";
+    const std::string path = dir + "/test_tick_modes.sav";
+
+    // Every run starts from the same file, ids and free id slots included
+    ReptileEngine& engine = ReptileEngine::getInstance();
+    engine.init();
+    Rng rng(SEED);
+    buildFacility(engine, rng);
+    if (!engine.saveGame(start.c_str())) {
+        printf("cannot write %s\n", start.c_str());
+        return 1;
+    }
+
+    std::vector<uint8_t> reference;
+    int failures = 0;
+    for (const Run& run : RUNS) {
+        std::vector<uint8_t> snapshot;
+        if (!runMode(run, ticks, start, path, snapshot)) {
+            printf("%-12s save failed (%s)\n", run.name, path.c_str());
+            failures++;
+            continue;
+        }
+        if (&run == &RUNS[0]) {
+            reference = snapshot;
+            printf("%-12s reference, %u ticks, %zu bytes\n", run.name, ticks, snapshot.size());
+            continue;
+        }
+
+        const bool same = snapshot.size() == reference.size() &&
+                          memcmp(snapshot.data(), reference.data(), reference.size()) == 0;
+        if (same) {
+            printf("%-12s identical\n", run.name);
+            continue;
+        }
+        size_t at = 0;
+        while (at < snapshot.size() && at < reference.size() && snapshot[at] == reference[at]) at++;
+        printf("%-12s DIFFERS at byte %zu (%zu vs %zu bytes)\n", run.name, at, snapshot.size(), reference.size());
+        failures++;
+    }
+
+    remove(start.c_str());
+    engine.setWorkerCount(0);
+    return failures ? 1 : 0;
+}
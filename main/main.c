@@ -10,11 +10,13 @@
 
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
 #include "freertos/task.h"
 #include "nvs_flash.h"
 #include "sdkconfig.h"
 #include "esp_spiffs.h"
 #include <stdbool.h>
+#include <stdio.h>
 #include <string.h>
 
 // TIER 1: BSP
@@ -23,6 +25,9 @@
 // TIER 2: Simulation Core (C interface)
 #include "reptile_engine_c.h"
 
+// TIER 3: View-model bindings (labels set only on change)
+#include "ui_binding.h"
+
 // LVGL
 #include "esp_lvgl_port.h"
 #include "lvgl.h"
@@ -81,6 +86,7 @@ typedef enum {
 static void save_game_state(void);
 static void load_game_state(void);
 static void show_alert(alert_type_t type, const char *title, const char *message);
+static void drain_alerts(void);
 
 static void lvgl_self_test_timer_cb(lv_timer_t *timer)
 {
@@ -97,141 +103,172 @@ static void lvgl_self_test_timer_cb(lv_timer_t *timer)
     toggle = !toggle;
 }
 
+// ====================================================================================
+// UI ACTIONS
+// ====================================================================================
+
+// The engine is driven by sim_task alone: a button press is queued here and
+// applied between two batches, never while a tick (or its workers) runs
+#define UI_ACTION_QUEUE_LEN 16
+
+typedef enum {
+    UI_ACTION_TOGGLE_HEATER,
+    UI_ACTION_TOGGLE_LIGHT,
+    UI_ACTION_TOGGLE_MISTER,
+    UI_ACTION_FEED,
+    UI_ACTION_CLEAN,
+    UI_ACTION_ADD_TERRARIUM,
+    UI_ACTION_ADD_REPTILE,
+} ui_action_kind_t;
+
+typedef struct {
+    ui_action_kind_t kind;
+    uint32_t id;                // Terrarium or reptile the action is for
+} ui_action_t;
+
+static QueueHandle_t g_ui_actions = NULL;
+
+/**
+ * @brief Queue an action for sim_task (any task; dropped if the queue is full)
+ */
+static void post_ui_action(ui_action_kind_t kind, uint32_t id)
+{
+    const ui_action_t action = {kind, id};
+    if (!g_ui_actions || xQueueSend(g_ui_actions, &action, 0) != pdTRUE) {
+        ESP_LOGW(TAG, "UI action %d dropped (queue full)", (int)kind);
+    }
+}
+
+/**
+ * @brief Apply the queued actions (sim_task, between batches)
+ */
+static void apply_ui_actions(void)
+{
+    ui_action_t action;
+    while (xQueueReceive(g_ui_actions, &action, 0) == pdTRUE) {
+        switch (action.kind) {
+            case UI_ACTION_TOGGLE_HEATER: {
+                const bool on = !reptile_engine_get_heater_state(action.id);
+                reptile_engine_set_heater(action.id, on);
+                ESP_LOGI(TAG, "Heater toggled: %s", on ? "ON" : "OFF");
+                break;
+            }
+            case UI_ACTION_TOGGLE_LIGHT: {
+                const bool on = !reptile_engine_get_light_state(action.id);
+                reptile_engine_set_light(action.id, on);
+                ESP_LOGI(TAG, "Light toggled: %s", on ? "ON" : "OFF");
+                break;
+            }
+            case UI_ACTION_TOGGLE_MISTER: {
+                const bool on = !reptile_engine_get_mister_state(action.id);
+                reptile_engine_set_mister(action.id, on);
+                ESP_LOGI(TAG, "Mister toggled: %s", on ? "ON" : "OFF");
+                break;
+            }
+            case UI_ACTION_FEED:
+                reptile_engine_feed_animal(action.id);
+                ESP_LOGI(TAG, "Fed animal ID %lu (+$2 food cost)", (unsigned long)action.id);
+                break;
+            case UI_ACTION_CLEAN:
+                reptile_engine_clean_terrarium(action.id);
+                ESP_LOGI(TAG, "Cleaned terrarium ID %lu (waste/bacteria reduced)", (unsigned long)action.id);
+                break;
+            case UI_ACTION_ADD_TERRARIUM: {
+                const uint32_t new_id = reptile_engine_add_terrarium(120.0f, 60.0f, 60.0f);
+                ESP_LOGI(TAG, "Added terrarium ID %lu (120x60x60 cm)", (unsigned long)new_id);
+
+                lvgl_port_lock(0);
+                show_alert(ALERT_INFO, "Success", "New terrarium added!");
+                lvgl_port_unlock();
+                break;
+            }
+            case UI_ACTION_ADD_REPTILE: {
+                const uint32_t new_id = reptile_engine_add_reptile("New Reptile", "Pogona vitticeps");
+                ESP_LOGI(TAG, "Added reptile ID %lu (Pogona vitticeps)", (unsigned long)new_id);
+
+                lvgl_port_lock(0);
+                show_alert(ALERT_INFO, "Success", "New reptile added!");
+                lvgl_port_unlock();
+                break;
+            }
+        }
+    }
+}
+
 // ====================================================================================
 // RTOS TASKS
 // ====================================================================================
 
 /**
  * @brief Simulation Task (1Hz)
- * Runs the C++ simulation engine
+ * Runs the C++ simulation engine; at a time scale above 1x each wake-up
+ * runs several fixed 1 s steps in one batch
  */
 static void simulation_task(void *arg)
 {
     ESP_LOGI(TAG, "Simulation task started");
 
+    // Large herds are split across both HP cores; the worker tasks are
+    // created on the first tick that needs them, pinned to the other core
+    reptile_engine_set_tick_mode(REPTILE_TICK_PARALLEL);
+
     TickType_t last_wake = xTaskGetTickCount();
     const TickType_t period = pdMS_TO_TICKS(1000); // 1 second
 
     while (1) {
-        // Call C++ engine tick (delta_time = 1.0 seconds)
-        reptile_engine_tick(1.0f);
+        // Button presses since the last batch; the views they change are
+        // published with the batch below
+        apply_ui_actions();
+
+        // One real second at the current time scale (fixed 1 s steps)
+        reptile_engine_advance(1.0f);
 
         // Wait for next tick
         vTaskDelayUntil(&last_wake, period);
     }
 }
 
+// Binding counters are logged this often
+#define UI_STATS_PERIOD_MS 30000
+
+static void log_ui_stats(void)
+{
+    ui_binding_stats_t stats;
+    ui_binding_take_stats(&stats);
+    if (stats.frames == 0) return;
+
+    ESP_LOGI(TAG, "UI: %lu frames (%lu locked), %lu formatted, %lu labels set, frame avg %llu us max %lu us",
+             (unsigned long)stats.frames, (unsigned long)stats.locked_frames, (unsigned long)stats.formatted,
+             (unsigned long)stats.labels_set, (unsigned long long)(stats.frame_us / stats.frames),
+             (unsigned long)stats.frame_us_max);
+    ESP_LOGI(TAG, "UI: %lu redraws, %llu px invalidated, render avg %llu us max %lu us",
+             (unsigned long)stats.redraws, (unsigned long long)stats.invalidated_px,
+             (unsigned long long)(stats.redraws ? stats.redraw_us / stats.redraws : 0),
+             (unsigned long)stats.redraw_us_max);
+}
+
 /**
  * @brief UI Update Task (30Hz)
- * Updates LVGL widgets with simulation data
+ * Updates the bound LVGL labels from the published views
  */
 static void ui_update_task(void *arg)
 {
     ESP_LOGI(TAG, "UI update task started");
 
     TickType_t last_wake = xTaskGetTickCount();
+    TickType_t last_stats = last_wake;
     const TickType_t period = pdMS_TO_TICKS(33); // ~30 FPS
 
     while (1) {
-        uint32_t day = reptile_engine_get_day();
-        float hours = reptile_engine_get_time_hours();
-        int reptile_count = reptile_engine_get_reptile_count();
-        int terrarium_count = reptile_engine_get_terrarium_count();
-
-        if (g_label_time && g_label_stats) {
-
-            // Update time label
-            char time_buf[64];
-            snprintf(time_buf, sizeof(time_buf), "Day %lu - %02d:%02d",
-                     day, (int)hours, (int)((hours - (int)hours) * 60.0f));
-
-            // Update stats label
-            char stats_buf[128];
-            snprintf(stats_buf, sizeof(stats_buf),
-                     "Animals: %d | Terrariums: %d",
-                     reptile_count, terrarium_count);
-
-            lvgl_port_lock(0);
-            lv_label_set_text(g_label_time, time_buf);
-            lv_label_set_text(g_label_stats, stats_buf);
-            lvgl_port_unlock();
-        }
+        // Labels whose source changed since the last frame, one lock at most
+        ui_binding_frame();
 
-        // Update terrarium screen data (if labels exist)
-        if (g_label_temp && g_label_humidity && g_label_waste) {
-            // Get real-time terrarium data from engine (terrarium ID 1)
-            float temp = reptile_engine_get_terrarium_temp(g_selected_terrarium_id);
-            float humidity = reptile_engine_get_terrarium_humidity(g_selected_terrarium_id);
-            float waste = reptile_engine_get_terrarium_waste(g_selected_terrarium_id);
-
-            // Format temperature with icon
-            char temp_buf[64];
-            snprintf(temp_buf, sizeof(temp_buf), LV_SYMBOL_WARNING " Temp: %.1f°C", temp);
-
-            // Format humidity with icon
-            char humidity_buf[64];
-            snprintf(humidity_buf, sizeof(humidity_buf), LV_SYMBOL_REFRESH " Humidity: %.1f%%", humidity);
-
-            // Format waste with icon
-            char waste_buf[64];
-            snprintf(waste_buf, sizeof(waste_buf), LV_SYMBOL_TRASH " Waste: %.1f%%", waste);
-
-            lvgl_port_lock(0);
-            lv_label_set_text(g_label_temp, temp_buf);
-            lv_label_set_text(g_label_humidity, humidity_buf);
-            lv_label_set_text(g_label_waste, waste_buf);
-            lvgl_port_unlock();
-
-            // Check for critical conditions (alert every 30 seconds to avoid spam)
-            static uint32_t last_alert_tick = 0;
-            uint32_t now_tick = xTaskGetTickCount();
-            if ((now_tick - last_alert_tick) > pdMS_TO_TICKS(30000)) { // 30 seconds
-                // Temperature alerts
-                if (temp > 38.0f) {
-                    lvgl_port_lock(0);
-                    show_alert(ALERT_CRITICAL, "DANGER!", "Temperature too high!\nRisk of overheating.");
-                    lvgl_port_unlock();
-                    last_alert_tick = now_tick;
-                }
-                else if (temp < 20.0f) {
-                    lvgl_port_lock(0);
-                    show_alert(ALERT_WARNING, "Warning", "Temperature too low!\nTurn on heater.");
-                    lvgl_port_unlock();
-                    last_alert_tick = now_tick;
-                }
-                // Waste level alerts
-                else if (waste > 80.0f) {
-                    lvgl_port_lock(0);
-                    show_alert(ALERT_WARNING, "Sanitation Alert", "Waste level critical!\nClean terrarium now.");
-                    lvgl_port_unlock();
-                    last_alert_tick = now_tick;
-                }
-                // Reptile health alerts
-                else if (reptile_count > 0) {
-                    float stress = reptile_engine_get_reptile_stress(1);
-                    bool hungry = reptile_engine_is_reptile_hungry(1);
-                    bool healthy = reptile_engine_is_reptile_healthy(1);
-
-                    if (!healthy) {
-                        lvgl_port_lock(0);
-                        show_alert(ALERT_CRITICAL, "HEALTH CRISIS!", "Animal is sick!\nCheck conditions immediately.");
-                        lvgl_port_unlock();
-                        last_alert_tick = now_tick;
-                    }
-                    else if (stress > 80.0f) {
-                        lvgl_port_lock(0);
-                        show_alert(ALERT_WARNING, "Stress Alert", "Animal is very stressed!\nImprove habitat conditions.");
-                        lvgl_port_unlock();
-                        last_alert_tick = now_tick;
-                    }
-                    else if (hungry) {
-                        lvgl_port_lock(0);
-                        show_alert(ALERT_INFO, "Feeding Time", "Animal is hungry.\nFeed your reptile.");
-                        lvgl_port_unlock();
-                        last_alert_tick = now_tick;
-                    }
-                }
-            }
+        // Alert edges of every terrarium and animal, queued by the engine
+        drain_alerts();
+
+        if ((xTaskGetTickCount() - last_stats) >= pdMS_TO_TICKS(UI_STATS_PERIOD_MS)) {
+            log_ui_stats();
+            last_stats = xTaskGetTickCount();
         }
 
         vTaskDelayUntil(&last_wake, period);
@@ -259,28 +296,64 @@ static void lvgl_fallback_task(void *arg)
     }
 }
 
+// Journal autosave: append the changes often, rewrite the snapshot rarely
+#define AUTOSAVE_FLUSH_MS       10000               // Journal flush (bytes per action)
+#define AUTOSAVE_COMPACT_BYTES  (32 * 1024)         // Journal size that triggers a snapshot
+#define AUTOSAVE_COMPACT_TICKS  3600                // Replay length that triggers a snapshot
+#define AUTOSAVE_COMPACT_MIN_MS 300000              // At most one snapshot per 5 minutes
+#define AUTOSAVE_CAPTURE_WAIT_MS 2000               // sim_task reaches a tick boundary every second
+
+static bool g_telemetry_on = false;                 // Archive open on the SD card
+
 /**
- * @brief Auto-save task (every 5 minutes)
+ * @brief Auto-save task (journal flush every 10 seconds)
  */
 static void autosave_task(void *arg)
 {
-    ESP_LOGI(TAG, "Auto-save task started (5-minute intervals)");
+    ESP_LOGI(TAG, "Auto-save task started (journal flush every %d ms)", AUTOSAVE_FLUSH_MS);
+
+    TickType_t last_compact = xTaskGetTickCount();
 
     while (1) {
-        vTaskDelay(pdMS_TO_TICKS(300000)); // 5 minutes
-        save_game_state();
+        vTaskDelay(pdMS_TO_TICKS(AUTOSAVE_FLUSH_MS));
+
+        reptile_journal_stats_t stats;
+        reptile_engine_get_journal_stats(&stats);
+        const bool may_compact = (xTaskGetTickCount() - last_compact) >= pdMS_TO_TICKS(AUTOSAVE_COMPACT_MIN_MS);
+        if (may_compact && (stats.file_bytes + stats.pending_bytes >= AUTOSAVE_COMPACT_BYTES ||
+                            stats.ticks >= AUTOSAVE_COMPACT_TICKS)) {
+            // Bounds boot-time replay and journal size
+            save_game_state();
+            last_compact = xTaskGetTickCount();
+        } else if (!reptile_engine_journal_flush()) {
+            // A failed append closes the journal; a snapshot restarts it
+            ESP_LOGW(TAG, "Journal flush failed, writing a full snapshot");
+            save_game_state();
+        }
+
+        // Chunks sim_task sealed reach the SD card from here, not from the tick
+        if (g_telemetry_on && !reptile_engine_telemetry_write()) {
+            ESP_LOGW(TAG, "Telemetry chunk write failed");
+        }
     }
 }
 
 // ====================================================================================
-// SAVE/LOAD SYSTEM (SPIFFS - Complete State)
+// SAVE/LOAD SYSTEM (SPIFFS - Snapshot + Change Journal)
 // ====================================================================================
 
+#define SAVEGAME_PATH           "/storage/savegame.bin"
+#define SAVEGAME_JOURNAL_PATH   "/storage/savegame.jnl"     // Changes since the snapshot
+#define SAVEGAME_LEGACY_PATH    "/storage/savegame.txt"     // Text saves from older firmware
+#define TELEMETRY_DIR           BSP_SD_MOUNT_POINT "/tlm"   // 8.3 names: no LFN needed
+
 static void save_game_state(void)
 {
     ESP_LOGI(TAG, "Saving complete game state to SPIFFS...");
 
-    bool success = reptile_engine_save_game("/storage/savegame.txt");
+    // Full snapshot; the journal restarts empty on top of it. sim_task
+    // only copies the state at its next tick, this task does the writing
+    bool success = reptile_engine_journal_compact_background(AUTOSAVE_CAPTURE_WAIT_MS);
     if (success) {
         ESP_LOGI(TAG, "Game saved successfully (reptiles, terrariums, economy)");
     } else {
@@ -292,12 +365,28 @@ static void load_game_state(void)
 {
     ESP_LOGI(TAG, "Loading complete game state from SPIFFS...");
 
-    bool success = reptile_engine_load_game("/storage/savegame.txt");
+    // Snapshot plus the journaled changes since it was written
+    bool success = reptile_engine_journal_recover(SAVEGAME_PATH, SAVEGAME_JOURNAL_PATH);
     if (success) {
-        ESP_LOGI(TAG, "Game loaded successfully");
+        reptile_journal_stats_t stats;
+        reptile_engine_get_journal_stats(&stats);
+        ESP_LOGI(TAG, "Game loaded successfully (%lu journal records replayed)",
+                 (unsigned long)stats.records);
+        return;
+    }
+
+    if (reptile_engine_load_game(SAVEGAME_LEGACY_PATH)) {
+        // Convert once; from now on the snapshot and journal are used
+        ESP_LOGI(TAG, "Converted text save to binary snapshot");
+        success = true;
     } else {
         ESP_LOGI(TAG, "No saved game found (first run)");
     }
+    if (reptile_engine_journal_start(SAVEGAME_PATH, SAVEGAME_JOURNAL_PATH)) {
+        if (success) remove(SAVEGAME_LEGACY_PATH);
+    } else {
+        ESP_LOGW(TAG, "Failed to start the autosave journal");
+    }
 }
 
 // ====================================================================================
@@ -313,6 +402,56 @@ static void alert_msgbox_close_cb(lv_event_t *e)
     }
 }
 
+// Title and text per reptile_alert_kind_t
+static const struct {
+    const char *title;
+    const char *format;         // Takes the entity id
+} k_alert_text[] = {
+    {"DANGER!", "Temperature too high in terrarium %lu!\nRisk of overheating."},
+    {"Warning", "Temperature too low in terrarium %lu!\nTurn on heater."},
+    {"Sanitation Alert", "Waste level critical in terrarium %lu!\nClean terrarium now."},
+    {"HEALTH CRISIS!", "Animal %lu is sick!\nCheck conditions immediately."},
+    {"Stress Alert", "Animal %lu is very stressed!\nImprove habitat conditions."},
+    {"Feeding Time", "Animal %lu is hungry.\nFeed your reptile."},
+};
+
+/**
+ * @brief Take every queued alert edge; show the most severe new one
+ *
+ * All edges are logged. An open alert is only replaced by one at least as
+ * severe, so a hungry animal does not hide an overheating terrarium.
+ */
+static void drain_alerts(void)
+{
+    static alert_type_t shown = ALERT_INFO;
+    reptile_alert_t alert;
+    reptile_alert_t worst = {0};
+    bool any = false;
+
+    while (reptile_engine_poll_alert(&alert)) {
+        ESP_LOGI(TAG, "Alert %d %s: id %lu, value %.1f, game clock %llu ms", (int)alert.kind,
+                 alert.raised ? "raised" : "cleared", (unsigned long)alert.entity_id, alert.value,
+                 (unsigned long long)alert.time_ms);
+        if (alert.raised && (!any || alert.severity > worst.severity)) {
+            worst = alert;
+            any = true;
+        }
+    }
+    if (!any) return;
+
+    const alert_type_t type = (alert_type_t)worst.severity;
+    char message[96];
+    snprintf(message, sizeof(message), k_alert_text[worst.kind].format, (unsigned long)worst.entity_id);
+
+    // The OK button clears g_alert_msgbox from the LVGL task
+    lvgl_port_lock(0);
+    if (!g_alert_msgbox || type >= shown) {
+        show_alert(type, k_alert_text[worst.kind].title, message);
+        shown = type;
+    }
+    lvgl_port_unlock();
+}
+
 static void show_alert(alert_type_t type, const char *title, const char *message)
 {
     // Close previous alert if exists
@@ -389,17 +528,8 @@ static void btn_heater_cb(lv_event_t *e)
 {
     lv_event_code_t code = lv_event_get_code(e);
     if (code == LV_EVENT_CLICKED) {
-        // Get current state and toggle
-        bool current_state = reptile_engine_get_heater_state(g_selected_terrarium_id); // Terrarium ID 1
-        bool new_state = !current_state;
-        reptile_engine_set_heater(g_selected_terrarium_id, new_state);
-
-        ESP_LOGI(TAG, "Heater toggled: %s", new_state ? "ON" : "OFF");
-
-        // Update button label
-        lv_obj_t *btn = lv_event_get_target(e);
-        lv_obj_t *label = lv_obj_get_child(btn, 0);
-        lv_label_set_text(label, new_state ? LV_SYMBOL_POWER " Heater ON" : LV_SYMBOL_POWER " Heater OFF");
+        // Toggled by sim_task; the button label follows the terrarium view
+        post_ui_action(UI_ACTION_TOGGLE_HEATER, g_selected_terrarium_id);
     }
 }
 
@@ -407,17 +537,8 @@ static void btn_light_cb(lv_event_t *e)
 {
     lv_event_code_t code = lv_event_get_code(e);
     if (code == LV_EVENT_CLICKED) {
-        // Get current state and toggle
-        bool current_state = reptile_engine_get_light_state(g_selected_terrarium_id); // Terrarium ID 1
-        bool new_state = !current_state;
-        reptile_engine_set_light(g_selected_terrarium_id, new_state);
-
-        ESP_LOGI(TAG, "Light toggled: %s", new_state ? "ON" : "OFF");
-
-        // Update button label
-        lv_obj_t *btn = lv_event_get_target(e);
-        lv_obj_t *label = lv_obj_get_child(btn, 0);
-        lv_label_set_text(label, new_state ? LV_SYMBOL_IMAGE " Light ON" : LV_SYMBOL_IMAGE " Light OFF");
+        // Toggled by sim_task; the button label follows the terrarium view
+        post_ui_action(UI_ACTION_TOGGLE_LIGHT, g_selected_terrarium_id);
     }
 }
 
@@ -425,17 +546,8 @@ static void btn_mister_cb(lv_event_t *e)
 {
     lv_event_code_t code = lv_event_get_code(e);
     if (code == LV_EVENT_CLICKED) {
-        // Get current state and toggle
-        bool current_state = reptile_engine_get_mister_state(g_selected_terrarium_id); // Terrarium ID 1
-        bool new_state = !current_state;
-        reptile_engine_set_mister(g_selected_terrarium_id, new_state);
-
-        ESP_LOGI(TAG, "Mister toggled: %s", new_state ? "ON" : "OFF");
-
-        // Update button label
-        lv_obj_t *btn = lv_event_get_target(e);
-        lv_obj_t *label = lv_obj_get_child(btn, 0);
-        lv_label_set_text(label, new_state ? LV_SYMBOL_REFRESH " Mister ON" : LV_SYMBOL_REFRESH " Mister OFF");
+        // Toggled by sim_task; the button label follows the terrarium view
+        post_ui_action(UI_ACTION_TOGGLE_MISTER, g_selected_terrarium_id);
     }
 }
 
@@ -443,8 +555,7 @@ static void btn_feed_cb(lv_event_t *e)
 {
     lv_event_code_t code = lv_event_get_code(e);
     if (code == LV_EVENT_CLICKED) {
-        reptile_engine_feed_animal(g_selected_reptile_id); // Reptile ID 1
-        ESP_LOGI(TAG, "Fed animal ID 1 (+$2 food cost)");
+        post_ui_action(UI_ACTION_FEED, g_selected_reptile_id);
     }
 }
 
@@ -452,8 +563,7 @@ static void btn_clean_cb(lv_event_t *e)
 {
     lv_event_code_t code = lv_event_get_code(e);
     if (code == LV_EVENT_CLICKED) {
-        reptile_engine_clean_terrarium(g_selected_terrarium_id);
-        ESP_LOGI(TAG, "Cleaned terrarium ID %lu (waste/bacteria reduced)", g_selected_terrarium_id);
+        post_ui_action(UI_ACTION_CLEAN, g_selected_terrarium_id);
     }
 }
 
@@ -461,12 +571,7 @@ static void btn_add_terrarium_cb(lv_event_t *e)
 {
     lv_event_code_t code = lv_event_get_code(e);
     if (code == LV_EVENT_CLICKED) {
-        uint32_t new_id = reptile_engine_add_terrarium(120.0f, 60.0f, 60.0f);
-        ESP_LOGI(TAG, "Added terrarium ID %lu (120x60x60 cm)", new_id);
-
-        lvgl_port_lock(0);
-        show_alert(ALERT_INFO, "Success", "New terrarium added!");
-        lvgl_port_unlock();
+        post_ui_action(UI_ACTION_ADD_TERRARIUM, 0);
     }
 }
 
@@ -474,12 +579,7 @@ static void btn_add_reptile_cb(lv_event_t *e)
 {
     lv_event_code_t code = lv_event_get_code(e);
     if (code == LV_EVENT_CLICKED) {
-        uint32_t new_id = reptile_engine_add_reptile("New Reptile", "Pogona vitticeps");
-        ESP_LOGI(TAG, "Added reptile ID %lu (Pogona vitticeps)", new_id);
-
-        lvgl_port_lock(0);
-        show_alert(ALERT_INFO, "Success", "New reptile added!");
-        lvgl_port_unlock();
+        post_ui_action(UI_ACTION_ADD_REPTILE, 0);
     }
 }
 
@@ -498,8 +598,9 @@ static void btn_terrarium_next_cb(lv_event_t *e)
 {
     lv_event_code_t code = lv_event_get_code(e);
     if (code == LV_EVENT_CLICKED) {
-        int count = reptile_engine_get_terrarium_count();
-        if (g_selected_terrarium_id < (uint32_t)count) {
+        reptile_world_view_t world;
+        reptile_engine_get_world_view(&world);
+        if (g_selected_terrarium_id < (uint32_t)world.terrarium_count) {
             g_selected_terrarium_id++;
             ESP_LOGI(TAG, "Selected terrarium ID %lu", g_selected_terrarium_id);
         }
@@ -521,8 +622,9 @@ static void btn_reptile_next_cb(lv_event_t *e)
 {
     lv_event_code_t code = lv_event_get_code(e);
     if (code == LV_EVENT_CLICKED) {
-        int count = reptile_engine_get_reptile_count();
-        if (g_selected_reptile_id < (uint32_t)count) {
+        reptile_world_view_t world;
+        reptile_engine_get_world_view(&world);
+        if (g_selected_reptile_id < (uint32_t)world.reptile_count) {
             g_selected_reptile_id++;
             ESP_LOGI(TAG, "Selected reptile ID %lu", g_selected_reptile_id);
         }
@@ -781,6 +883,70 @@ static void create_reptiles_screen(void)
     lv_obj_center(label_back);
 }
 
+// Label texts of the bound widgets (see bind_ui)
+static void format_time(const reptile_world_view_t *world, char *out, size_t size)
+{
+    const float hours = world->time_hours;
+    snprintf(out, size, "Day %lu - %02d:%02d", (unsigned long)world->day, (int)hours,
+             (int)((hours - (int)hours) * 60.0f));
+}
+
+static void format_stats(const reptile_world_view_t *world, char *out, size_t size)
+{
+    snprintf(out, size, "Animals: %d | Terrariums: %d", world->reptile_count, world->terrarium_count);
+}
+
+static void format_temp(const reptile_terrarium_view_t *terrarium, char *out, size_t size)
+{
+    snprintf(out, size, LV_SYMBOL_WARNING " Temp: %.1f°C", terrarium->temp_hot);
+}
+
+static void format_humidity(const reptile_terrarium_view_t *terrarium, char *out, size_t size)
+{
+    snprintf(out, size, LV_SYMBOL_REFRESH " Humidity: %.1f%%", terrarium->humidity);
+}
+
+static void format_waste(const reptile_terrarium_view_t *terrarium, char *out, size_t size)
+{
+    snprintf(out, size, LV_SYMBOL_TRASH " Waste: %.1f%%", terrarium->waste);
+}
+
+static void format_heater(const reptile_terrarium_view_t *terrarium, char *out, size_t size)
+{
+    snprintf(out, size, LV_SYMBOL_POWER " Heater %s", terrarium->heater_on ? "ON" : "OFF");
+}
+
+static void format_light(const reptile_terrarium_view_t *terrarium, char *out, size_t size)
+{
+    snprintf(out, size, LV_SYMBOL_IMAGE " Light %s", terrarium->light_on ? "ON" : "OFF");
+}
+
+static void format_mister(const reptile_terrarium_view_t *terrarium, char *out, size_t size)
+{
+    snprintf(out, size, LV_SYMBOL_REFRESH " Mister %s", terrarium->mister_on ? "ON" : "OFF");
+}
+
+/**
+ * @brief Map the live labels to their view fields (LVGL lock held)
+ */
+static void bind_ui(void)
+{
+    ui_binding_init(g_lvgl_display);
+
+    ui_bind_world(g_label_time, format_time);
+    ui_bind_world(g_label_stats, format_stats);
+
+    // Selected terrarium (zeros if it is gone)
+    ui_bind_terrarium(g_label_temp, &g_selected_terrarium_id, format_temp);
+    ui_bind_terrarium(g_label_humidity, &g_selected_terrarium_id, format_humidity);
+    ui_bind_terrarium(g_label_waste, &g_selected_terrarium_id, format_waste);
+
+    // Equipment buttons show the state sim_task applied, not the last press
+    ui_bind_terrarium(lv_obj_get_child(g_btn_heater, 0), &g_selected_terrarium_id, format_heater);
+    ui_bind_terrarium(lv_obj_get_child(g_btn_light, 0), &g_selected_terrarium_id, format_light);
+    ui_bind_terrarium(lv_obj_get_child(g_btn_mister, 0), &g_selected_terrarium_id, format_mister);
+}
+
 static void create_ui(void)
 {
     ESP_LOGI(TAG, "Creating multi-screen UI...");
@@ -839,8 +1005,8 @@ void app_main(void)
     // Touch
     ESP_ERROR_CHECK(bsp_touch_init(&g_lvgl_indev, g_lvgl_display));
 
-    // SD Card (optional)
-    bsp_sdcard_mount(); // Non-critical
+    // SD Card (optional, telemetry archive only)
+    const bool sdcard_ok = (bsp_sdcard_mount() == ESP_OK);
 
     // SPIFFS (for game saves)
     ESP_LOGI(TAG, "Mounting SPIFFS...");
@@ -868,16 +1034,36 @@ void app_main(void)
     ESP_LOGI(TAG, "[TIER 2] Initializing Simulation Core...");
     reptile_engine_init();
 
+    // Snapshots share the 4 MB storage partition with the journal
+    reptile_engine_set_save_compression(true);
+
+    // Trend rings for the first 64 terrariums / 256 reptiles, in PSRAM
+    if (reptile_engine_enable_history(64, 256)) {
+        ESP_LOGI(TAG, "History rings: %lu bytes", (unsigned long)reptile_engine_get_history_bytes());
+    } else {
+        ESP_LOGW(TAG, "History rings not allocated");
+    }
+
     // Load saved game state (if exists)
     load_game_state();
 
+    // Long-term telemetry: one sample per game hour, one chunk per real hour
+    g_telemetry_on = sdcard_ok && reptile_engine_telemetry_start(TELEMETRY_DIR, 0, 60);
+    if (sdcard_ok && !g_telemetry_on) {
+        ESP_LOGW(TAG, "Telemetry archive unavailable at %s", TELEMETRY_DIR);
+    }
+
     // ====================================================================================
     // TIER 3: Create UI
     // ====================================================================================
 
     ESP_LOGI(TAG, "[TIER 3] Creating UI...");
+
+    // Button presses for sim_task; created before any button exists
+    g_ui_actions = xQueueCreate(UI_ACTION_QUEUE_LEN, sizeof(ui_action_t));
     lvgl_port_lock(0);
     create_ui();
+    bind_ui();
     lvgl_port_unlock();
 
     // ====================================================================================
@@ -886,7 +1072,7 @@ void app_main(void)
 
     ESP_LOGI(TAG, "Creating tasks...");
 
-    xTaskCreate(simulation_task, "sim_task", 8192, NULL, 5, NULL);
+    xTaskCreatePinnedToCore(simulation_task, "sim_task", 8192, NULL, 5, NULL, 0);
     xTaskCreate(ui_update_task, "ui_task", 4096, NULL, 4, NULL);
     xTaskCreate(lvgl_fallback_task, "lvgl_fallback", 4096, NULL,
                 CONFIG_APP_LVGL_TASK_PRIORITY, NULL);
@@ -896,7 +1082,7 @@ void app_main(void)
     ESP_LOGI(TAG, "  SYSTEM READY");
     ESP_LOGI(TAG, "  - 14 simulation engines active");
     ESP_LOGI(TAG, "  - Interactive touch UI enabled");
-    ESP_LOGI(TAG, "  - Auto-save every 5 minutes");
+    ESP_LOGI(TAG, "  - Auto-save: journal flush every 10 seconds");
     ESP_LOGI(TAG, "===================================");
 
     // Main loop (idle)
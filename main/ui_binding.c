@@ -0,0 +1,201 @@
+/**
+ * @file ui_binding.c
+ * @brief View-model bindings: engine views to LVGL labels, set only on change
+ */
+
+#include "ui_binding.h"
+#include "esp_lvgl_port.h"
+#include "esp_timer.h"
+#include <string.h>
+
+typedef struct {
+    lv_obj_t *label;
+    const uint32_t *terrarium_id;           // NULL = bound to the world view
+    ui_world_format_t world_format;
+    ui_terrarium_format_t terrarium_format;
+    uint32_t source_id;                     // Source of the text below
+    uint64_t source_version;
+    bool dirty;                             // text is not on the label yet
+    char text[UI_BINDING_TEXT];             // What the label shows once clean
+} ui_binding_t;
+
+static ui_binding_t g_bindings[UI_BINDING_MAX];
+static size_t g_binding_count = 0;
+
+// Frame counters: UI task only
+static ui_binding_stats_t g_stats;
+
+// Redraw counters: LVGL task, under the LVGL lock
+static uint32_t g_redraws = 0;
+static uint32_t g_redraw_us_max = 0;
+static uint64_t g_redraw_us = 0;
+static uint64_t g_invalidated_px = 0;
+static int64_t g_render_start_us = 0;
+
+// ====================================================================================
+// REDRAW COUNTERS (LVGL task)
+// ====================================================================================
+
+static void display_event_cb(lv_event_t *e)
+{
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_INVALIDATE_AREA: {
+            const lv_area_t *area = (const lv_area_t *)lv_event_get_param(e);
+            if (area) g_invalidated_px += lv_area_get_size(area);
+            break;
+        }
+        case LV_EVENT_RENDER_START:
+            g_render_start_us = esp_timer_get_time();
+            break;
+        case LV_EVENT_RENDER_READY: {
+            const uint32_t us = (uint32_t)(esp_timer_get_time() - g_render_start_us);
+            g_redraws++;
+            g_redraw_us += us;
+            if (us > g_redraw_us_max) g_redraw_us_max = us;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// ====================================================================================
+// BINDINGS
+// ====================================================================================
+
+void ui_binding_init(lv_display_t *display)
+{
+    memset(g_bindings, 0, sizeof(g_bindings));
+    g_binding_count = 0;
+    memset(&g_stats, 0, sizeof(g_stats));
+
+    if (display) {
+        lv_display_add_event_cb(display, display_event_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+        lv_display_add_event_cb(display, display_event_cb, LV_EVENT_RENDER_START, NULL);
+        lv_display_add_event_cb(display, display_event_cb, LV_EVENT_RENDER_READY, NULL);
+    }
+}
+
+static ui_binding_t *add_binding(lv_obj_t *label)
+{
+    if (!label || g_binding_count >= UI_BINDING_MAX) return NULL;
+
+    // Formatted with the first frame whatever the versions are
+    ui_binding_t *b = &g_bindings[g_binding_count++];
+    memset(b, 0, sizeof(*b));
+    b->label = label;
+    b->source_version = UINT64_MAX;
+    return b;
+}
+
+bool ui_bind_world(lv_obj_t *label, ui_world_format_t format)
+{
+    ui_binding_t *b = format ? add_binding(label) : NULL;
+    if (!b) return false;
+    b->world_format = format;
+    return true;
+}
+
+bool ui_bind_terrarium(lv_obj_t *label, const uint32_t *terrarium_id, ui_terrarium_format_t format)
+{
+    ui_binding_t *b = (format && terrarium_id) ? add_binding(label) : NULL;
+    if (!b) return false;
+    b->terrarium_id = terrarium_id;
+    b->terrarium_format = format;
+    return true;
+}
+
+// Format if the source moved; true if the label needs the new text
+static bool format_binding(ui_binding_t *b, uint32_t id, uint64_t version, const reptile_world_view_t *world,
+                           const reptile_terrarium_view_t *terrarium)
+{
+    if (id == b->source_id && version == b->source_version) return b->dirty;
+    b->source_id = id;
+    b->source_version = version;
+
+    char text[UI_BINDING_TEXT];
+    if (b->terrarium_id) {
+        b->terrarium_format(terrarium, text, sizeof(text));
+    } else {
+        b->world_format(world, text, sizeof(text));
+    }
+    g_stats.formatted++;
+
+    // A new version can still print the same (rounded) text
+    if (strcmp(text, b->text) != 0) {
+        memcpy(b->text, text, sizeof(text));
+        b->dirty = true;
+    }
+    return b->dirty;
+}
+
+void ui_binding_frame(void)
+{
+    const int64_t start = esp_timer_get_time();
+
+    // Views published by the simulation task: one consistent tick per view
+    reptile_world_view_t world;
+    reptile_engine_get_world_view(&world);
+
+    // Bindings usually share one terrarium; read each id once per frame
+    reptile_terrarium_view_t terrarium = {0};
+    uint32_t terrarium_id = 0;
+    bool terrarium_read = false;
+
+    size_t dirty = 0;
+    for (size_t i = 0; i < g_binding_count; i++) {
+        ui_binding_t *b = &g_bindings[i];
+        uint32_t id = 0;
+        uint64_t version = world.version;
+
+        if (b->terrarium_id) {
+            id = *b->terrarium_id;
+            if (!terrarium_read || id != terrarium_id) {
+                memset(&terrarium, 0, sizeof(terrarium));
+                reptile_engine_get_terrarium_view(id, &terrarium);
+                terrarium_id = id;
+                terrarium_read = true;
+            }
+            version = terrarium.version;    // 0 = gone; its zeroed view is shown once
+        }
+        if (format_binding(b, id, version, &world, &terrarium)) dirty++;
+    }
+
+    // Every changed label in one locked pass, so LVGL joins their areas
+    // into the next render; nothing changed means no lock and no render
+    if (dirty > 0) {
+        lvgl_port_lock(0);
+        for (size_t i = 0; i < g_binding_count; i++) {
+            ui_binding_t *b = &g_bindings[i];
+            if (!b->dirty) continue;
+            lv_label_set_text(b->label, b->text);
+            b->dirty = false;
+            g_stats.labels_set++;
+        }
+        lvgl_port_unlock();
+        g_stats.locked_frames++;
+    }
+
+    const uint32_t us = (uint32_t)(esp_timer_get_time() - start);
+    g_stats.frames++;
+    g_stats.frame_us += us;
+    if (us > g_stats.frame_us_max) g_stats.frame_us_max = us;
+}
+
+void ui_binding_take_stats(ui_binding_stats_t *out)
+{
+    if (!out) return;
+    *out = g_stats;
+    memset(&g_stats, 0, sizeof(g_stats));
+
+    lvgl_port_lock(0);
+    out->redraws = g_redraws;
+    out->redraw_us = g_redraw_us;
+    out->redraw_us_max = g_redraw_us_max;
+    out->invalidated_px = g_invalidated_px;
+    g_redraws = 0;
+    g_redraw_us = 0;
+    g_redraw_us_max = 0;
+    g_invalidated_px = 0;
+    lvgl_port_unlock();
+}
@@ -0,0 +1,84 @@
+/**
+ * @file ui_binding.h
+ * @brief View-model bindings: engine views to LVGL labels, set only on change
+ *
+ * Each binding maps one source (the world view, or the view of a terrarium
+ * picked by id) to one label through a format function. Once per frame
+ * ui_binding_frame() reads the published views, formats only the bindings
+ * whose source version moved, compares the text with what the label shows
+ * and sets the labels that differ, all under a single LVGL lock. A frame
+ * with nothing new formats nothing and does not take the lock; LVGL then
+ * has no area to invalidate and skips the redraw.
+ *
+ * Terrarium versions only move when a value rounds to another multiple of
+ * the change tracker's epsilon (0.1), the way "%.1f" rounds it, so a label
+ * printing at that resolution never keeps a stale digit. A finer format
+ * needs finer epsilons (ReptileEngine::setChangeEpsilons()).
+ *
+ * The counters (ui_binding_take_stats()) cover both sides: time spent in
+ * ui_binding_frame(), and LVGL's own renders of the display with the area
+ * invalidated for them, so the saving can be read off the log.
+ */
+
+#ifndef UI_BINDING_H
+#define UI_BINDING_H
+
+#include "lvgl.h"
+#include "reptile_engine_c.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define UI_BINDING_MAX  16      // Bound labels
+#define UI_BINDING_TEXT 64      // Longest label text, terminator included
+
+typedef void (*ui_world_format_t)(const reptile_world_view_t *world, char *out, size_t size);
+
+// Gets a zeroed view if the terrarium is gone
+typedef void (*ui_terrarium_format_t)(const reptile_terrarium_view_t *terrarium, char *out, size_t size);
+
+/**
+ * @brief Counters since the last ui_binding_take_stats()
+ */
+typedef struct {
+    uint32_t frames;            // ui_binding_frame() calls
+    uint32_t locked_frames;     // Frames that took the LVGL lock
+    uint32_t formatted;         // Texts formatted (source version moved)
+    uint32_t labels_set;        // lv_label_set_text() calls (text changed)
+    uint32_t frame_us_max;      // Longest ui_binding_frame()
+    uint64_t frame_us;          // Total time in ui_binding_frame()
+    uint32_t redraws;           // Renders of the display (any task's changes)
+    uint32_t redraw_us_max;
+    uint64_t redraw_us;         // Total render + flush time
+    uint64_t invalidated_px;    // Area marked for redraw (overlaps counted twice)
+} ui_binding_stats_t;
+
+/**
+ * @brief Reset the bindings and hook the redraw counters (LVGL lock held)
+ */
+void ui_binding_init(lv_display_t *display);
+
+/**
+ * @brief Bind a label to the world view; false if the table is full
+ */
+bool ui_bind_world(lv_obj_t *label, ui_world_format_t format);
+
+/**
+ * @brief Bind a label to the terrarium whose id is in *terrarium_id
+ *
+ * The id is read every frame, so pointing it at another terrarium
+ * re-formats the label with the next frame.
+ */
+bool ui_bind_terrarium(lv_obj_t *label, const uint32_t *terrarium_id, ui_terrarium_format_t format);
+
+/**
+ * @brief Update the labels whose text changed (UI task, LVGL lock not held)
+ */
+void ui_binding_frame(void);
+
+/**
+ * @brief Copy and clear the counters (UI task, LVGL lock not held)
+ */
+void ui_binding_take_stats(ui_binding_stats_t *out);
+
+#endif // UI_BINDING_H